@@ -70,7 +70,7 @@ static int scrypt_power_on_self_test(void)
 
 	for (i = 0, scrypt_valid = 1; post_settings[i].pw; i++) {
 		t = post_settings + i;
-		scrypt((uint8_t *)t->pw, strlen(t->pw), (uint8_t *)t->salt, strlen(t->salt), t->Nfactor, t->rfactor, t->pfactor, test_digest, sizeof(test_digest));
+		ar2_scrypt((uint8_t *)t->pw, strlen(t->pw), (uint8_t *)t->salt, strlen(t->salt), t->Nfactor, t->rfactor, t->pfactor, test_digest, sizeof(test_digest));
 		scrypt_valid &= scrypt_verify(post_vectors[i], test_digest, sizeof(test_digest));
 	}
 
@@ -137,7 +137,7 @@ static void scrypt_free(scrypt_aligned_alloc *aa)
 #endif /* SCRYPT_TEST_SPEED */
 
 
-void scrypt(const uint8_t *password, size_t password_len, const uint8_t *salt, size_t salt_len,
+void ar2_scrypt(const uint8_t *password, size_t password_len, const uint8_t *salt, size_t salt_len,
 	uint8_t Nfactor, uint8_t rfactor, uint8_t pfactor, uint8_t *out, size_t bytes)
 {
 	scrypt_aligned_alloc YX, V;
@@ -203,15 +203,34 @@ void scrypt(const uint8_t *password, size_t password_len, const uint8_t *salt, s
 #define chunk_bytes 1024
 #endif
 
-void my_scrypt(const uint8_t *password, size_t password_len, const uint8_t *salt, size_t salt_len, uint8_t *out)
+typedef char my_scrypt_scratch_size_check[(MY_SCRYPT_SCRATCH_SIZE == 514 * chunk_bytes) ? 1 : -1];
+
+void my_scrypt_scratch(const uint8_t *password, size_t password_len, const uint8_t *salt, size_t salt_len, uint8_t *out, uint8_t *scratch)
 {
-	scrypt_aligned_alloc YX, V;
-	uint8_t *X, *Y;
+	uint8_t *X, *Y, *V;
 
 #if !defined(SCRYPT_CHOOSE_COMPILETIME)
 	scrypt_ROMixfn scrypt_ROMix = scrypt_getROMix();
 #endif
 
+	Y = scratch;
+	X = Y + chunk_bytes;
+	V = X + chunk_bytes;
+
+	/* 1: X = PBKDF2(password, salt) */
+	scrypt_pbkdf2(password, password_len, salt, salt_len, 1, X, chunk_bytes);
+
+	/* 2: X = ROMix(X) */
+	scrypt_ROMix((scrypt_mix_word_t *)X, (scrypt_mix_word_t *)Y, (scrypt_mix_word_t *)V, 512, 1);
+
+	/* 3: Out = PBKDF2(password, X) */
+	scrypt_pbkdf2(password, password_len, X, chunk_bytes, 1, out, 32);
+}
+
+void my_scrypt(const uint8_t *password, size_t password_len, const uint8_t *salt, size_t salt_len, uint8_t *out)
+{
+	scrypt_aligned_alloc scratch;
+
 /*
 #if !defined(SCRYPT_TEST)
 	static int power_on_self_test = 0;
@@ -222,24 +241,12 @@ void my_scrypt(const uint8_t *password, size_t password_len, const uint8_t *salt
 	}
 #endif
 */
-	V = scrypt_alloc((uint64_t)512 * chunk_bytes);
-	YX = scrypt_alloc(2 * chunk_bytes);
+	scratch = scrypt_alloc(MY_SCRYPT_SCRATCH_SIZE);
+	my_scrypt_scratch(password, password_len, salt, salt_len, out, scratch.ptr);
 
-	/* 1: X = PBKDF2(password, salt) */
-	Y = YX.ptr;
-	X = Y + chunk_bytes;
-	scrypt_pbkdf2(password, password_len, salt, salt_len, 1, X, chunk_bytes);
+	scrypt_ensure_zero(scratch.ptr, 2 * chunk_bytes);
 
-	/* 2: X = ROMix(X) */
-	scrypt_ROMix((scrypt_mix_word_t *)X, (scrypt_mix_word_t *)Y, (scrypt_mix_word_t *)V.ptr, 512, 1);
-
-	/* 3: Out = PBKDF2(password, X) */
-	scrypt_pbkdf2(password, password_len, X, chunk_bytes, 1, out, 32);
-
-	scrypt_ensure_zero(YX.ptr, 2 * chunk_bytes);
-
-	scrypt_free(&V);
-	scrypt_free(&YX);
+	scrypt_free(&scratch);
 }
 
 #if defined( _WINDOWS )
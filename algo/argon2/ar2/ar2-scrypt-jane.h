@@ -30,6 +30,13 @@
 typedef void (*scrypt_fatal_errorfn)(const char *msg);
 void scrypt_set_fatal_error(scrypt_fatal_errorfn fn);
 
-void scrypt(const unsigned char *password, size_t password_len, const unsigned char *salt, size_t salt_len, unsigned char Nfactor, unsigned char rfactor, unsigned char pfactor, unsigned char *out, size_t bytes);
+void ar2_scrypt(const unsigned char *password, size_t password_len, const unsigned char *salt, size_t salt_len, unsigned char Nfactor, unsigned char rfactor, unsigned char pfactor, unsigned char *out, size_t bytes);
 void my_scrypt(const uint8_t *password, size_t password_len, const uint8_t *salt, size_t salt_len, uint8_t *out);
+
+/*
+	my_scrypt() on caller provided working memory: X/Y (2 chunks) followed by
+	V (512 chunks) of 256 bytes, aligned to the 128 byte salsa64 block
+*/
+#define MY_SCRYPT_SCRATCH_SIZE (514 * 256)
+void my_scrypt_scratch(const uint8_t *password, size_t password_len, const uint8_t *salt, size_t salt_len, uint8_t *out, uint8_t *scratch);
 #endif /* AR2_SCRYPT_JANE_H */
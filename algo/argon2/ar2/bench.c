@@ -8,6 +8,8 @@
 #endif
 
 #include "argon2.h"
+#include "cores.h"
+#include "../../../ar2.h"
 
 static uint64_t rdtsc(void)
 {
@@ -28,83 +30,85 @@ static uint64_t rdtsc(void)
 #endif
 }
 
+static uint8_t *bench_blocks;
+
+static int bench_allocate(uint8_t **memory, size_t bytes_to_allocate)
+{
+	*memory = bench_blocks;
+	return ARGON2_OK;
+}
+
+static void bench_deallocate(uint8_t *memory, size_t bytes_to_allocate)
+{
+}
+
 /*
- * Benchmarks Argon2 with salt length 16, password length 16, t_cost 1,
-   and different m_cost and threads
+ * Benchmarks the AR2 parameters (one lane of 16 KiB, two passes, 32 byte
+ * password and salt): the Argon2d and Argon2i cores with the default
+ * allocator and with block memory handed out by the allocation hooks, and
+ * the complete scrypt-jane/Argon2/scrypt-jane hash of an 80 byte header.
  */
+#define BENCH_ROUNDS 20000
+
+static void report(const char *name, uint64_t cycles, clock_t ticks)
+{
+	double run_time = (double)ticks / CLOCKS_PER_SEC;
+
+	printf("%-28s %8.1f Kcycles/hash %9.1f hashes/s\n", name,
+		   (double)cycles / BENCH_ROUNDS / 1000, BENCH_ROUNDS / run_time);
+}
+
+static void bench_core(const char *name, argon2_type type, int hooks)
+{
+	uint8_t out[32], pwd[32];
+	uint64_t start_cycles;
+	clock_t start_time;
+	unsigned i;
+
+	start_time = clock();
+	start_cycles = rdtsc();
+	for (i = 0; i < BENCH_ROUNDS; i++) {
+		argon2_context context;
+
+		/* initial_hash() wipes the password */
+		memset(pwd, (uint8_t)i, sizeof(pwd));
+		context.out = out;
+		context.pwd = pwd;
+		context.salt = pwd;
+		context.pwdlen = 0;
+		context.allocate_cbk = hooks ? bench_allocate : NULL;
+		context.free_cbk = hooks ? bench_deallocate : NULL;
+		argon2_core(&context, type);
+	}
+	report(name, rdtsc() - start_cycles, clock() - start_time);
+}
+
 static void benchmark()
 {
-#define BENCH_OUTLEN 16
-#define BENCH_INLEN 16
-	const uint32_t inlen = BENCH_INLEN;
-	const unsigned outlen = BENCH_OUTLEN;
-	unsigned char out[BENCH_OUTLEN];
-	unsigned char pwd_array[BENCH_INLEN];
-	unsigned char salt_array[BENCH_INLEN];
-#undef BENCH_INLEN
-#undef BENCH_OUTLEN
-
-	uint32_t t_cost = 1;
-	uint32_t m_cost;
-	uint32_t thread_test[6] = {1, 2, 4, 6, 8, 16};
-
-	memset(pwd_array, 0, inlen);
-	memset(salt_array, 1, inlen);
-
-	for (m_cost = (uint32_t)1 << 10; m_cost <= (uint32_t)1 << 22; m_cost *= 2) {
-		unsigned i;
-		for (i = 0; i < 6; ++i) {
-			argon2_context context;
-			uint32_t thread_n = thread_test[i];
-			uint64_t stop_cycles, stop_cycles_i;
-			clock_t stop_time;
-			uint64_t delta_d, delta_i;
-			double mcycles_d, mcycles_i, run_time;
-
-			clock_t start_time = clock();
-			uint64_t start_cycles = rdtsc();
-
-			context.out = out;
-			context.outlen = outlen;
-			context.pwd = pwd_array;
-			context.pwdlen = inlen;
-			context.salt = salt_array;
-			context.saltlen = inlen;
-			context.secret = NULL;
-			context.secretlen = 0;
-			context.ad = NULL;
-			context.adlen = 0;
-			context.t_cost = t_cost;
-			context.m_cost = m_cost;
-			context.lanes = thread_n;
-			context.threads = thread_n;
-			context.allocate_cbk = NULL;
-			context.free_cbk = NULL;
-			context.flags = 0;
-
-			argon2d(&context);
-			stop_cycles = rdtsc();
-			argon2i(&context);
-			stop_cycles_i = rdtsc();
-			stop_time = clock();
-
-			delta_d = (stop_cycles - start_cycles) / (m_cost);
-			delta_i = (stop_cycles_i - stop_cycles) / (m_cost);
-			mcycles_d = (double)(stop_cycles - start_cycles) / (1UL << 20);
-			mcycles_i = (double)(stop_cycles_i - stop_cycles) / (1UL << 20);
-			printf("Argon2d %d iterations  %d MiB %d threads:  %2.2f cpb %2.2f "
-				   "Mcycles \n",
-				   t_cost, m_cost >> 10, thread_n, (float)delta_d / 1024,
-				   mcycles_d);
-			printf("Argon2i %d iterations  %d MiB %d threads:  %2.2f cpb %2.2f "
-				   "Mcycles \n",
-				   t_cost, m_cost >> 10, thread_n, (float)delta_i / 1024,
-				   mcycles_i);
-
-			run_time = ((double)stop_time - start_time) / (CLOCKS_PER_SEC);
-			printf("%2.4f seconds\n\n", run_time);
-		}
+	unsigned char header[80], out[32];
+	uint64_t start_cycles;
+	clock_t start_time;
+	unsigned i;
+
+	bench_blocks = (uint8_t *)malloc(sizeof(block) * 16);
+	if (!bench_blocks)
+		return;
+
+	bench_core("Argon2d", Argon2_d, 0);
+	bench_core("Argon2d, allocation hooks", Argon2_d, 1);
+	bench_core("Argon2i", Argon2_i, 0);
+	bench_core("Argon2i, allocation hooks", Argon2_i, 1);
+
+	memset(header, 0, sizeof(header));
+	start_time = clock();
+	start_cycles = rdtsc();
+	for (i = 0; i < BENCH_ROUNDS; i++) {
+		memcpy(header + 76, &i, sizeof(i));
+		ar2_hash((const char *)header, (char *)out, sizeof(header));
 	}
+	report("AR2 hash", rdtsc() - start_cycles, clock() - start_time);
+
+	free(bench_blocks);
 }
 
 int main()
@@ -142,7 +142,12 @@ void finalize(const argon2_context *context, argon2_instance_t *instance) {
         /* Clear memory */
         // clear_memory(instance, 1);
 
-        free_memory(instance->memory);
+        if (context->free_cbk) {
+            context->free_cbk((uint8_t *)instance->memory,
+                              sizeof(block) * /*instance->memory_blocks*/16);
+        } else {
+            free_memory(instance->memory);
+        }
     }
 }
 
@@ -300,9 +305,17 @@ void initial_hash(uint8_t *blockhash, argon2_context *context,
 
 int initialize(argon2_instance_t *instance, argon2_context *context) {
     /* 1. Memory allocation */
+    int result;
 
-
-    allocate_memory(&(instance->memory), 16);
+    if (context->allocate_cbk) {
+        result = context->allocate_cbk((uint8_t **)&(instance->memory),
+                                       sizeof(block) * 16);
+    } else {
+        result = allocate_memory(&(instance->memory), 16);
+    }
+    if (ARGON2_OK != result) {
+        return ARGON2_MEMORY_ALLOCATION_ERROR;
+    }
 
     /* 2. Initial hashing */
     /* H_0 + 8 extra bytes to produce the first blocks */
@@ -124,9 +124,7 @@ void fill_segment(const argon2_instance_t *instance,
     int data_independent_addressing = (instance->type == Argon2_i);
 
     /* Pseudo-random values that determine the reference block position */
-    uint64_t *pseudo_rands = NULL;
-
-    pseudo_rands = (uint64_t *)malloc(/*sizeof(uint64_t) * 4*/32);
+    uint64_t pseudo_rands[SEGMENT_LENGTH];
 
     if (data_independent_addressing) {
         generate_addresses(instance, &position, pseudo_rands);
@@ -180,6 +178,4 @@ void fill_segment(const argon2_instance_t *instance,
         curr_block = instance->memory + curr_offset;
         fill_block(state, (__m128i const *)ref_block->v, (__m128i *)curr_block->v);
     }
-
-    free(pseudo_rands);
 }
@@ -0,0 +1,65 @@
+/*
+ * AES-NI build of the ECHO in hash.c for generic builds, picked at run
+ * time by its callers.  The constant tables are renamed along with the
+ * functions so a vperm build of hash.c could sit next to this one.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <string.h>
+#include <memory.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("ssse3,aes"))), apply_to = function)
+#else
+#pragma GCC target("ssse3,aes")
+#endif
+
+#define init_echo           echo_aes_init
+#define reinit_echo         echo_aes_reinit
+#define update_echo         echo_aes_update
+#define final_echo          echo_aes_final
+#define update_final_echo   echo_aes_update_final
+#define hash_echo           echo_aes_hash
+#define crypto_hash         echo_aes_crypto_hash
+#define Compress            echo_aes_compress
+#define _k_s0F              echo_aes_k_s0F
+#define _k_ipt              echo_aes_k_ipt
+#define _k_opt              echo_aes_k_opt
+#define _k_inv              echo_aes_k_inv
+#define _k_sb1              echo_aes_k_sb1
+#define _k_sb2              echo_aes_k_sb2
+#define _k_sb3              echo_aes_k_sb3
+#define _k_sb4              echo_aes_k_sb4
+#define _k_sb5              echo_aes_k_sb5
+#define _k_sb7              echo_aes_k_sb7
+#define _k_sbo              echo_aes_k_sbo
+#define _k_h63              echo_aes_k_h63
+#define _k_hc6              echo_aes_k_hc6
+#define _k_h5b              echo_aes_k_h5b
+#define _k_h4e              echo_aes_k_h4e
+#define _k_h0e              echo_aes_k_h0e
+#define _k_h15              echo_aes_k_h15
+#define _k_aesmix1          echo_aes_k_aesmix1
+#define _k_aesmix2          echo_aes_k_aesmix2
+#define _k_aesmix3          echo_aes_k_aesmix3
+#define _k_aesmix4          echo_aes_k_aesmix4
+#define const1              echo_aes_const1
+#define mul2mask            echo_aes_mul2mask
+#define lsbmask             echo_aes_lsbmask
+#define invshiftrows        echo_aes_invshiftrows
+#define zero                echo_aes_zero
+#define mul2ipt             echo_aes_mul2ipt
+/* hash.c declares scratch variables it never uses; keep that quiet here only */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#include "hash.c"
+#pragma GCC diagnostic pop
+#include "echo-aes.h"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
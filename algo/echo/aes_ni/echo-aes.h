@@ -0,0 +1,26 @@
+#ifndef ECHO_AES_H
+#define ECHO_AES_H
+
+#include "hash_api.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ECHO_AES 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * AES-NI ECHO from hash.c, built by echo-aes-dispatch.c for generic builds.
+ * Callers must check for AES-NI and SSSE3 with cpu_has() first.
+ */
+HashReturn echo_aes_init(hashState_echo *state, int hashbitlen);
+HashReturn echo_aes_update_final(hashState_echo *state, BitSequence *hashval,
+                                 const BitSequence *data, DataLength databitlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
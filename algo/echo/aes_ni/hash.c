@@ -16,7 +16,6 @@
  */
 
 #include <memory.h>
-#include "miner.h"
 #include "hash_api.h"
 #include "vperm.h"
 
@@ -22,7 +22,7 @@
 #endif
 
 
-#include "algo/sha/sha3_common.h"
+#include "../../sha/sha3_common.h"
 
 #include <emmintrin.h>
 
@@ -16,7 +16,7 @@
 #ifndef VPERM_H
 #define VPERM_H
 
-#include "algo/sha/sha3_common.h"
+#include "../../sha/sha3_common.h"
 #include <tmmintrin.h>
 
 /*
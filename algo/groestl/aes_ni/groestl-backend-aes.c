@@ -0,0 +1,27 @@
+/* Groestl-512 compression with AES-NI. */
+
+#include "groestl-backend.h"
+
+#ifdef GROESTL_BACKEND_SIMD
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("ssse3,sse4.1,aes"))), apply_to = function)
+#else
+#pragma GCC target("ssse3,sse4.1,aes")
+#endif
+
+#include "groestl-intr-aes.h"
+
+#define GB_NAME         groestl512_aes_backend
+#define GB_INIT         INIT
+#define GB_TF           TF1024
+#define GB_OF           OF1024
+#include "groestl-backend-impl.h"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
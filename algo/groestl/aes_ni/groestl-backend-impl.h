@@ -0,0 +1,51 @@
+/*
+ * Backend glue shared by the groestl*-backend-*.c files, included after one
+ * of the intrinsics headers.  The includer defines GB_NAME (the exported
+ * groestl_backend), GB_INIT, GB_TF and GB_OF (the header's transforms).
+ *
+ * The transforms use aligned loads, so the chaining value and each message
+ * block are staged through locals; that also keeps the callers' contexts
+ * free of any alignment requirement.
+ */
+
+#include <string.h>
+
+#define GB_WORDS        ((COLS) * (ROWS) / 16)
+
+static __m128i gb_iv[GB_WORDS];
+
+static void gb_setup(void)
+{
+	int i;
+
+	SET_CONSTANTS();
+	for (i = 0; i < GB_WORDS; i++)
+		gb_iv[i] = _mm_setzero_si128();
+	((u64*)gb_iv)[COLS - 1] = U64BIG((u64)LENGTH);
+	GB_INIT((void*)gb_iv);
+}
+
+static void gb_compress(void *h, const unsigned char *data, size_t blocks)
+{
+	__m128i cv[GB_WORDS];
+	__m128i m[GB_WORDS];
+
+	memcpy(cv, h, sizeof cv);
+	while (blocks-- > 0) {
+		memcpy(m, data, sizeof m);
+		GB_TF((void*)cv, (void*)m);
+		data += sizeof m;
+	}
+	memcpy(h, cv, sizeof cv);
+}
+
+static void gb_output(void *h, void *out)
+{
+	__m128i cv[GB_WORDS];
+
+	memcpy(cv, h, sizeof cv);
+	GB_OF((void*)cv);
+	memcpy(out, cv + GB_WORDS / 2, sizeof cv / 2);
+}
+
+const groestl_backend GB_NAME = { gb_setup, gb_iv, gb_compress, gb_output };
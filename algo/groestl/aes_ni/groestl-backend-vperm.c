@@ -0,0 +1,27 @@
+/* Groestl-512 compression with SSSE3 vector permutes, for CPUs without AES-NI. */
+
+#include "groestl-backend.h"
+
+#ifdef GROESTL_BACKEND_SIMD
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("ssse3"))), apply_to = function)
+#else
+#pragma GCC target("ssse3")
+#endif
+
+#include "groestl-intr-vperm.h"
+
+#define GB_NAME         groestl512_vperm_backend
+#define GB_INIT         INIT
+#define GB_TF           TF1024
+#define GB_OF           OF1024
+#include "groestl-backend-impl.h"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
@@ -0,0 +1,52 @@
+#include "groestl-backend.h"
+#include "../../../cpu_features.h"
+
+#ifdef GROESTL_BACKEND_SIMD
+
+#include <pthread.h>
+
+/* Setup fills each backend's constant tables, so it must run exactly once. */
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+static const groestl_backend *s_groestl512;
+static const groestl_backend *s_groestl256;
+
+static void select_backends(void)
+{
+	if (cpu_has(CPU_FEATURE_AES | CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE41)) {
+		s_groestl512 = &groestl512_aes_backend;
+		s_groestl256 = &groestl256_aes_backend;
+	} else if (cpu_has(CPU_FEATURE_SSSE3)) {
+		s_groestl512 = &groestl512_vperm_backend;
+		s_groestl256 = &groestl256_vperm_backend;
+	} else {
+		return;
+	}
+	s_groestl512->setup();
+	s_groestl256->setup();
+}
+
+const groestl_backend *groestl512_backend(void)
+{
+	pthread_once(&s_once, select_backends);
+	return s_groestl512;
+}
+
+const groestl_backend *groestl256_backend(void)
+{
+	pthread_once(&s_once, select_backends);
+	return s_groestl256;
+}
+
+#else
+
+const groestl_backend *groestl512_backend(void)
+{
+	return 0;
+}
+
+const groestl_backend *groestl256_backend(void)
+{
+	return 0;
+}
+
+#endif
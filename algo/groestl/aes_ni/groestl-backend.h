@@ -0,0 +1,46 @@
+#ifndef GROESTL_BACKEND_H
+#define GROESTL_BACKEND_H
+
+#include <stddef.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GROESTL_BACKEND_SIMD 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Runtime selected SIMD Groestl compression.
+ *
+ * The chaining value is kept in the backend's own (transposed) layout, 128
+ * bytes for Groestl-512 and 64 bytes for Groestl-256; iv holds the already
+ * transformed initial value.  Neither h nor the data needs any particular
+ * alignment.  output() applies the output transformation and writes the
+ * digest, 64 or 32 bytes, to out.
+ */
+typedef struct {
+	void (*setup)(void);
+	const void *iv;
+	void (*compress)(void *h, const unsigned char *data, size_t blocks);
+	void (*output)(void *h, void *out);
+} groestl_backend;
+
+/*
+ * Fastest backend for this CPU: AES-NI, else SSSE3 vperm, else NULL, in which
+ * case the caller keeps using the table implementation.
+ */
+const groestl_backend *groestl512_backend(void);
+const groestl_backend *groestl256_backend(void);
+
+extern const groestl_backend groestl512_aes_backend;
+extern const groestl_backend groestl512_vperm_backend;
+extern const groestl_backend groestl256_aes_backend;
+extern const groestl_backend groestl256_vperm_backend;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
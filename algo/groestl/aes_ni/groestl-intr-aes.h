@@ -12,15 +12,15 @@
 #include "hash-groestl.h"
 
 /* global constants  */
-__m128i ROUND_CONST_Lx;
+//static __m128i ROUND_CONST_Lx;
 //__m128i ROUND_CONST_L0[ROUNDS512];
 //__m128i ROUND_CONST_L7[ROUNDS512];
-__m128i ROUND_CONST_P[ROUNDS1024];
-__m128i ROUND_CONST_Q[ROUNDS1024];
-__m128i TRANSP_MASK;
-__m128i SUBSH_MASK[8];
-__m128i ALL_1B;
-__m128i ALL_FF;
+static __m128i ROUND_CONST_P[ROUNDS1024];
+static __m128i ROUND_CONST_Q[ROUNDS1024];
+static __m128i TRANSP_MASK;
+static __m128i SUBSH_MASK[8];
+static __m128i ALL_1B;
+static __m128i ALL_FF;
 
 #define tos(a)    #a
 #define tostr(a)  tos(a)
@@ -420,10 +420,10 @@ __m128i ALL_FF;
 }/**/
 
 
-void INIT( __m128i* chaining )
+static void INIT( __m128i* chaining )
 {
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
 
   /* load IV into registers xmm8 - xmm15 */
   xmm8 = chaining[0];
@@ -449,14 +449,14 @@ void INIT( __m128i* chaining )
   chaining[7] = xmm15;
 }
 
-void TF1024( __m128i* chaining, const __m128i* message )
+static void TF1024( __m128i* chaining, const __m128i* message )
 {
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
-  static __m128i QTEMP[8];
-  static __m128i TEMP0;
-  static __m128i TEMP1;
-  static __m128i TEMP2;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+  __m128i QTEMP[8];
+  __m128i TEMP0;
+  __m128i TEMP1;
+  __m128i TEMP2;
 
 #ifdef IACA_TRACE
   IACA_START;
@@ -563,13 +563,13 @@ void TF1024( __m128i* chaining, const __m128i* message )
   return;
 }
 
-void OF1024( __m128i* chaining )
+static void OF1024( __m128i* chaining )
 {
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
-  static __m128i TEMP0;
-  static __m128i TEMP1;
-  static __m128i TEMP2;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+  __m128i TEMP0;
+  __m128i TEMP1;
+  __m128i TEMP2;
 
   /* load CV into registers xmm8 - xmm15 */
   xmm8 = chaining[0];
@@ -0,0 +1,27 @@
+/* Groestl-256 compression with AES-NI. */
+
+#include "groestl-backend.h"
+
+#ifdef GROESTL_BACKEND_SIMD
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("ssse3,sse4.1,aes"))), apply_to = function)
+#else
+#pragma GCC target("ssse3,sse4.1,aes")
+#endif
+
+#include "groestl256-intr-aes.h"
+
+#define GB_NAME         groestl256_aes_backend
+#define GB_INIT         INIT256
+#define GB_TF           TF512
+#define GB_OF           OF512
+#include "groestl-backend-impl.h"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
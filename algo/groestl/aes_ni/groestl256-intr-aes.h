@@ -12,15 +12,15 @@
 #include "hash-groestl256.h"
 
 /* global constants  */
-__m128i ROUND_CONST_Lx;
-__m128i ROUND_CONST_L0[ROUNDS512];
-__m128i ROUND_CONST_L7[ROUNDS512];
+static __m128i ROUND_CONST_Lx;
+static __m128i ROUND_CONST_L0[ROUNDS512];
+static __m128i ROUND_CONST_L7[ROUNDS512];
 //__m128i ROUND_CONST_P[ROUNDS1024];
 //__m128i ROUND_CONST_Q[ROUNDS1024];
-__m128i TRANSP_MASK;
-__m128i SUBSH_MASK[8];
-__m128i ALL_1B;
-__m128i ALL_FF;
+static __m128i TRANSP_MASK;
+static __m128i SUBSH_MASK[8];
+static __m128i ALL_1B;
+//static __m128i ALL_FF;
 
 
 #define tos(a)    #a
@@ -322,7 +322,7 @@ __m128i ALL_FF;
  * outputs: (i0-7) = (0|S)
  */
 #define Matrix_Transpose_O_B(i0, i1, i2, i3, i4, i5, i6, i7, t0){\
-  t0 = _mm_xor_si128(t0, t0);\
+  t0 = _mm_setzero_si128();\
   i1 = i0;\
   i3 = i2;\
   i5 = i4;\
@@ -351,10 +351,10 @@ __m128i ALL_FF;
 }/**/
 
 
-void INIT256( __m128i* chaining )
+static void INIT256( __m128i* chaining )
 {
-  static __m128i xmm0, /*xmm1,*/ xmm2, /*xmm3, xmm4, xmm5,*/ xmm6, xmm7;
-  static __m128i /*xmm8, xmm9, xmm10, xmm11,*/ xmm12, xmm13, xmm14, xmm15;
+  __m128i xmm0, /*xmm1,*/ xmm2, /*xmm3, xmm4, xmm5,*/ xmm6, xmm7;
+  __m128i /*xmm8, xmm9, xmm10, xmm11,*/ xmm12, xmm13, xmm14, xmm15;
 
   /* load IV into registers xmm12 - xmm15 */
   xmm12 = chaining[0];
@@ -373,13 +373,13 @@ void INIT256( __m128i* chaining )
   chaining[3] = xmm7;
 }
 
-void TF512( __m128i* chaining, __m128i* message )
+static void TF512( __m128i* chaining, __m128i* message )
 {
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
-  static __m128i TEMP0;
-  static __m128i TEMP1;
-  static __m128i TEMP2;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+  __m128i TEMP0;
+  __m128i TEMP1;
+  __m128i TEMP2;
 
 #ifdef IACA_TRACE
   IACA_START;
@@ -446,13 +446,13 @@ void TF512( __m128i* chaining, __m128i* message )
   return;
 }
 
-void OF512( __m128i* chaining )
+static void OF512( __m128i* chaining )
 {
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
-  static __m128i TEMP0;
-  static __m128i TEMP1;
-  static __m128i TEMP2;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+  __m128i TEMP0;
+  __m128i TEMP1;
+  __m128i TEMP2;
 
   /* load CV into registers xmm8, xmm10, xmm12, xmm14 */
   xmm8 = chaining[0];
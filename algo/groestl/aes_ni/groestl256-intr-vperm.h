@@ -14,25 +14,25 @@
 #include "hash-groestl256.h"
 
 /* global constants  */
-__m128i ROUND_CONST_Lx;
-__m128i ROUND_CONST_L0[ROUNDS512];
-__m128i ROUND_CONST_L7[ROUNDS512];
-__m128i ROUND_CONST_P[ROUNDS1024];
-__m128i ROUND_CONST_Q[ROUNDS1024];
-__m128i TRANSP_MASK;
-__m128i SUBSH_MASK[8];
-__m128i ALL_0F;
-__m128i ALL_15;
-__m128i ALL_1B;
-__m128i ALL_63;
-__m128i ALL_FF;
-__m128i VPERM_IPT[2];
-__m128i VPERM_OPT[2];
-__m128i VPERM_INV[2];
-__m128i VPERM_SB1[2];
-__m128i VPERM_SB2[2];
-__m128i VPERM_SB4[2];
-__m128i VPERM_SBO[2];
+static __m128i ROUND_CONST_Lx;
+static __m128i ROUND_CONST_L0[ROUNDS512];
+static __m128i ROUND_CONST_L7[ROUNDS512];
+//static __m128i ROUND_CONST_P[ROUNDS1024];
+//static __m128i ROUND_CONST_Q[ROUNDS1024];
+static __m128i TRANSP_MASK;
+static __m128i SUBSH_MASK[8];
+static __m128i ALL_0F;
+static __m128i ALL_15;
+static __m128i ALL_1B;
+static __m128i ALL_63;
+//static __m128i ALL_FF;
+static __m128i VPERM_IPT[2];
+static __m128i VPERM_OPT[2];
+static __m128i VPERM_INV[2];
+static __m128i VPERM_SB1[2];
+static __m128i VPERM_SB2[2];
+static __m128i VPERM_SB4[2];
+//static __m128i VPERM_SBO[2];
 
 
 #define tos(a)    #a
@@ -579,7 +579,7 @@ __m128i VPERM_SBO[2];
  * outputs: (i0-7) = (0|S)
  */
 #define Matrix_Transpose_O_B(i0, i1, i2, i3, i4, i5, i6, i7, t0){\
-  t0 = _mm_xor_si128(t0, t0);\
+  t0 = _mm_setzero_si128();\
   i1 = i0;\
   i3 = i2;\
   i5 = i4;\
@@ -628,6 +628,7 @@ __m128i VPERM_SBO[2];
 /* transform round constants into VPERM mode */
 #define VPERM_Transform_RoundConst(){\
   xmm0 = ROUND_CONST_Lx;\
+  xmm1 = _mm_setzero_si128();\
   VPERM_Transform(xmm0, xmm1, VPERM_IPT, xmm4, xmm5, xmm6, xmm7, xmm8, xmm9, xmm10);\
   xmm0 = _mm_xor_si128(xmm0, (ALL_15));\
   ROUND_CONST_Lx = xmm0;\
@@ -638,11 +639,11 @@ __m128i VPERM_SBO[2];
   VPERM_Transform_RoundConst_CNT2(8, 9);\
 }/**/
 
-void INIT256(u64* h)
+static void INIT256(u64* h)
 {
   __m128i* const chaining = (__m128i*) h;
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, /*xmm11,*/ xmm12, xmm13, xmm14, xmm15;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, /*xmm11,*/ xmm12, xmm13, xmm14, xmm15;
 
   /* transform round constants into VPERM mode */
   VPERM_Transform_RoundConst();
@@ -665,15 +666,15 @@ void INIT256(u64* h)
   chaining[3] = xmm7;
 }
 
-void TF512(u64* h, u64* m)
+static void TF512(u64* h, u64* m)
 {
   __m128i* const chaining = (__m128i*) h;
   __m128i* const message = (__m128i*) m;
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
-  static __m128i TEMP_MUL1[8];
-  static __m128i TEMP_MUL2[8];
-  static __m128i TEMP_MUL4;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+  __m128i TEMP_MUL1[8];
+  __m128i TEMP_MUL2[8];
+  __m128i TEMP_MUL4;
 
 #ifdef IACA_TRACE
   IACA_START;
@@ -742,14 +743,14 @@ void TF512(u64* h, u64* m)
   return;
 }
 
-void OF512(u64* h)
+static void OF512(u64* h)
 {
   __m128i* const chaining = (__m128i*) h;
-  static __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
-  static __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
-  static __m128i TEMP_MUL1[8];
-  static __m128i TEMP_MUL2[8];
-  static __m128i TEMP_MUL4;
+  __m128i xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7;
+  __m128i xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15;
+  __m128i TEMP_MUL1[8];
+  __m128i TEMP_MUL2[8];
+  __m128i TEMP_MUL4;
 
   /* load CV into registers xmm8, xmm10, xmm12, xmm14 */
   xmm8 = chaining[0];
@@ -66,7 +66,7 @@ extern "C"{
 #endif
 
 #include <stddef.h>
-#include "algo/sha/sph_types.h"
+#include "../sha/sph_types.h"
 
 /**
  * Output size (in bits) for HAVAL-128/3.
@@ -0,0 +1,32 @@
+/*
+ * AVX2 build of the 8-way SHA-512 in sha512_avx2.c for generic builds,
+ * picked at run time by hodl.c.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+/* clang does not define the feature macros for a target pragma */
+#ifndef __AVX2__
+#define __AVX2__ 1
+#endif
+
+#define sha512Compute32b_parallel   hodl_sha512_x8_avx2
+#define sha512ProcessBlock          hodl_sha512_process_avx2
+#define mm256_htobe_epi64           hodl_mm256_htobe_epi64
+#define mm256_betoh_epi64           hodl_mm256_betoh_epi64
+#include "sha512_avx2.c"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
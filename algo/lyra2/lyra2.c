@@ -22,7 +22,7 @@
 #include <string.h>
 #include <time.h>
 #include <mm_malloc.h>
-#include "compat.h"
+#include "../../compat.h"
 #include "lyra2.h"
 #include "sponge.h"
 
@@ -21,7 +21,7 @@
 #define LYRA2_H_
 
 #include <stdint.h>
-#include "algo/sha/sha3-defs.h"
+#include "../sha/sha3-defs.h"
 
 //typedef unsigned char byte;
 
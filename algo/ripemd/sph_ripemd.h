@@ -57,7 +57,7 @@
 #define SPH_RIPEMD_H__
 
 #include <stddef.h>
-#include "algo/sha/sph_types.h"
+#include "../sha/sph_types.h"
 
 /**
  * Output size (in bits) for RIPEMD.
@@ -45,7 +45,7 @@
 #define SPH_TIGER_H__
 
 #include <stddef.h>
-#include "algo/sha/sph_types.h"
+#include "../sha/sph_types.h"
 
 #if SPH_64
 
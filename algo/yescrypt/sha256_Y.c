@@ -32,7 +32,7 @@
 #include "sysendian.h"
 
 #include "sha256_Y.h"
-#include "compat.h"
+#include "../../compat.h"
 
 /*
  * Encode a length len/4 vector of (uint32_t) into a length len vector of
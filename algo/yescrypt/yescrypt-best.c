@@ -1,4 +1,83 @@
-#ifdef __SSE2__
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+
+/*
+ * The baseline SSE2 build provides the public API; yescrypt_kdf() itself
+ * forwards to the fastest build of the SIMD code this CPU can run.
+ */
+#define YESCRYPT_DISPATCH 1
+#define yescrypt_kdf yescrypt_kdf_sse2
+#include "yescrypt-simd.c"
+#undef yescrypt_kdf
+
+#include "../../cpu_features.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+typedef int (*yescrypt_kdf_fn)(const yescrypt_shared_t * shared,
+    yescrypt_local_t * local,
+    const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen,
+    uint64_t N, uint32_t r, uint32_t p, uint32_t t, yescrypt_flags_t flags,
+    uint8_t * buf, size_t buflen);
+
+extern int yescrypt_kdf_sse41(const yescrypt_shared_t * shared,
+    yescrypt_local_t * local,
+    const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen,
+    uint64_t N, uint32_t r, uint32_t p, uint32_t t, yescrypt_flags_t flags,
+    uint8_t * buf, size_t buflen);
+
+extern int yescrypt_kdf_xop(const yescrypt_shared_t * shared,
+    yescrypt_local_t * local,
+    const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen,
+    uint64_t N, uint32_t r, uint32_t p, uint32_t t, yescrypt_flags_t flags,
+    uint8_t * buf, size_t buflen);
+
+static yescrypt_kdf_fn s_kdf;
+
+static void
+select_kdf(void)
+{
+	if (cpu_has(CPU_FEATURE_XOP))
+		s_kdf = yescrypt_kdf_xop;
+	else if (cpu_has(CPU_FEATURE_SSE41))
+		s_kdf = yescrypt_kdf_sse41;
+	else
+		s_kdf = yescrypt_kdf_sse2;
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_kdf_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK
+select_kdf_once(PINIT_ONCE once, PVOID param, PVOID * ctx)
+{
+	select_kdf();
+	return TRUE;
+}
+#define KDF_INIT_ONCE()	InitOnceExecuteOnce(&s_kdf_once, select_kdf_once, NULL, NULL)
+#else
+static pthread_once_t s_kdf_once = PTHREAD_ONCE_INIT;
+#define KDF_INIT_ONCE()	pthread_once(&s_kdf_once, select_kdf)
+#endif
+
+int
+yescrypt_kdf(const yescrypt_shared_t * shared, yescrypt_local_t * local,
+    const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen,
+    uint64_t N, uint32_t r, uint32_t p, uint32_t t, yescrypt_flags_t flags,
+    uint8_t * buf, size_t buflen)
+{
+	KDF_INIT_ONCE();
+	return s_kdf(shared, local, passwd, passwdlen, salt, saltlen,
+	    N, r, p, t, flags, buf, buflen);
+}
+
+#elif defined(__SSE2__)
 #include "yescrypt-simd.c"
 #else
 #include "yescrypt-opt.c"
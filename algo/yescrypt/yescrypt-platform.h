@@ -131,6 +131,11 @@ free_region(yescrypt_region_t * region)
 	return 0;
 }
 
+/*
+ * The public API below is defined once, by the baseline build; the other
+ * SIMD builds selected at run time only provide yescrypt_kdf().
+ */
+#ifndef YESCRYPT_KDF_ONLY
 int yescrypt_init_shared(yescrypt_shared_t * shared, const uint8_t * param, size_t paramlen,
     uint64_t N, uint32_t r, uint32_t p, yescrypt_init_shared_flags_t flags, uint32_t mask,
     uint8_t * buf, size_t buflen)
@@ -209,3 +214,5 @@ yescrypt_free_local(yescrypt_local_t * local)
 {
 	return free_region(local);
 }
+
+#endif
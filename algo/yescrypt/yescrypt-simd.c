@@ -33,7 +33,7 @@
  * gcc bug 54349 (fixed for gcc 4.9+).  On 32-bit, it's of direct help.  AVX
  * and XOP are of further help either way.
  */
-#ifndef __SSE4_1__
+#if !defined(__SSE4_1__) && !defined(YESCRYPT_DISPATCH)
 #warning "Consider enabling SSE4.1, AVX, or XOP in the C compiler for significantly better performance"
 #endif
 
@@ -52,7 +52,7 @@
 #include "yescrypt.h"
 #include "yescrypt-platform.h"
 
-#include "compat.h"
+#include "../../compat.h"
 
 #if __STDC_VERSION__ >= 199901L
 /* have restrict */
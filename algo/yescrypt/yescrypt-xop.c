@@ -0,0 +1,26 @@
+/* XOP build of the SIMD yescrypt core, selected at run time by yescrypt-best.c. */
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("xop"))), apply_to = function)
+#else
+#pragma GCC target("xop")
+#endif
+
+#define YESCRYPT_DISPATCH 1
+#define YESCRYPT_KDF_ONLY 1
+#define yescrypt_kdf yescrypt_kdf_xop
+#include "yescrypt-simd.c"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
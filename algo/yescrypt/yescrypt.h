@@ -41,9 +41,7 @@ extern "C" {
 
 //#define  __SSE4_1__
 
-void yescrypt_hash(const char* input, char* output, uint32_t len);
-
-void yescrypthash(void *output, const void *input);
+/* The 80 byte header hash is provided by the top level yescrypt.c. */
 
 /**
  * crypto_scrypt(passwd, passwdlen, salt, saltlen, N, r, p, buf, buflen):
@@ -0,0 +1,70 @@
+#include "ar2.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "scratch_pool.h"
+#include "algo/argon2/ar2/argon2.h"
+#include "algo/argon2/ar2/cores.h"
+#include "algo/argon2/ar2/ar2-scrypt-jane.h"
+
+#define AR2_BLOCKS      16
+#define AR2_MASK        8
+
+/*
+ * Everything one hash touches: the Argon2 blocks handed out through the
+ * context's allocation hooks and the scrypt-jane V/X/Y.  It comes from a
+ * pool, so hashing does not allocate once the pool is warm.
+ */
+typedef struct {
+    block memory[AR2_BLOCKS];
+    uint8_t _ALIGN(128) scrypt[MY_SCRYPT_SCRATCH_SIZE];
+} ar2_scratch;
+
+static scratch_pool s_scratch = SCRATCH_POOL_INIT(sizeof(ar2_scratch), 32);
+
+/* The hooks take no context; this is the buffer of the hash running on this thread */
+static __thread ar2_scratch* s_current;
+
+static int ar2_allocate(uint8_t** memory, size_t bytes)
+{
+    if (!s_current || bytes > sizeof(s_current->memory))
+        return ARGON2_MEMORY_ALLOCATION_ERROR;
+    *memory = (uint8_t*) s_current->memory;
+    return ARGON2_OK;
+}
+
+/* The blocks go back with the scratch, not to the heap */
+static void ar2_deallocate(uint8_t* memory, size_t bytes)
+{
+}
+
+int ar2_hash(const char* input, char* output, uint32_t len)
+{
+    /* The bundled blake2b_final() stores a full 64 byte state into context.out */
+    uint32_t _ALIGN(64) hashA[8], hashB[16];
+    ar2_scratch* scratch = (ar2_scratch*) scratch_pool_acquire(&s_scratch);
+    argon2_context context;
+    int ret;
+
+    if (!scratch)
+        return -1;
+
+    my_scrypt_scratch((const uint8_t*) input, len, (const uint8_t*) input, len, (uint8_t*) hashA, scratch->scrypt);
+
+    context.out = (uint8_t*) hashB;
+    context.pwd = (uint8_t*) hashA;
+    context.salt = (uint8_t*) hashA;
+    context.pwdlen = 0;
+    context.allocate_cbk = ar2_allocate;
+    context.free_cbk = ar2_deallocate;
+    s_current = scratch;
+    ret = argon2_core(&context, (hashA[0] & AR2_MASK) == 0 ? Argon2_i : Argon2_d) == ARGON2_OK ? 0 : -1;
+    s_current = NULL;
+
+    if (!ret)
+        my_scrypt_scratch((const uint8_t*) hashB, 32, (const uint8_t*) hashB, 32, (uint8_t*) output, scratch->scrypt);
+    scratch_pool_release(&s_scratch, scratch);
+    return ret;
+}
@@ -0,0 +1,23 @@
+#ifndef AR2_H
+#define AR2_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Argon2 as mined by AR2: scrypt-jane (salsa64/skein512), then one lane of
+ * 16 KiB Argon2d or Argon2i picked by the first hash, then scrypt-jane
+ * again.  The blocks and the scrypt-jane scratch are taken from a scratch
+ * pool shared by every thread.  Returns 0, or -1 when a pool block could
+ * not be allocated.
+ */
+int ar2_hash(const char* input, char* output, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
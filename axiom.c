@@ -0,0 +1,43 @@
+#include "axiom.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "scratch_pool.h"
+#include "sha3/sph_shabal.h"
+
+/* Same parameters as algo/axiom.c */
+#define AXIOM_N             65536
+#define AXIOM_MATRIX_SIZE   (AXIOM_N * 32)
+
+static scratch_pool s_matrices = SCRATCH_POOL_INIT(AXIOM_MATRIX_SIZE, 32);
+
+int axiom_hash(const char* input, char* output, uint32_t len)
+{
+    uint32_t (*M)[8];
+    uint32_t _ALIGN(64) pair[16];
+    uint32_t b, p, q, j;
+
+    M = (uint32_t (*)[8]) scratch_pool_acquire(&s_matrices);
+    if (!M)
+        return -1;
+
+    sph_shabal256_full(input, len, M[0]);
+    for (b = 1; b < AXIOM_N; b++)
+        sph_shabal256_full(M[b - 1], 32, M[b]);
+
+    for (b = 0; b < AXIOM_N; b++) {
+        p = b > 0 ? b - 1 : 0xFFFF;
+        q = M[p][0] % 0xFFFF;
+        j = (b + q) % AXIOM_N;
+
+        memcpy(pair, M[p], 32);
+        memcpy(pair + 8, M[j], 32);
+        sph_shabal256_full(pair, 64, M[b]);
+    }
+
+    memcpy(output, M[AXIOM_N - 1], 32);
+    scratch_pool_release(&s_matrices, M);
+    return 0;
+}
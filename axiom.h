@@ -0,0 +1,20 @@
+#ifndef AXIOM_H
+#define AXIOM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Axiom (RandMemoHash over Shabal-256).  Returns 0, or -1 when the 2 MiB
+ * matrix could not be allocated.
+ */
+int axiom_hash(const char* input, char* output, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+#include "bastion.h"
+#include <string.h>
+
+#include "compat.h"
+#include "chain.h"
+#include "hefty1.h"
+
+/*
+ * The HEFTY1 digest is 32 bytes but the stages take 64; the upper half
+ * starts out zero, as it does in the reference miners.
+ */
+static void bastion_chunk(const char* const* inputs, uint32_t count, char* const* outputs)
+{
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    unsigned char* digests[CHAIN_BATCH_MAX];
+    uint32_t lens[CHAIN_BATCH_MAX];
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        memset(hashes[i], 0, sizeof hashes[i]);
+        digests[i] = (unsigned char*) hashes[i];
+        lens[i] = BASTION_HEADER_SIZE;
+    }
+    hefty1_digest_batch(inputs, lens, count, digests);
+
+    chain_run(&chain_luffa512, hashes, count);
+    chain_branch(8, &chain_fugue512, &chain_skein512, hashes, count);
+    chain_run(&chain_whirlpool, hashes, count);
+    chain_run(&chain_fugue512, hashes, count);
+    chain_branch(8, &chain_echo512, &chain_luffa512, hashes, count);
+    chain_run(&chain_shabal512, hashes, count);
+    chain_run(&chain_skein512, hashes, count);
+    chain_branch(8, &chain_shabal512, &chain_whirlpool, hashes, count);
+    chain_run(&chain_shabal512, hashes, count);
+    chain_branch(8, &chain_hamsi512, &chain_luffa512, hashes, count);
+
+    for (i = 0; i < count; i++)
+        memcpy(outputs[i], hashes[i], 32);
+}
+
+/* One hash through taken or other, as chain_branch() picks */
+static void bastion_branch(const chain_stage* taken, const chain_stage* other, uint32_t* hash)
+{
+    (hash[0] & 8 ? taken : other)->one(hash);
+}
+
+void bastion_hash(const char* input, char* output)
+{
+    chain_hash _ALIGN(64) hash;
+
+    memset(hash, 0, sizeof hash);
+    hefty1_digest(input, BASTION_HEADER_SIZE, (unsigned char*) hash);
+
+    chain_luffa512.one(hash);
+    bastion_branch(&chain_fugue512, &chain_skein512, hash);
+    chain_whirlpool.one(hash);
+    chain_fugue512.one(hash);
+    bastion_branch(&chain_echo512, &chain_luffa512, hash);
+    chain_shabal512.one(hash);
+    chain_skein512.one(hash);
+    bastion_branch(&chain_shabal512, &chain_whirlpool, hash);
+    chain_shabal512.one(hash);
+    bastion_branch(&chain_hamsi512, &chain_luffa512, hash);
+
+    memcpy(output, hash, 32);
+}
+
+void bastion_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint32_t i, n;
+
+    for (i = 0; i < count; i += n) {
+        n = count - i < CHAIN_BATCH_MAX ? count - i : CHAIN_BATCH_MAX;
+        bastion_chunk(inputs + i, n, outputs + i);
+    }
+}
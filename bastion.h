@@ -0,0 +1,29 @@
+#ifndef BASTION_H
+#define BASTION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define BASTION_HEADER_SIZE 80
+
+/*
+ * Bastion over an 80 byte block header: HEFTY1, then ten stages of which
+ * four pick between two algorithms by bit 3 of the hash.
+ */
+void bastion_hash(const char* input, char* output);
+
+/*
+ * Same as bastion_hash() for count headers: HEFTY1 through
+ * hefty1_digest_batch(), then stage by stage with the hashes regrouped at
+ * each branch.
+ */
+void bastion_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
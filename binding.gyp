@@ -4,6 +4,7 @@
             "target_name": "multihashing",
             "sources": [
                 "multihashing.cc",
+                "cpu_features.c",
                 "scryptjane.c",
                 "scryptn.c",
                 "keccak.c",
@@ -18,6 +19,7 @@
                 "fugue.c",
                 "qubit.c",
                 "hefty1.c",
+                "hefty1-avx2.c",
                 "shavite3.c",
                 "cryptonight.c",
                 "x13.c",
@@ -28,7 +30,40 @@
                 "sha1.c",
                 "x15.c",
                 "fresh.c",
+                "hasher.c",
+                "lyra2rev2.c",
+                "lyra2z.c",
+                "scratch_pool.c",
+                "yescrypt.c",
+                "neoscrypt.c",
+                "neoscrypt-avx2.c",
+                "ar2.c",
+                "hodl.c",
+                "axiom.c",
+                "xevan.c",
+                "chain.c",
+                "chain-avx2.c",
+                "hmq1725.c",
+                "m7m.c",
+                "lbry.c",
+                "x14.c",
+                "x17.c",
+                "skunk.c",
+                "x11gost.c",
+                "zr5.c",
+                "drop.c",
+                "pluck.c",
+                "sha256d.c",
+                "sha256d-avx2.c",
+                "phi1612.c",
+                "c11.c",
+                "x11evo.c",
+                "veltor.c",
+                "bastion.c",
+                "sha256_core.c",
+                "sha256_core-shani.c",
                 "sha3/gost_streebog.c",
+                "sha3/gost_streebog-avx2.c",
                 "sha3/sph_hefty1.c",
                 "sha3/sph_fugue.c",
                 "sha3/aes_helper.c",
@@ -37,8 +72,14 @@
                 "sha3/sph_cubehash.c",
                 "sha3/sph_echo.c",
                 "sha3/sph_groestl.c",
+                "algo/groestl/aes_ni/groestl-backend.c",
+                "algo/groestl/aes_ni/groestl-backend-aes.c",
+                "algo/groestl/aes_ni/groestl-backend-vperm.c",
+                "algo/groestl/aes_ni/groestl256-backend-aes.c",
+                "algo/groestl/aes_ni/groestl256-backend-vperm.c",
                 "sha3/sph_jh.c",
                 "sha3/sph_keccak.c",
+                "sha3/keccakf1600.c",
                 "sha3/sph_luffa.c",
                 "sha3/sph_shavite.c",
                 "sha3/sph_simd.c",
@@ -46,9 +87,27 @@
                 "sha3/sph_whirlpool.c",
                 "sha3/sph_shabal.c",
                 "sha3/hamsi.c",
+                "sha3/hamsi-avx2.c",
                 "sha3/sm3.c",
+                "sha3/sm3-avx2.c",
                 "algo/luffa/sse2/luffa_for_sse2.c",
                 "algo/cubehash/sse2/cubehash_sse2.c",
+                "algo/lyra2/lyra2.c",
+                "algo/lyra2/sponge.c",
+                "algo/yescrypt/yescrypt-best.c",
+                "algo/yescrypt/yescrypt-sse41.c",
+                "algo/yescrypt/yescrypt-xop.c",
+                "algo/yescrypt/sha256_Y.c",
+                "algo/argon2/ar2/argon2.c",
+                "algo/argon2/ar2/cores.c",
+                "algo/argon2/ar2/opt.c",
+                "algo/argon2/ar2/blake2b.c",
+                "algo/argon2/ar2/ar2-scrypt-jane.c",
+                "algo/hodl/sha512-avx2-dispatch.c",
+                "algo/echo/aes_ni/echo-aes-dispatch.c",
+                "algo/haval/haval.c",
+                "algo/tiger/sph_tiger.c",
+                "algo/ripemd/sph_ripemd.c",
                 "algo/simd/sse2/nist.c",
                 "algo/simd/sse2/vector.c",
                 "crypto/oaes_lib.c",
@@ -67,6 +126,32 @@
             "cflags_cc": [
                 "-std=c++0x"
             ],
+            "libraries": [
+                "-lgmp"
+            ],
         }
+    ],
+    "variables": {
+        "build_benchmarks%": 0
+    },
+    "conditions": [
+        # node-gyp rebuild --build_benchmarks=1
+        ["build_benchmarks==1", {
+            "targets": [
+                {
+                    "target_name": "argon2_bench",
+                    "type": "executable",
+                    "sources": [
+                        "algo/argon2/ar2/bench.c",
+                        "ar2.c",
+                        "algo/argon2/ar2/argon2.c",
+                        "algo/argon2/ar2/cores.c",
+                        "algo/argon2/ar2/opt.c",
+                        "algo/argon2/ar2/blake2b.c",
+                        "algo/argon2/ar2/ar2-scrypt-jane.c",
+                    ],
+                }
+            ]
+        }]
     ]
 }
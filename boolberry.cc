@@ -2,6 +2,37 @@
 #include "crypto/cryptonote_core/cryptonote_format_utils.h"
 
 #include <iostream>
+#include <map>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/* File mappings grow in steps this large so appends rarely need a remap. */
+#define SPAD_MAP_STEP   (64ULL << 20)
+
+/*
+ * A scratchpad file starts with a header holding its length and height; the
+ * hashes follow, 32 byte aligned.  The file itself only ever grows: other
+ * processes may have it mapped, and reading a page past a shrunk EOF would
+ * fault, so load() and pop() only move the length in the header.
+ */
+#define SPAD_HEADER_SIZE    64
+
+static const char s_spad_magic[8] = "BBSPAD1";
+
+struct spad_file_header {
+    char magic[8];
+    uint64_t size;
+    uint64_t height;
+};
 
 void boolberry_hash(const char* input, uint32_t input_len, const char* scratchpad, uint64_t spad_length, char* output, uint64_t height) {
     crypto::hash* spad = (crypto::hash*) scratchpad;
@@ -9,3 +40,450 @@ void boolberry_hash(const char* input, uint32_t input_len, const char* scratchpa
         return spad[index%(spad_length / HASH_SIZE)];
     });
 }
+
+void boolberry_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, const char* scratchpad, uint64_t spad_length, char* const* outputs, uint64_t height) {
+    if (!count)
+        return;
+
+    crypto::hash* spad = (crypto::hash*) scratchpad;
+    std::vector<blobdata> blobs(count);
+    std::vector<crypto::hash> res(count);
+    for (uint32_t i = 0; i < count; i++)
+        blobs[i].assign(inputs[i], input_lens[i]);
+
+    cryptonote::get_blob_longhash_bb_batch(&blobs[0], &res[0], count, height, [&](uint64_t index) -> crypto::hash& {
+        return spad[index%(spad_length / HASH_SIZE)];
+    });
+
+    for (uint32_t i = 0; i < count; i++)
+        memcpy(outputs[i], &res[i], HASH_SIZE);
+}
+
+/* Scratchpads opened by path, so every thread of the process maps a file once. */
+static std::map<std::string, boolberry_scratchpad*> s_spad_registry;
+#ifdef _WIN32
+static SRWLOCK s_spad_registry_lock = SRWLOCK_INIT;
+#define REGISTRY_LOCK()     AcquireSRWLockExclusive(&s_spad_registry_lock)
+#define REGISTRY_UNLOCK()   ReleaseSRWLockExclusive(&s_spad_registry_lock)
+#else
+static pthread_mutex_t s_spad_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+#define REGISTRY_LOCK()     pthread_mutex_lock(&s_spad_registry_lock)
+#define REGISTRY_UNLOCK()   pthread_mutex_unlock(&s_spad_registry_lock)
+#endif
+
+boolberry_scratchpad::boolberry_scratchpad(const std::string& path, bool writable)
+    : m_path(path), m_writable(writable), m_fd(-1), m_map(NULL), m_data(NULL),
+      m_size(0), m_capacity(0), m_height(0), m_refs(1)
+{
+#ifdef _WIN32
+    InitializeSRWLock(&m_lock);
+#else
+    pthread_rwlock_init(&m_lock, NULL);
+#endif
+}
+
+boolberry_scratchpad::~boolberry_scratchpad()
+{
+    unmap();
+#ifndef _WIN32
+    if (m_fd >= 0)
+        close(m_fd);
+    pthread_rwlock_destroy(&m_lock);
+#endif
+}
+
+boolberry_scratchpad* boolberry_scratchpad::create()
+{
+    return new boolberry_scratchpad(std::string(), true);
+}
+
+boolberry_scratchpad* boolberry_scratchpad::open(const std::string& path, bool writable, std::string& err)
+{
+#ifdef _WIN32
+    err = "File backed scratchpads are not supported on this platform.";
+    return NULL;
+#else
+    REGISTRY_LOCK();
+
+    std::map<std::string, boolberry_scratchpad*>::iterator it = s_spad_registry.find(path);
+    if (it != s_spad_registry.end()) {
+        boolberry_scratchpad* spad = it->second;
+        if (writable && !spad->m_writable) {
+            REGISTRY_UNLOCK();
+            err = "Scratchpad is already open read-only in this process.";
+            return NULL;
+        }
+        spad->m_refs++;
+        REGISTRY_UNLOCK();
+        return spad;
+    }
+
+    int fd = ::open(path.c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd < 0) {
+        REGISTRY_UNLOCK();
+        err = std::string("Unable to open scratchpad file: ") + strerror(errno);
+        return NULL;
+    }
+
+    boolberry_scratchpad* spad = new boolberry_scratchpad(path, writable);
+    spad->m_fd = fd;
+
+    /* A new file gets its header now; a reader of one not written yet starts out empty. */
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    if (!ok)
+        err = std::string("Unable to stat scratchpad file: ") + strerror(errno);
+    else if (st.st_size == 0 && writable)
+        ok = spad->write_header(err);
+    else if (st.st_size != 0)
+        ok = spad->read_header(err);
+    if (!ok || !spad->map_file(spad->m_size, err)) {
+        REGISTRY_UNLOCK();
+        delete spad;
+        return NULL;
+    }
+
+    s_spad_registry[path] = spad;
+    REGISTRY_UNLOCK();
+    return spad;
+#endif
+}
+
+void boolberry_scratchpad::retain()
+{
+    REGISTRY_LOCK();
+    m_refs++;
+    REGISTRY_UNLOCK();
+}
+
+void boolberry_scratchpad::release()
+{
+    REGISTRY_LOCK();
+    if (--m_refs > 0) {
+        REGISTRY_UNLOCK();
+        return;
+    }
+    if (!m_path.empty())
+        s_spad_registry.erase(m_path);
+    REGISTRY_UNLOCK();
+    delete this;
+}
+
+void boolberry_scratchpad::lock_shared() const
+{
+#ifdef _WIN32
+    AcquireSRWLockShared(&m_lock);
+#else
+    pthread_rwlock_rdlock(&m_lock);
+#endif
+}
+
+void boolberry_scratchpad::unlock_shared() const
+{
+#ifdef _WIN32
+    ReleaseSRWLockShared(&m_lock);
+#else
+    pthread_rwlock_unlock(&m_lock);
+#endif
+}
+
+void boolberry_scratchpad::lock_exclusive() const
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&m_lock);
+#else
+    pthread_rwlock_wrlock(&m_lock);
+#endif
+}
+
+void boolberry_scratchpad::unlock_exclusive() const
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&m_lock);
+#else
+    pthread_rwlock_unlock(&m_lock);
+#endif
+}
+
+void boolberry_scratchpad::unmap()
+{
+    if (!m_data)
+        return;
+#ifndef _WIN32
+    if (m_fd >= 0)
+        munmap(m_map, m_capacity + SPAD_HEADER_SIZE);
+    else
+#endif
+        free(m_data);
+    m_map = NULL;
+    m_data = NULL;
+    m_capacity = 0;
+}
+
+bool boolberry_scratchpad::read_header(std::string& err)
+{
+#ifdef _WIN32
+    err = "File backed scratchpads are not supported on this platform.";
+    return false;
+#else
+    struct stat st;
+    struct spad_file_header header;
+
+    if (fstat(m_fd, &st) != 0) {
+        err = std::string("Unable to stat scratchpad file: ") + strerror(errno);
+        return false;
+    }
+    if (st.st_size < SPAD_HEADER_SIZE || pread(m_fd, &header, sizeof header, 0) != (ssize_t) sizeof header ||
+        memcmp(header.magic, s_spad_magic, sizeof s_spad_magic) != 0) {
+        err = "Not a scratchpad file.";
+        return false;
+    }
+
+    /* A writer may be half way through an append; only expose whole hashes that are in the file. */
+    uint64_t len = header.size - (header.size % HASH_SIZE);
+    if (len > (uint64_t) st.st_size - SPAD_HEADER_SIZE)
+        len = (st.st_size - SPAD_HEADER_SIZE) / HASH_SIZE * HASH_SIZE;
+    m_size = len;
+    m_height = header.height;
+    return true;
+#endif
+}
+
+bool boolberry_scratchpad::write_header(std::string& err)
+{
+#ifndef _WIN32
+    struct spad_file_header header;
+
+    memset(&header, 0, sizeof header);
+    memcpy(header.magic, s_spad_magic, sizeof s_spad_magic);
+    header.size = m_size;
+    header.height = m_height;
+    if (pwrite(m_fd, &header, sizeof header, 0) != (ssize_t) sizeof header) {
+        err = std::string("Unable to write scratchpad file: ") + strerror(errno);
+        return false;
+    }
+#endif
+    return true;
+}
+
+bool boolberry_scratchpad::map_file(uint64_t len, std::string& err)
+{
+#ifdef _WIN32
+    err = "File backed scratchpads are not supported on this platform.";
+    return false;
+#else
+    uint64_t capacity = (len + SPAD_HEADER_SIZE + SPAD_MAP_STEP - 1) / SPAD_MAP_STEP * SPAD_MAP_STEP;
+
+    /* Mapping past EOF is fine as long as nothing reads beyond m_size, which never passes EOF. */
+    void* data = mmap(NULL, capacity, m_writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        err = std::string("Unable to map scratchpad file: ") + strerror(errno);
+        return false;
+    }
+#ifdef MADV_RANDOM
+    madvise(data, capacity, MADV_RANDOM);
+#endif
+
+    unmap();
+    m_map = (char*) data;
+    m_data = m_map + SPAD_HEADER_SIZE;
+    m_capacity = capacity - SPAD_HEADER_SIZE;
+    return true;
+#endif
+}
+
+bool boolberry_scratchpad::reserve(uint64_t len, std::string& err)
+{
+    if (len <= m_capacity)
+        return true;
+
+#ifndef _WIN32
+    if (m_fd >= 0)
+        return map_file(len, err);
+#endif
+
+    uint64_t capacity = m_capacity ? m_capacity : HASH_SIZE * 1024;
+    while (capacity < len)
+        capacity *= 2;
+
+    char* data = (char*) realloc(m_data, capacity);
+    if (!data) {
+        err = "Out of memory growing the scratchpad.";
+        return false;
+    }
+    m_data = data;
+    m_capacity = capacity;
+    return true;
+}
+
+bool boolberry_scratchpad::check_write(uint64_t len, std::string& err) const
+{
+    if (!m_writable) {
+        err = "Scratchpad is read-only.";
+        return false;
+    }
+    if (len % HASH_SIZE) {
+        err = "Scratchpad length is not a multiple of 32 bytes.";
+        return false;
+    }
+    return true;
+}
+
+/* Called with the lock held exclusively; m_size and m_height are only moved once the data is in place. */
+bool boolberry_scratchpad::append_locked(const char* data, uint64_t len, uint64_t height, std::string& err)
+{
+    if (!reserve(m_size + len, err))
+        return false;
+#ifndef _WIN32
+    if (m_fd >= 0) {
+        /* Write through the file so the new pages reach other processes. */
+        uint64_t done = 0;
+        while (done < len) {
+            ssize_t n = pwrite(m_fd, data + done, len - done, SPAD_HEADER_SIZE + m_size + done);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                err = std::string("Unable to write scratchpad file: ") + strerror(errno);
+                return false;
+            }
+            done += n;
+        }
+    }
+    else
+#endif
+        memcpy(m_data + m_size, data, len);
+
+    return set_size(m_size + len, height, err);
+}
+
+/* The new length and height, in the file header too so other processes pick them up on refresh(). */
+bool boolberry_scratchpad::set_size(uint64_t size, uint64_t height, std::string& err)
+{
+    uint64_t old_size = m_size, old_height = m_height;
+
+    m_size = size;
+    m_height = height;
+    if (m_fd >= 0 && !write_header(err)) {
+        m_size = old_size;
+        m_height = old_height;
+        return false;
+    }
+    return true;
+}
+
+bool boolberry_scratchpad::load(const char* data, uint64_t len, uint64_t height, std::string& err)
+{
+    if (!check_write(len, err))
+        return false;
+
+    /* One exclusive section, so a concurrent hash() sees the old contents or the new, never none. */
+    lock_exclusive();
+    uint64_t old_size = m_size;
+    m_size = 0;
+    bool ok = append_locked(data, len, height, err);
+    if (!ok)
+        m_size = old_size;
+    unlock_exclusive();
+    return ok;
+}
+
+bool boolberry_scratchpad::append(const char* data, uint64_t len, uint64_t height, std::string& err)
+{
+    if (!check_write(len, err))
+        return false;
+
+    lock_exclusive();
+    bool ok = append_locked(data, len, height, err);
+    unlock_exclusive();
+    return ok;
+}
+
+bool boolberry_scratchpad::pop(uint64_t count, uint64_t height, std::string& err)
+{
+    if (!check_write(0, err))
+        return false;
+
+    lock_exclusive();
+    /* Compared in hashes, so a huge count cannot wrap around to a small size */
+    if (count > m_size / HASH_SIZE) {
+        unlock_exclusive();
+        err = "Cannot pop more hashes than the scratchpad holds.";
+        return false;
+    }
+    bool ok = set_size(m_size - count * HASH_SIZE, height, err);
+    unlock_exclusive();
+    return ok;
+}
+
+bool boolberry_scratchpad::refresh(std::string& err)
+{
+#ifndef _WIN32
+    if (m_fd < 0)
+        return true;
+
+    lock_exclusive();
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) {
+        unlock_exclusive();
+        err = std::string("Unable to stat scratchpad file: ") + strerror(errno);
+        return false;
+    }
+    /* The writer has not written the header yet */
+    if (st.st_size == 0) {
+        unlock_exclusive();
+        return true;
+    }
+
+    uint64_t old_size = m_size, old_height = m_height;
+    if (!read_header(err) || (m_size > m_capacity && !map_file(m_size, err))) {
+        m_size = old_size;
+        m_height = old_height;
+        unlock_exclusive();
+        return false;
+    }
+    unlock_exclusive();
+#endif
+    return true;
+}
+
+uint64_t boolberry_scratchpad::size() const
+{
+    lock_shared();
+    uint64_t size = m_size;
+    unlock_shared();
+    return size;
+}
+
+uint64_t boolberry_scratchpad::height() const
+{
+    lock_shared();
+    uint64_t height = m_height;
+    unlock_shared();
+    return height;
+}
+
+bool boolberry_scratchpad::hash(const char* input, uint32_t input_len, char* output, uint64_t height, std::string& err) const
+{
+    lock_shared();
+    if (height && !m_size) {
+        unlock_shared();
+        err = "Scratchpad is empty.";
+        return false;
+    }
+    boolberry_hash(input, input_len, m_data, m_size, output, height);
+    unlock_shared();
+    return true;
+}
+
+bool boolberry_scratchpad::hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs, uint64_t height, std::string& err) const
+{
+    lock_shared();
+    if (height && !m_size) {
+        unlock_shared();
+        err = "Scratchpad is empty.";
+        return false;
+    }
+    boolberry_hash_batch(inputs, input_lens, count, m_data, m_size, outputs, height);
+    unlock_shared();
+    return true;
+}
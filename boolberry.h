@@ -3,4 +3,91 @@
 #include <stdint.h>
 #include <string>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 void boolberry_hash(const char* input, uint32_t input_len, const char* scratchpad, uint64_t spad_length, char* output, uint64_t height);
+
+/*
+ * Hashes count blobs against the same scratchpad, interleaving them so the
+ * scratchpad reads of one blob are prefetched while the others compute.
+ */
+void boolberry_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, const char* scratchpad, uint64_t spad_length, char* const* outputs, uint64_t height);
+
+/*
+ * Native Boolberry scratchpad.
+ *
+ * The scratchpad is loaded once and then grows by appending the hashes of
+ * each new block, instead of being handed over as a JS Buffer on every call.
+ * It is either kept in private memory or backed by a file mapped MAP_SHARED,
+ * in which case every store opened on the same path in this process (one per
+ * worker thread) shares the same mapping, and other processes see the same
+ * pages through the page cache.  The file keeps the length and height in a
+ * header and never shrinks, so a process still mapping an older length
+ * never reads past its end.  Hashing only takes the lock shared, so any
+ * number of threads can hash against one scratchpad concurrently.
+ */
+class boolberry_scratchpad
+{
+public:
+    /* Private, heap backed scratchpad. */
+    static boolberry_scratchpad* create();
+    /* File backed scratchpad, shared by path.  Returns NULL and sets err on failure. */
+    static boolberry_scratchpad* open(const std::string& path, bool writable, std::string& err);
+
+    void retain();
+    void release();
+
+    /* Replace the whole contents (len must be a multiple of 32). */
+    bool load(const char* data, uint64_t len, uint64_t height, std::string& err);
+    /* Append the hashes of newly found blocks up to the given height. */
+    bool append(const char* data, uint64_t len, uint64_t height, std::string& err);
+    /* Drop the last count hashes, e.g. on a chain reorganisation. */
+    bool pop(uint64_t count, uint64_t height, std::string& err);
+    /* Pick up the length and height another process wrote to the backing file. */
+    bool refresh(std::string& err);
+
+    uint64_t size() const;
+    uint64_t height() const;
+    bool writable() const { return m_writable; }
+    const std::string& path() const { return m_path; }
+
+    bool hash(const char* input, uint32_t input_len, char* output, uint64_t height, std::string& err) const;
+    bool hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs, uint64_t height, std::string& err) const;
+
+private:
+    boolberry_scratchpad(const std::string& path, bool writable);
+    ~boolberry_scratchpad();
+
+    bool check_write(uint64_t len, std::string& err) const;
+    bool append_locked(const char* data, uint64_t len, uint64_t height, std::string& err);
+    bool set_size(uint64_t size, uint64_t height, std::string& err);
+    bool reserve(uint64_t len, std::string& err);
+    bool map_file(uint64_t len, std::string& err);
+    bool read_header(std::string& err);
+    bool write_header(std::string& err);
+    void unmap();
+
+    void lock_shared() const;
+    void lock_exclusive() const;
+    void unlock_shared() const;
+    void unlock_exclusive() const;
+
+    std::string m_path;
+    bool m_writable;
+    int m_fd;
+    char* m_map;
+    char* m_data;
+    uint64_t m_size;
+    uint64_t m_capacity;
+    uint64_t m_height;
+    int m_refs;
+#ifdef _WIN32
+    mutable SRWLOCK m_lock;
+#else
+    mutable pthread_rwlock_t m_lock;
+#endif
+};
@@ -0,0 +1,24 @@
+#include "c11.h"
+#include <stdint.h>
+
+#include "chain.h"
+
+/* The stages after BLAKE-512, as in algo/x11/c11.c */
+static const chain_stage* const c11_stages[] = {
+    &chain_bmw512, &chain_groestl512, &chain_jh512, &chain_keccak512, &chain_skein512,
+    &chain_luffa512, &chain_cubehash512, &chain_shavite512, &chain_simd512, &chain_echo512
+};
+
+static const chain_seq c11_seq = {
+    chain_blake512_input, c11_stages, sizeof c11_stages / sizeof c11_stages[0]
+};
+
+void c11_hash(const char* input, char* output, uint32_t len)
+{
+    chain_seq_hash(&c11_seq, input, output, len);
+}
+
+void c11_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    chain_seq_hash_batch(&c11_seq, inputs, input_lens, count, outputs);
+}
@@ -0,0 +1,20 @@
+#ifndef C11_H
+#define C11_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* The x11 stages with JH and Keccak moved ahead of Skein (Chaincoin). */
+void c11_hash(const char* input, char* output, uint32_t len);
+
+/* Same as c11_hash() for count inputs, run through the chain stage by stage. */
+void c11_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
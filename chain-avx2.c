@@ -0,0 +1,436 @@
+/*
+ * Multi-lane AVX2 kernels of the chain stages, selected at run time by
+ * chain.c: BLAKE-512 and Skein-512 of four 64 byte hashes, one hash per 64
+ * bit lane, and Shabal-512 of eight, one per 32 bit lane.  A 64 byte
+ * message is a single block for all three, so padding, lengths and tweaks
+ * are constants.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+#define ADD(a, b)       _mm256_add_epi64(a, b)
+#define XOR(a, b)       _mm256_xor_si256(a, b)
+#define ROTL(x, n)      _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - (n)))
+#define ROTR(x, n)      ROTL(x, 64 - (n))
+#define C64(x)          _mm256_set1_epi64x((long long) (x))
+
+/* Words i of four rows into row i of four words; its own inverse */
+#define TRANSPOSE4(a, b, c, d)   do { \
+        __m256i t0 = _mm256_unpacklo_epi64(a, b); \
+        __m256i t1 = _mm256_unpackhi_epi64(a, b); \
+        __m256i t2 = _mm256_unpacklo_epi64(c, d); \
+        __m256i t3 = _mm256_unpackhi_epi64(c, d); \
+        (a) = _mm256_permute2x128_si256(t0, t2, 0x20); \
+        (b) = _mm256_permute2x128_si256(t1, t3, 0x20); \
+        (c) = _mm256_permute2x128_si256(t0, t2, 0x31); \
+        (d) = _mm256_permute2x128_si256(t1, t3, 0x31); \
+    } while (0)
+
+static void load_x4(__m256i w[8], uint32_t* const hash[4])
+{
+    int i;
+
+    for (i = 0; i < 8; i += 4) {
+        w[i] = _mm256_loadu_si256((const __m256i*) (hash[0] + 2 * i));
+        w[i + 1] = _mm256_loadu_si256((const __m256i*) (hash[1] + 2 * i));
+        w[i + 2] = _mm256_loadu_si256((const __m256i*) (hash[2] + 2 * i));
+        w[i + 3] = _mm256_loadu_si256((const __m256i*) (hash[3] + 2 * i));
+        TRANSPOSE4(w[i], w[i + 1], w[i + 2], w[i + 3]);
+    }
+}
+
+static void store_x4(uint32_t* const hash[4], __m256i w[8])
+{
+    int i;
+
+    for (i = 0; i < 8; i += 4) {
+        TRANSPOSE4(w[i], w[i + 1], w[i + 2], w[i + 3]);
+        _mm256_storeu_si256((__m256i*) (hash[0] + 2 * i), w[i]);
+        _mm256_storeu_si256((__m256i*) (hash[1] + 2 * i), w[i + 1]);
+        _mm256_storeu_si256((__m256i*) (hash[2] + 2 * i), w[i + 2]);
+        _mm256_storeu_si256((__m256i*) (hash[3] + 2 * i), w[i + 3]);
+    }
+}
+
+/* BLAKE-512 */
+
+static const uint64_t blake512_iv[8] = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+};
+
+static const uint64_t blake512_cb[16] = {
+    0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL, 0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL,
+    0x452821E638D01377ULL, 0xBE5466CF34E90C6CULL, 0xC0AC29B7C97C50DDULL, 0x3F84D5B5B5470917ULL,
+    0x9216D5D98979FB1BULL, 0xD1310BA698DFB5ACULL, 0x2FFD72DBD01ADFB7ULL, 0xB8E1AFED6A267E96ULL,
+    0xBA7C9045F12C7F99ULL, 0x24A19947B3916CF7ULL, 0x0801F2E2858EFC16ULL, 0x636920D871574E69ULL
+};
+
+static const uint8_t blake512_sigma[10][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+#define BLAKE_G(r, i, a, b, c, d)   do { \
+        const uint8_t s0 = blake512_sigma[r][2 * (i)], s1 = blake512_sigma[r][2 * (i) + 1]; \
+        a = ADD(ADD(a, b), XOR(M[s0], C64(blake512_cb[s1]))); \
+        d = _mm256_shuffle_epi32(XOR(d, a), 0xB1); \
+        c = ADD(c, d); \
+        b = ROTR(XOR(b, c), 25); \
+        a = ADD(ADD(a, b), XOR(M[s1], C64(blake512_cb[s0]))); \
+        d = _mm256_shuffle_epi8(XOR(d, a), ror16); \
+        c = ADD(c, d); \
+        b = ROTR(XOR(b, c), 11); \
+    } while (0)
+
+#define BLAKE_ROUND(r)   do { \
+        BLAKE_G(r, 0, V[0], V[4], V[8], V[12]); \
+        BLAKE_G(r, 1, V[1], V[5], V[9], V[13]); \
+        BLAKE_G(r, 2, V[2], V[6], V[10], V[14]); \
+        BLAKE_G(r, 3, V[3], V[7], V[11], V[15]); \
+        BLAKE_G(r, 4, V[0], V[5], V[10], V[15]); \
+        BLAKE_G(r, 5, V[1], V[6], V[11], V[12]); \
+        BLAKE_G(r, 6, V[2], V[7], V[8], V[13]); \
+        BLAKE_G(r, 7, V[3], V[4], V[9], V[14]); \
+    } while (0)
+
+void chain_blake512_x4_avx2(uint32_t* const hash[4])
+{
+    const __m256i bswap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                           7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m256i ror16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                           2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+    __m256i M[16], V[16];
+    int i;
+
+    /* The hash, then the padding: a 1 bit, the final block marker and the length, 512 bits */
+    load_x4(M, hash);
+    for (i = 0; i < 8; i++)
+        M[i] = _mm256_shuffle_epi8(M[i], bswap);
+    M[8] = C64(0x8000000000000000ULL);
+    M[9] = M[10] = M[11] = M[12] = M[14] = _mm256_setzero_si256();
+    M[13] = C64(1);
+    M[15] = C64(512);
+
+    for (i = 0; i < 8; i++)
+        V[i] = C64(blake512_iv[i]);
+    for (i = 0; i < 4; i++)
+        V[8 + i] = C64(blake512_cb[i]);
+    V[12] = C64(512 ^ blake512_cb[4]);
+    V[13] = C64(512 ^ blake512_cb[5]);
+    V[14] = C64(blake512_cb[6]);
+    V[15] = C64(blake512_cb[7]);
+
+    BLAKE_ROUND(0);
+    BLAKE_ROUND(1);
+    BLAKE_ROUND(2);
+    BLAKE_ROUND(3);
+    BLAKE_ROUND(4);
+    BLAKE_ROUND(5);
+    BLAKE_ROUND(6);
+    BLAKE_ROUND(7);
+    BLAKE_ROUND(8);
+    BLAKE_ROUND(9);
+    BLAKE_ROUND(0);
+    BLAKE_ROUND(1);
+    BLAKE_ROUND(2);
+    BLAKE_ROUND(3);
+    BLAKE_ROUND(4);
+    BLAKE_ROUND(5);
+
+    for (i = 0; i < 8; i++)
+        V[i] = _mm256_shuffle_epi8(XOR(C64(blake512_iv[i]), XOR(V[i], V[i + 8])), bswap);
+    store_x4(hash, V);
+}
+
+/* Skein-512 */
+
+static const uint64_t skein512_iv[8] = {
+    0x4903ADFF749C51CEULL, 0x0D95DE399746DF03ULL, 0x8FD1934127C79BCEULL, 0x9A255629FF352CB1ULL,
+    0x5DB62599DF6CA7B0ULL, 0xEABE394CA9D5C3F4ULL, 0x991112C71A75B523ULL, 0xAE18A40B660FCC33ULL
+};
+
+#define SKEIN_MIX(x0, x1, rc)   do { \
+        x0 = ADD(x0, x1); \
+        x1 = XOR(ROTL(x1, rc), x0); \
+    } while (0)
+
+#define SKEIN_MIX8(w0, w1, w2, w3, w4, w5, w6, w7, rc0, rc1, rc2, rc3)   do { \
+        SKEIN_MIX(p[w0], p[w1], rc0); \
+        SKEIN_MIX(p[w2], p[w3], rc1); \
+        SKEIN_MIX(p[w4], p[w5], rc2); \
+        SKEIN_MIX(p[w6], p[w7], rc3); \
+    } while (0)
+
+#define SKEIN_ADDKEY(s)   do { \
+        p[0] = ADD(p[0], k[((s) + 0) % 9]); \
+        p[1] = ADD(p[1], k[((s) + 1) % 9]); \
+        p[2] = ADD(p[2], k[((s) + 2) % 9]); \
+        p[3] = ADD(p[3], k[((s) + 3) % 9]); \
+        p[4] = ADD(p[4], k[((s) + 4) % 9]); \
+        p[5] = ADD(p[5], ADD(k[((s) + 5) % 9], t[(s) % 3])); \
+        p[6] = ADD(p[6], ADD(k[((s) + 6) % 9], t[((s) + 1) % 3])); \
+        p[7] = ADD(p[7], ADD(k[((s) + 7) % 9], C64(s))); \
+    } while (0)
+
+/* Eight rounds from subkey s, which is even */
+#define SKEIN_8ROUNDS(s)   do { \
+        SKEIN_ADDKEY(s); \
+        SKEIN_MIX8(0, 1, 2, 3, 4, 5, 6, 7, 46, 36, 19, 37); \
+        SKEIN_MIX8(2, 1, 4, 7, 6, 5, 0, 3, 33, 27, 14, 42); \
+        SKEIN_MIX8(4, 1, 6, 3, 0, 5, 2, 7, 17, 49, 36, 39); \
+        SKEIN_MIX8(6, 1, 0, 7, 2, 5, 4, 3, 44,  9, 54, 56); \
+        SKEIN_ADDKEY((s) + 1); \
+        SKEIN_MIX8(0, 1, 2, 3, 4, 5, 6, 7, 39, 30, 34, 24); \
+        SKEIN_MIX8(2, 1, 4, 7, 6, 5, 0, 3, 13, 50, 10, 17); \
+        SKEIN_MIX8(4, 1, 6, 3, 0, 5, 2, 7, 25, 29, 39, 43); \
+        SKEIN_MIX8(6, 1, 0, 7, 2, 5, 4, 3,  8, 35, 56, 22); \
+    } while (0)
+
+/* One UBI block: Threefish-512 keyed by h and tweaked by t0, t1, fed forward with m into h */
+static void skein512_ubi(__m256i h[8], const __m256i m[8], uint64_t t0, uint64_t t1)
+{
+    const __m256i t[3] = { C64(t0), C64(t1), C64(t0 ^ t1) };
+    __m256i k[9], p[8];
+    int i;
+
+    k[8] = C64(0x1BD11BDAA9FC1A22ULL);
+    for (i = 0; i < 8; i++) {
+        k[i] = h[i];
+        k[8] = XOR(k[8], h[i]);
+        p[i] = m[i];
+    }
+
+    SKEIN_8ROUNDS(0);
+    SKEIN_8ROUNDS(2);
+    SKEIN_8ROUNDS(4);
+    SKEIN_8ROUNDS(6);
+    SKEIN_8ROUNDS(8);
+    SKEIN_8ROUNDS(10);
+    SKEIN_8ROUNDS(12);
+    SKEIN_8ROUNDS(14);
+    SKEIN_8ROUNDS(16);
+    SKEIN_ADDKEY(18);
+
+    for (i = 0; i < 8; i++)
+        h[i] = XOR(m[i], p[i]);
+}
+
+void chain_skein512_x4_avx2(uint32_t* const hash[4])
+{
+    __m256i m[8], h[8];
+    int i;
+
+    load_x4(m, hash);
+    for (i = 0; i < 8; i++)
+        h[i] = C64(skein512_iv[i]);
+
+    /* The message as the first and final block of 64 bytes, then the output block, all zero */
+    skein512_ubi(h, m, 64, 480ULL << 55);
+    for (i = 0; i < 8; i++)
+        m[i] = _mm256_setzero_si256();
+    skein512_ubi(h, m, 8, 510ULL << 55);
+
+    store_x4(hash, h);
+}
+
+/*
+ * Skein-512 of four 80 byte headers into four 64 byte hashes, for veltor.c.
+ * mid, when not NULL, is the chaining value after their common first 64
+ * bytes, and only the last 16 bytes are left to hash.
+ */
+void chain_skein512_80_x4_avx2(const uint64_t* mid, const unsigned char* const input[4], uint32_t* const hash[4])
+{
+    __m256i m[8], h[8];
+    uint64_t tail[2][4];
+    int i;
+
+    if (mid) {
+        for (i = 0; i < 8; i++)
+            h[i] = C64(mid[i]);
+    } else {
+        uint32_t* const head[4] = {
+            (uint32_t*) input[0], (uint32_t*) input[1], (uint32_t*) input[2], (uint32_t*) input[3]
+        };
+
+        load_x4(m, head);
+        for (i = 0; i < 8; i++)
+            h[i] = C64(skein512_iv[i]);
+        skein512_ubi(h, m, 64, 224ULL << 55);
+    }
+
+    /* Bytes 64..79 as the final block, zero padded, then the output block */
+    for (i = 0; i < 4; i++) {
+        memcpy(&tail[0][i], input[i] + 64, 8);
+        memcpy(&tail[1][i], input[i] + 72, 8);
+    }
+    m[0] = _mm256_loadu_si256((const __m256i*) tail[0]);
+    m[1] = _mm256_loadu_si256((const __m256i*) tail[1]);
+    for (i = 2; i < 8; i++)
+        m[i] = _mm256_setzero_si256();
+    skein512_ubi(h, m, 80, 352ULL << 55);
+    for (i = 0; i < 8; i++)
+        m[i] = _mm256_setzero_si256();
+    skein512_ubi(h, m, 8, 510ULL << 55);
+
+    store_x4(hash, h);
+}
+
+/* Shabal-512, one hash per 32 bit lane of eight */
+
+#define ADD32(a, b)     _mm256_add_epi32(a, b)
+#define ROTL32(x, n)    _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#define C32(x)          _mm256_set1_epi32((int) (x))
+
+static const uint32_t shabal512_a[12] = {
+    0x20728DFD, 0x46C0BD53, 0xE782B699, 0x55304632, 0x71B4EF90, 0x0EA9E82C,
+    0xDBB930F1, 0xFAD06B8B, 0xBE0CAE40, 0x8BD14410, 0x76D2ADAC, 0x28ACAB7F
+};
+
+static const uint32_t shabal512_b[16] = {
+    0xC1099CB7, 0x07B385F3, 0xE7442C26, 0xCC8AD640, 0xEB6F56C7, 0x1EA81AA9, 0x73B9D314, 0x1DE85D08,
+    0x48910A5A, 0x893B22DB, 0xC5A0DF44, 0xBBC4324E, 0x72D2F240, 0x75941D99, 0x6D8BDE82, 0xA1A7502B
+};
+
+static const uint32_t shabal512_c[16] = {
+    0xD9BF68D1, 0x58BAD750, 0x56028CB2, 0x8134F359, 0xB5D469D8, 0x941A8CC2, 0x418B2A6E, 0x04052780,
+    0x7F07D787, 0x5194358F, 0x3C60D665, 0xBE97D79A, 0x950C3434, 0xAED9A06D, 0x2537DC8D, 0x7CDB5969
+};
+
+/* Eight rows of eight words each into eight vectors of one word from each row, and back */
+#define TRANSPOSE8(r)   do { \
+        __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]); \
+        __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]); \
+        __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]); \
+        __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]); \
+        __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2); \
+        __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3); \
+        __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6); \
+        __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7); \
+        r[0] = _mm256_permute2x128_si256(u0, u4, 0x20); \
+        r[1] = _mm256_permute2x128_si256(u1, u5, 0x20); \
+        r[2] = _mm256_permute2x128_si256(u2, u6, 0x20); \
+        r[3] = _mm256_permute2x128_si256(u3, u7, 0x20); \
+        r[4] = _mm256_permute2x128_si256(u0, u4, 0x31); \
+        r[5] = _mm256_permute2x128_si256(u1, u5, 0x31); \
+        r[6] = _mm256_permute2x128_si256(u2, u6, 0x31); \
+        r[7] = _mm256_permute2x128_si256(u3, u7, 0x31); \
+    } while (0)
+
+/* One element of the keyed permutation; the multiplications by 5 and 3 are a shift and an add */
+#define SHABAL_ELT(a0, a1, b0, b1, b2, b3, c, m)   do { \
+        __m256i u = ROTL32(a1, 15); \
+        u = XOR(XOR(a0, ADD32(u, _mm256_slli_epi32(u, 2))), c); \
+        u = ADD32(u, _mm256_slli_epi32(u, 1)); \
+        a0 = XOR(XOR(u, b1), XOR(_mm256_andnot_si256(b3, b2), m)); \
+        b0 = XOR(XOR(ROTL32(b0, 1), a0), ones); \
+    } while (0)
+
+/* Element i of step s: A rotates by 16 words a step, B and C by one word an element */
+#define SHABAL_ELT_SI(s, i) \
+    SHABAL_ELT(A[(4 * (s) + (i)) % 12], A[(4 * (s) + (i) + 11) % 12], B[i], B[((i) + 13) & 15], \
+        B[((i) + 9) & 15], B[((i) + 6) & 15], C[(24 - (i)) & 15], M[i])
+
+#define SHABAL_STEP(s)   do { \
+        SHABAL_ELT_SI(s, 0); SHABAL_ELT_SI(s, 1); SHABAL_ELT_SI(s, 2); SHABAL_ELT_SI(s, 3); \
+        SHABAL_ELT_SI(s, 4); SHABAL_ELT_SI(s, 5); SHABAL_ELT_SI(s, 6); SHABAL_ELT_SI(s, 7); \
+        SHABAL_ELT_SI(s, 8); SHABAL_ELT_SI(s, 9); SHABAL_ELT_SI(s, 10); SHABAL_ELT_SI(s, 11); \
+        SHABAL_ELT_SI(s, 12); SHABAL_ELT_SI(s, 13); SHABAL_ELT_SI(s, 14); SHABAL_ELT_SI(s, 15); \
+    } while (0)
+
+/* A[11 - i] += C[o - i] for the twelve words of A */
+#define SHABAL_ADD_C(o)   do { \
+        int i_; \
+        for (i_ = 0; i_ < 12; i_++) \
+            A[11 - i_] = ADD32(A[11 - i_], C[((o) + 16 - i_) & 15]); \
+    } while (0)
+
+/* W into A, the keyed permutation and the feed of C into A; the caller adds and subtracts M */
+static void shabal512_p(__m256i A[12], __m256i B[16], const __m256i C[16], const __m256i M[16], uint32_t w)
+{
+    const __m256i ones = _mm256_set1_epi32(-1);
+    int i;
+
+    A[0] = XOR(A[0], C32(w));
+    for (i = 0; i < 16; i++)
+        B[i] = ROTL32(B[i], 17);
+    SHABAL_STEP(0);
+    SHABAL_STEP(1);
+    SHABAL_STEP(2);
+    SHABAL_ADD_C(6);
+    SHABAL_ADD_C(10);
+    SHABAL_ADD_C(14);
+}
+
+void chain_shabal512_x8_avx2(uint32_t* const hash[8])
+{
+    __m256i A[12], B[16], C[16], M[16], T;
+    int i, r;
+
+    for (i = 0; i < 8; i++) {
+        M[i] = _mm256_loadu_si256((const __m256i*) hash[i]);
+        M[i + 8] = _mm256_loadu_si256((const __m256i*) (hash[i] + 8));
+    }
+    TRANSPOSE8(M);
+    TRANSPOSE8((M + 8));
+    for (i = 0; i < 12; i++)
+        A[i] = C32(shabal512_a[i]);
+    for (i = 0; i < 16; i++) {
+        B[i] = ADD32(C32(shabal512_b[i]), M[i]);
+        C[i] = C32(shabal512_c[i]);
+    }
+
+    /* The message block, with the block counter at 1 */
+    shabal512_p(A, B, C, M, 1);
+    for (i = 0; i < 16; i++) {
+        T = B[i];
+        B[i] = _mm256_sub_epi32(C[i], M[i]);
+        C[i] = T;
+    }
+
+    /* The padding block, then three more rounds on it, all with the counter at 2 */
+    M[0] = C32(0x80);
+    for (i = 1; i < 16; i++)
+        M[i] = _mm256_setzero_si256();
+    B[0] = ADD32(B[0], M[0]);
+    shabal512_p(A, B, C, M, 2);
+    for (r = 0; r < 3; r++) {
+        for (i = 0; i < 16; i++) {
+            T = B[i];
+            B[i] = C[i];
+            C[i] = T;
+        }
+        shabal512_p(A, B, C, M, 2);
+    }
+
+    TRANSPOSE8(B);
+    TRANSPOSE8((B + 8));
+    for (i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i*) hash[i], B[i]);
+        _mm256_storeu_si256((__m256i*) (hash[i] + 8), B[i + 8]);
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
@@ -0,0 +1,586 @@
+#include "chain.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/sha.h>
+
+#include "compat.h"
+#include "cpu_features.h"
+#include "sha3/sph_blake.h"
+#include "sha3/sph_bmw.h"
+#include "sha3/sph_groestl.h"
+#include "sha3/sph_jh.h"
+#include "sha3/sph_keccak.h"
+#include "sha3/sph_skein.h"
+#include "sha3/sph_shavite.h"
+#include "sha3/sph_echo.h"
+#include "sha3/sph_hamsi.h"
+#include "sha3/sph_fugue.h"
+#include "sha3/sph_shabal.h"
+#include "sha3/sph_whirlpool.h"
+#include "sha3/gost_streebog.h"
+#include "sha3/sph_sm3.h"
+#include "sha3/keccakf1600.h"
+#include "algo/haval/sph-haval.h"
+#include "algo/luffa/sse2/luffa_for_sse2.h"
+#include "algo/cubehash/sse2/cubehash_sse2.h"
+#include "algo/simd/sse2/nist.h"
+#include "algo/echo/aes_ni/echo-aes.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CHAIN_AVX2 1
+/* chain-avx2.c */
+extern void chain_blake512_x4_avx2(uint32_t* const hash[4]);
+extern void chain_skein512_x4_avx2(uint32_t* const hash[4]);
+extern void chain_shabal512_x8_avx2(uint32_t* const hash[8]);
+#endif
+
+/* Initial states that are costly to set up, CubeHash's 160 rounds above all. */
+static hashState_luffa s_luffa_init;
+static cubehashParam s_cube_init;
+static hashState_sd s_simd_init;
+#ifdef ECHO_AES
+static hashState_echo s_echo_aes_init;
+#endif
+static int s_echo_aes;
+static int s_avx2;
+
+static void init_stages(void)
+{
+    s_avx2 = cpu_has(CPU_FEATURE_AVX2);
+    init_luffa(&s_luffa_init, 512);
+    cubehashInit(&s_cube_init, 512, 16, 32);
+    init_sd(&s_simd_init, 512);
+#ifdef ECHO_AES
+    s_echo_aes = cpu_has(CPU_FEATURE_AES | CPU_FEATURE_SSSE3);
+    if (s_echo_aes)
+        echo_aes_init(&s_echo_aes_init, 512);
+#endif
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_stages_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK init_stages_once(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    init_stages();
+    return TRUE;
+}
+#define STAGES_INIT_ONCE()  InitOnceExecuteOnce(&s_stages_once, init_stages_once, NULL, NULL)
+#else
+static pthread_once_t s_stages_once = PTHREAD_ONCE_INIT;
+#define STAGES_INIT_ONCE()  pthread_once(&s_stages_once, init_stages)
+#endif
+
+/*
+ * The context of whichever stage is running, in one cache-aligned block per
+ * thread: the chain reuses the same lines from stage to stage instead of a
+ * fresh, differently placed stack frame for each.
+ */
+typedef union {
+    sph_blake512_context     blake;
+    sph_bmw512_context       bmw;
+    sph_groestl512_context   groestl;
+    sph_skein512_context     skein;
+    sph_jh512_context        jh;
+    sph_keccak512_context    keccak;
+    hashState_luffa          luffa;
+    cubehashParam            cube;
+    sph_shavite512_context   shavite;
+    hashState_sd             simd;
+    sph_echo512_context      echo;
+#ifdef ECHO_AES
+    hashState_echo           echo_aes;
+#endif
+    sph_hamsi512_context     hamsi;
+    sph_fugue512_context     fugue;
+    sph_shabal512_context    shabal;
+    sph_whirlpool_context    whirlpool;
+    sph_gost512_context      gost;
+    SHA512_CTX               sha512;
+    sph_haval256_5_context   haval;
+} chain_ctx;
+
+static __thread chain_ctx _ALIGN(64) s_ctx;
+
+/* An sph hash of the 64 byte hash, as a stage. */
+#define SPH_STAGE(name, member, init, update, close) \
+    static void name(uint32_t* hash) \
+    { \
+        chain_ctx* ctx = &s_ctx; \
+        init(&ctx->member); \
+        update(&ctx->member, hash, 64); \
+        close(&ctx->member, hash); \
+    }
+
+SPH_STAGE(blake512_one, blake, sph_blake512_init, sph_blake512, sph_blake512_close)
+SPH_STAGE(bmw512_one, bmw, sph_bmw512_init, sph_bmw512, sph_bmw512_close)
+SPH_STAGE(groestl512_one, groestl, sph_groestl512_init, sph_groestl512, sph_groestl512_close)
+SPH_STAGE(skein512_one, skein, sph_skein512_init, sph_skein512, sph_skein512_close)
+SPH_STAGE(jh512_one, jh, sph_jh512_init, sph_jh512, sph_jh512_close)
+SPH_STAGE(keccak512_one, keccak, sph_keccak512_init, sph_keccak512, sph_keccak512_close)
+SPH_STAGE(shavite512_one, shavite, sph_shavite512_init, sph_shavite512, sph_shavite512_close)
+SPH_STAGE(hamsi512_one, hamsi, sph_hamsi512_init, sph_hamsi512, sph_hamsi512_close)
+SPH_STAGE(fugue512_one, fugue, sph_fugue512_init, sph_fugue512, sph_fugue512_close)
+SPH_STAGE(shabal512_one, shabal, sph_shabal512_init, sph_shabal512, sph_shabal512_close)
+SPH_STAGE(whirlpool_one, whirlpool, sph_whirlpool_init, sph_whirlpool, sph_whirlpool_close)
+SPH_STAGE(gost512_one, gost, sph_gost512_init, sph_gost512, sph_gost512_close)
+
+#define KECCAK512_RATE  72
+
+/*
+ * Keccak-512 of four 64 byte hashes through one 4-lane permutation: the
+ * message and its original Keccak padding fill the 72 byte rate exactly.
+ */
+static void keccak512_x4(uint32_t* const hash[4])
+{
+    uint64_t _ALIGN(32) st[100];
+    int i, j;
+
+    memset(st, 0, sizeof st);
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 8; i++)
+            memcpy(&st[4 * i + j], hash[j] + 2 * i, 8);
+        st[4 * (KECCAK512_RATE / 8 - 1) + j] = 0x8000000000000001ULL;
+    }
+
+    keccakf1600_x4(st);
+
+    for (j = 0; j < 4; j++)
+        for (i = 0; i < 8; i++)
+            memcpy(hash[j] + 2 * i, &st[4 * i + j], 8);
+}
+
+#ifdef CHAIN_AVX2
+/* The four-lane kernels where AVX2 is there, four single hashes where not */
+#define AVX2_X4(name, one, avx2) \
+    static void name(uint32_t* const hash[4]) \
+    { \
+        int i; \
+        STAGES_INIT_ONCE(); \
+        if (s_avx2) { \
+            avx2(hash); \
+            return; \
+        } \
+        for (i = 0; i < 4; i++) \
+            one(hash[i]); \
+    }
+
+AVX2_X4(blake512_x4, blake512_one, chain_blake512_x4_avx2)
+AVX2_X4(skein512_x4, skein512_one, chain_skein512_x4_avx2)
+
+/* The same for the eight-lane kernels */
+#define AVX2_X8(name, one, avx2) \
+    static void name(uint32_t* const hash[8]) \
+    { \
+        int i; \
+        STAGES_INIT_ONCE(); \
+        if (s_avx2) { \
+            avx2(hash); \
+            return; \
+        } \
+        for (i = 0; i < 8; i++) \
+            one(hash[i]); \
+    }
+
+AVX2_X8(shabal512_x8, shabal512_one, chain_shabal512_x8_avx2)
+#else
+#define blake512_x4     NULL
+#define skein512_x4     NULL
+#define shabal512_x8    NULL
+#endif
+
+static void luffa512_one(uint32_t* hash)
+{
+    hashState_luffa* ctx = &s_ctx.luffa;
+
+    STAGES_INIT_ONCE();
+    memcpy(ctx, &s_luffa_init, sizeof *ctx);
+    update_and_final_luffa(ctx, (BitSequence*) hash, (const BitSequence*) hash, 64);
+}
+
+static void cubehash512_one(uint32_t* hash)
+{
+    cubehashParam* ctx = &s_ctx.cube;
+
+    STAGES_INIT_ONCE();
+    memcpy(ctx, &s_cube_init, sizeof *ctx);
+    cubehashUpdateDigest(ctx, (byte*) hash, (const byte*) hash, 64);
+}
+
+static void simd512_one(uint32_t* hash)
+{
+    hashState_sd* ctx = &s_ctx.simd;
+
+    STAGES_INIT_ONCE();
+    memcpy(ctx, &s_simd_init, sizeof *ctx);
+    update_final_sd(ctx, (BitSequence*) hash, (const BitSequence*) hash, 512);
+}
+
+static void echo512_one(uint32_t* hash)
+{
+    chain_ctx* ctx = &s_ctx;
+
+    STAGES_INIT_ONCE();
+#ifdef ECHO_AES
+    if (s_echo_aes) {
+        memcpy(&ctx->echo_aes, &s_echo_aes_init, sizeof ctx->echo_aes);
+        echo_aes_update_final(&ctx->echo_aes, (BitSequence*) hash, (const BitSequence*) hash, 512);
+        return;
+    }
+#endif
+    sph_echo512_init(&ctx->echo);
+    sph_echo512(&ctx->echo, hash, 64);
+    sph_echo512_close(&ctx->echo, hash);
+}
+
+/* The SHA512() one-shot goes through a provider lookup on OpenSSL 3, which costs more than the block. */
+static void sha512_one(uint32_t* hash)
+{
+    SHA512_CTX* ctx = &s_ctx.sha512;
+
+    SHA512_Init(ctx);
+    SHA512_Update(ctx, hash, 64);
+    SHA512_Final((unsigned char*) hash, ctx);
+}
+
+static void haval256_5_one(uint32_t* hash)
+{
+    sph_haval256_5_context* ctx = &s_ctx.haval;
+
+    sph_haval256_5_init(ctx);
+    sph_haval256_5(ctx, hash, 64);
+    sph_haval256_5_close(ctx, hash);
+    memset(&hash[8], 0, 32);
+}
+
+/* SM3 of a 64 byte hash is the hash itself, then a block of padding alone. */
+static void sm3_pad64(unsigned char* pad)
+{
+    memset(pad, 0, 64);
+    pad[0] = 0x80;
+    pad[62] = 0x02;
+}
+
+static void sm3_store(uint32_t* hash, const uint32_t* digest)
+{
+    unsigned char* out = (unsigned char*) hash;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        out[4 * i] = (unsigned char) (digest[i] >> 24);
+        out[4 * i + 1] = (unsigned char) (digest[i] >> 16);
+        out[4 * i + 2] = (unsigned char) (digest[i] >> 8);
+        out[4 * i + 3] = (unsigned char) digest[i];
+    }
+    memset(&hash[8], 0, 32);
+}
+
+static const uint32_t sm3_iv[8] = {
+    0x7380166F, 0x4914B2B9, 0x172442D7, 0xDA8A0600, 0xA96F30BC, 0x163138AA, 0xE38DEE4D, 0xB0FB0E4E
+};
+
+static void sm3_one(uint32_t* hash)
+{
+    unsigned char pad[64];
+    uint32_t digest[8];
+
+    sm3_pad64(pad);
+    memcpy(digest, sm3_iv, sizeof digest);
+    sm3_compress(digest, (const unsigned char*) hash);
+    sm3_compress(digest, pad);
+    sm3_store(hash, digest);
+}
+
+static void sm3_x8(uint32_t* const hash[8])
+{
+    unsigned char pad[64];
+    uint32_t digest[8][8];
+    const unsigned char* blocks[8];
+    int i;
+
+    sm3_pad64(pad);
+    for (i = 0; i < 8; i++) {
+        memcpy(digest[i], sm3_iv, sizeof digest[i]);
+        blocks[i] = (const unsigned char*) hash[i];
+    }
+    sm3_compress_x8(digest, blocks);
+    for (i = 0; i < 8; i++)
+        blocks[i] = pad;
+    sm3_compress_x8(digest, blocks);
+    for (i = 0; i < 8; i++)
+        sm3_store(hash[i], digest[i]);
+}
+
+const chain_stage chain_blake512 = { blake512_one, blake512_x4, NULL };
+const chain_stage chain_bmw512 = { bmw512_one, NULL, NULL };
+const chain_stage chain_groestl512 = { groestl512_one, NULL, NULL };
+const chain_stage chain_skein512 = { skein512_one, skein512_x4, NULL };
+const chain_stage chain_jh512 = { jh512_one, NULL, NULL };
+const chain_stage chain_keccak512 = { keccak512_one, keccak512_x4, NULL };
+const chain_stage chain_luffa512 = { luffa512_one, NULL, NULL };
+const chain_stage chain_cubehash512 = { cubehash512_one, NULL, NULL };
+const chain_stage chain_shavite512 = { shavite512_one, NULL, NULL };
+const chain_stage chain_simd512 = { simd512_one, NULL, NULL };
+const chain_stage chain_echo512 = { echo512_one, NULL, NULL };
+const chain_stage chain_hamsi512 = { hamsi512_one, NULL, NULL };
+const chain_stage chain_fugue512 = { fugue512_one, NULL, NULL };
+const chain_stage chain_shabal512 = { shabal512_one, NULL, shabal512_x8 };
+const chain_stage chain_whirlpool = { whirlpool_one, NULL, NULL };
+const chain_stage chain_sha512 = { sha512_one, NULL, NULL };
+const chain_stage chain_haval256_5 = { haval256_5_one, NULL, NULL };
+const chain_stage chain_gost512 = { gost512_one, NULL, NULL };
+const chain_stage chain_sm3 = { sm3_one, NULL, sm3_x8 };
+
+const chain_stage* const chain_x11_stages[CHAIN_X11_STAGES] = {
+    &chain_blake512, &chain_bmw512, &chain_groestl512, &chain_skein512, &chain_jh512, &chain_keccak512,
+    &chain_luffa512, &chain_cubehash512, &chain_shavite512, &chain_simd512, &chain_echo512
+};
+
+/* Runs the hashes listed in lanes through stage, eight or four at a time where it can. */
+static void run_lanes(const chain_stage* stage, chain_hash* hashes, const uint32_t* lanes, uint32_t count)
+{
+    uint32_t i = 0, j;
+
+    if (stage->x8) {
+        for (; i + 8 <= count; i += 8) {
+            uint32_t* group[8];
+
+            for (j = 0; j < 8; j++)
+                group[j] = hashes[lanes[i + j]];
+            stage->x8(group);
+        }
+    }
+    if (stage->x4) {
+        for (; i + 4 <= count; i += 4) {
+            uint32_t* const group[4] = {
+                hashes[lanes[i]], hashes[lanes[i + 1]], hashes[lanes[i + 2]], hashes[lanes[i + 3]]
+            };
+            stage->x4(group);
+        }
+    }
+    for (; i < count; i++)
+        stage->one(hashes[lanes[i]]);
+}
+
+void chain_run(const chain_stage* stage, chain_hash* hashes, uint32_t count)
+{
+    uint32_t lanes[CHAIN_BATCH_MAX];
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+        lanes[i] = i;
+    run_lanes(stage, hashes, lanes, count);
+}
+
+void chain_branch(uint32_t mask, const chain_stage* taken, const chain_stage* other,
+                  chain_hash* hashes, uint32_t count)
+{
+    uint32_t set[CHAIN_BATCH_MAX], clear[CHAIN_BATCH_MAX];
+    uint32_t nset = 0, nclear = 0;
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        if (hashes[i][0] & mask)
+            set[nset++] = i;
+        else
+            clear[nclear++] = i;
+    }
+    run_lanes(taken, hashes, set, nset);
+    run_lanes(other, hashes, clear, nclear);
+}
+
+void chain_switch(const chain_stage* const* stages, uint32_t nways, const uint8_t* ways,
+                  chain_hash* hashes, uint32_t count)
+{
+    uint32_t lanes[CHAIN_BATCH_MAX], end[CHAIN_WAYS_MAX + 1];
+    uint32_t i, w, start;
+
+    /* Counting sort by way: end[w] ends up where the lanes of way w stop */
+    memset(end, 0, sizeof end);
+    for (i = 0; i < count; i++)
+        if (ways[i] < nways)
+            end[ways[i] + 1]++;
+    for (w = 0; w < nways; w++)
+        end[w + 1] += end[w];
+    for (i = 0; i < count; i++)
+        if (ways[i] < nways)
+            lanes[end[ways[i]]++] = i;
+
+    for (w = 0, start = 0; w < nways; start = end[w++])
+        run_lanes(stages[w], hashes, lanes + start, end[w] - start);
+}
+
+void chain_blake512_input(const char* input, uint32_t len, uint32_t* hash)
+{
+    sph_blake512_context* ctx = &s_ctx.blake;
+
+    sph_blake512_init(ctx);
+    sph_blake512(ctx, input, len);
+    sph_blake512_close(ctx, hash);
+}
+
+void chain_skein512_input(const char* input, uint32_t len, uint32_t* hash)
+{
+    sph_skein512_context* ctx = &s_ctx.skein;
+
+    sph_skein512_init(ctx);
+    sph_skein512(ctx, input, len);
+    sph_skein512_close(ctx, hash);
+}
+
+/* Skein-512 split after its first 64 byte block, on an explicit UBI */
+
+static const uint64_t skein512_iv[8] = {
+    0x4903ADFF749C51CEULL, 0x0D95DE399746DF03ULL, 0x8FD1934127C79BCEULL, 0x9A255629FF352CB1ULL,
+    0x5DB62599DF6CA7B0ULL, 0xEABE394CA9D5C3F4ULL, 0x991112C71A75B523ULL, 0xAE18A40B660FCC33ULL
+};
+
+/* Tweak words of a first message block, a middle one, the final one and the output block */
+#define SKEIN_T1_FIRST  (224ULL << 55)
+#define SKEIN_T1_MSG    (96ULL << 55)
+#define SKEIN_T1_FINAL  (352ULL << 55)
+#define SKEIN_T1_OUT    (510ULL << 55)
+
+#define SKEIN_ROTL(x, n)    (((x) << (n)) | ((x) >> (64 - (n))))
+
+#define SKEIN_MIX(x0, x1, rc)   do { \
+        x0 += x1; \
+        x1 = SKEIN_ROTL(x1, rc) ^ x0; \
+    } while (0)
+
+#define SKEIN_MIX8(w0, w1, w2, w3, w4, w5, w6, w7, rc0, rc1, rc2, rc3)   do { \
+        SKEIN_MIX(p[w0], p[w1], rc0); \
+        SKEIN_MIX(p[w2], p[w3], rc1); \
+        SKEIN_MIX(p[w4], p[w5], rc2); \
+        SKEIN_MIX(p[w6], p[w7], rc3); \
+    } while (0)
+
+#define SKEIN_ADDKEY(s)   do { \
+        p[0] += k[((s) + 0) % 9]; \
+        p[1] += k[((s) + 1) % 9]; \
+        p[2] += k[((s) + 2) % 9]; \
+        p[3] += k[((s) + 3) % 9]; \
+        p[4] += k[((s) + 4) % 9]; \
+        p[5] += k[((s) + 5) % 9] + t[(s) % 3]; \
+        p[6] += k[((s) + 6) % 9] + t[((s) + 1) % 3]; \
+        p[7] += k[((s) + 7) % 9] + (uint64_t) (s); \
+    } while (0)
+
+/* Eight rounds from subkey s, which is even */
+#define SKEIN_8ROUNDS(s)   do { \
+        SKEIN_ADDKEY(s); \
+        SKEIN_MIX8(0, 1, 2, 3, 4, 5, 6, 7, 46, 36, 19, 37); \
+        SKEIN_MIX8(2, 1, 4, 7, 6, 5, 0, 3, 33, 27, 14, 42); \
+        SKEIN_MIX8(4, 1, 6, 3, 0, 5, 2, 7, 17, 49, 36, 39); \
+        SKEIN_MIX8(6, 1, 0, 7, 2, 5, 4, 3, 44,  9, 54, 56); \
+        SKEIN_ADDKEY((s) + 1); \
+        SKEIN_MIX8(0, 1, 2, 3, 4, 5, 6, 7, 39, 30, 34, 24); \
+        SKEIN_MIX8(2, 1, 4, 7, 6, 5, 0, 3, 13, 50, 10, 17); \
+        SKEIN_MIX8(4, 1, 6, 3, 0, 5, 2, 7, 25, 29, 39, 43); \
+        SKEIN_MIX8(6, 1, 0, 7, 2, 5, 4, 3,  8, 35, 56, 22); \
+    } while (0)
+
+/* One UBI block: Threefish-512 keyed by h and tweaked by t0, t1, fed forward with m into h */
+static void skein512_ubi(uint64_t h[8], const uint64_t m[8], uint64_t t0, uint64_t t1)
+{
+    const uint64_t t[3] = { t0, t1, t0 ^ t1 };
+    uint64_t k[9], p[8];
+    int i;
+
+    k[8] = 0x1BD11BDAA9FC1A22ULL;
+    for (i = 0; i < 8; i++) {
+        k[i] = h[i];
+        k[8] ^= h[i];
+        p[i] = m[i];
+    }
+
+    SKEIN_8ROUNDS(0);
+    SKEIN_8ROUNDS(2);
+    SKEIN_8ROUNDS(4);
+    SKEIN_8ROUNDS(6);
+    SKEIN_8ROUNDS(8);
+    SKEIN_8ROUNDS(10);
+    SKEIN_8ROUNDS(12);
+    SKEIN_8ROUNDS(14);
+    SKEIN_8ROUNDS(16);
+    SKEIN_ADDKEY(18);
+
+    for (i = 0; i < 8; i++)
+        h[i] = m[i] ^ p[i];
+}
+
+/* Up to 64 bytes as a block of little endian words, zero padded */
+static void skein512_load(uint64_t m[8], const char* input, uint32_t len)
+{
+    unsigned char block[64];
+    int i;
+
+    memset(block, 0, sizeof block);
+    memcpy(block, input, len);
+    for (i = 0; i < 8; i++)
+        m[i] = sph_dec64le(block + 8 * i);
+}
+
+void chain_skein512_midstate(const char* input, uint64_t* mid)
+{
+    uint64_t m[8];
+
+    memcpy(mid, skein512_iv, sizeof skein512_iv);
+    skein512_load(m, input, 64);
+    skein512_ubi(mid, m, 64, SKEIN_T1_FIRST);
+}
+
+void chain_skein512_resume(const uint64_t* mid, const char* input, uint32_t len, uint32_t* hash)
+{
+    uint64_t h[8], m[8];
+    uint64_t pos = 64;
+    int i;
+
+    memcpy(h, mid, sizeof h);
+    for (; len > 64; input += 64, len -= 64) {
+        skein512_load(m, input, 64);
+        pos += 64;
+        skein512_ubi(h, m, pos, SKEIN_T1_MSG);
+    }
+    skein512_load(m, input, len);
+    skein512_ubi(h, m, pos + len, SKEIN_T1_FINAL);
+
+    memset(m, 0, sizeof m);
+    skein512_ubi(h, m, 8, SKEIN_T1_OUT);
+    for (i = 0; i < 8; i++)
+        sph_enc64le((unsigned char*) hash + 8 * i, h[i]);
+}
+
+void chain_seq_hash(const chain_seq* seq, const char* input, char* output, uint32_t len)
+{
+    chain_hash _ALIGN(64) hash;
+    uint32_t i;
+
+    seq->first(input, len, hash);
+    for (i = 0; i < seq->count; i++)
+        seq->stages[i]->one(hash);
+    memcpy(output, hash, 32);
+}
+
+void chain_seq_hash_batch(const chain_seq* seq, const char* const* inputs, const uint32_t* input_lens,
+                          uint32_t count, char* const* outputs)
+{
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    uint32_t i, j, n;
+
+    for (; count; count -= n, inputs += n, input_lens += n, outputs += n) {
+        n = count < CHAIN_BATCH_MAX ? count : CHAIN_BATCH_MAX;
+        for (i = 0; i < n; i++)
+            seq->first(inputs[i], input_lens[i], hashes[i]);
+        for (j = 0; j < seq->count; j++)
+            chain_run(seq->stages[j], hashes, n);
+        for (i = 0; i < n; i++)
+            memcpy(outputs[i], hashes[i], 32);
+    }
+}
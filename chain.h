@@ -0,0 +1,112 @@
+#ifndef CHAIN_H
+#define CHAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Stages of the chained 512-bit hashes (quark, hmq1725 and friends), for
+ * running a batch stage by stage instead of hash by hash.  A stage hashes a
+ * 64 byte hash into the next one in place; x4 and x8, where there is a
+ * multi-way kernel, do four or eight hashes at once.
+ */
+typedef struct {
+    void (*one)(uint32_t* hash);
+    void (*x4)(uint32_t* const hash[4]);
+    void (*x8)(uint32_t* const hash[8]);
+} chain_stage;
+
+typedef uint32_t chain_hash[16];
+
+extern const chain_stage chain_blake512;
+extern const chain_stage chain_bmw512;
+extern const chain_stage chain_groestl512;
+extern const chain_stage chain_skein512;
+extern const chain_stage chain_jh512;
+extern const chain_stage chain_keccak512;
+extern const chain_stage chain_luffa512;
+extern const chain_stage chain_cubehash512;
+extern const chain_stage chain_shavite512;
+extern const chain_stage chain_simd512;
+extern const chain_stage chain_echo512;
+extern const chain_stage chain_hamsi512;
+extern const chain_stage chain_fugue512;
+extern const chain_stage chain_shabal512;
+extern const chain_stage chain_whirlpool;
+extern const chain_stage chain_sha512;
+/* HAVAL-256/5, zero padded to 64 bytes */
+extern const chain_stage chain_haval256_5;
+/* Streebog-512 (GOST R 34.11-2012) */
+extern const chain_stage chain_gost512;
+/* SM3, zero padded to 64 bytes */
+extern const chain_stage chain_sm3;
+
+/* The eleven X11 stages in X11 order, the numbering x11evo's orders use. */
+#define CHAIN_X11_STAGES 11
+extern const chain_stage* const chain_x11_stages[CHAIN_X11_STAGES];
+
+/* Most hashes chain_run() and chain_branch() take in one call. */
+#define CHAIN_BATCH_MAX 64
+
+/* Runs every hash through stage. */
+void chain_run(const chain_stage* stage, chain_hash* hashes, uint32_t count);
+
+/*
+ * The data dependent step: hashes whose first word has a bit of mask set go
+ * through taken, the others through other.  The two groups are run one
+ * after the other, so each stays on one algorithm and its multi-way kernel
+ * instead of alternating hash by hash.
+ */
+void chain_branch(uint32_t mask, const chain_stage* taken, const chain_stage* other,
+                  chain_hash* hashes, uint32_t count);
+
+/* Most ways chain_switch() picks from. */
+#define CHAIN_WAYS_MAX 16
+
+/*
+ * chain_branch() with more than two ways: hash i goes through
+ * stages[ways[i]], or is left as it is when ways[i] >= nways.  The hashes
+ * of each way again run as one group.
+ */
+void chain_switch(const chain_stage* const* stages, uint32_t nways, const uint8_t* ways,
+                  chain_hash* hashes, uint32_t count);
+
+/*
+ * A fixed chain: first hashes the raw input into the 64 byte hash, then the
+ * stages run in order.  The digest is the first 32 bytes.
+ */
+typedef struct {
+    void (*first)(const char* input, uint32_t len, uint32_t* hash);
+    const chain_stage* const* stages;
+    uint32_t count;
+} chain_seq;
+
+/* BLAKE-512 of the raw input, how the x-series chains start. */
+void chain_blake512_input(const char* input, uint32_t len, uint32_t* hash);
+
+/* Skein-512 of the raw input, for the chains that start there (skunk). */
+void chain_skein512_input(const char* input, uint32_t len, uint32_t* hash);
+
+/*
+ * Skein-512 in two steps for inputs longer than 64 bytes that share their
+ * first 64: chain_skein512_midstate() stores the chaining value after that
+ * block in mid[8], and chain_skein512_resume() finishes the hash from it
+ * over the len > 0 bytes that follow.
+ */
+void chain_skein512_midstate(const char* input, uint64_t* mid);
+void chain_skein512_resume(const uint64_t* mid, const char* input, uint32_t len, uint32_t* hash);
+
+void chain_seq_hash(const chain_seq* seq, const char* input, char* output, uint32_t len);
+
+/* Hashes count inputs through seq one stage at a time, CHAIN_BATCH_MAX per pass. */
+void chain_seq_hash_batch(const chain_seq* seq, const char* const* inputs, const uint32_t* input_lens,
+                          uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
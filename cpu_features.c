@@ -0,0 +1,102 @@
+#include "cpu_features.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CPU_FEATURES_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#ifdef CPU_FEATURES_X86
+
+static void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4])
+{
+#ifdef _MSC_VER
+	__cpuidex((int*)regs, leaf, subleaf);
+#else
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned long long xgetbv0(void)
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned lo, hi;
+	__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+
+static unsigned detect(void)
+{
+	unsigned regs[4];
+	unsigned features = 0;
+	unsigned max_leaf;
+	int ymm = 0;
+
+	cpuid(0, 0, regs);
+	max_leaf = regs[0];
+	if (max_leaf < 1)
+		return 0;
+
+	cpuid(1, 0, regs);
+	if (regs[3] & (1u << 26)) features |= CPU_FEATURE_SSE2;
+	if (regs[2] & (1u << 9))  features |= CPU_FEATURE_SSSE3;
+	if (regs[2] & (1u << 19)) features |= CPU_FEATURE_SSE41;
+	if (regs[2] & (1u << 20)) features |= CPU_FEATURE_SSE42;
+	if (regs[2] & (1u << 25)) features |= CPU_FEATURE_AES;
+	if (regs[2] & (1u << 1))  features |= CPU_FEATURE_PCLMUL;
+
+	/* OSXSAVE and AVX, then make sure the OS saves XMM and YMM state */
+	if ((regs[2] & (1u << 27)) && (regs[2] & (1u << 28)))
+		ymm = (xgetbv0() & 6) == 6;
+	if (ymm)
+		features |= CPU_FEATURE_AVX;
+
+	if (max_leaf >= 7) {
+		cpuid(7, 0, regs);
+		if (regs[1] & (1u << 3))        features |= CPU_FEATURE_BMI1;
+		if (regs[1] & (1u << 8))        features |= CPU_FEATURE_BMI2;
+		if (regs[1] & (1u << 29))       features |= CPU_FEATURE_SHA;
+		if (ymm && (regs[1] & (1u << 5))) features |= CPU_FEATURE_AVX2;
+	}
+
+	cpuid(0x80000000, 0, regs);
+	if (regs[0] >= 0x80000001) {
+		cpuid(0x80000001, 0, regs);
+		if (ymm && (regs[2] & (1u << 11))) features |= CPU_FEATURE_XOP;
+	}
+
+	return features;
+}
+
+#else
+
+static unsigned detect(void)
+{
+	return 0;
+}
+
+#endif
+
+/* Detection is idempotent, so racing threads at most repeat it. */
+static volatile unsigned s_features;
+static volatile int s_detected;
+
+unsigned cpu_features(void)
+{
+	if (!s_detected) {
+		s_features = detect();
+		s_detected = 1;
+	}
+	return s_features;
+}
+
+int cpu_has(unsigned features)
+{
+	return (cpu_features() & features) == features;
+}
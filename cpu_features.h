@@ -0,0 +1,34 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Runtime CPU feature detection, used to pick SIMD backends once per process.
+ * The AVX family bits are only set when the OS also saves the YMM state.
+ */
+#define CPU_FEATURE_SSE2     (1u << 0)
+#define CPU_FEATURE_SSSE3    (1u << 1)
+#define CPU_FEATURE_SSE41    (1u << 2)
+#define CPU_FEATURE_SSE42    (1u << 3)
+#define CPU_FEATURE_AES      (1u << 4)
+#define CPU_FEATURE_PCLMUL   (1u << 5)
+#define CPU_FEATURE_AVX      (1u << 6)
+#define CPU_FEATURE_AVX2     (1u << 7)
+#define CPU_FEATURE_BMI1     (1u << 8)
+#define CPU_FEATURE_BMI2     (1u << 9)
+#define CPU_FEATURE_SHA      (1u << 10)
+#define CPU_FEATURE_XOP      (1u << 11)
+
+unsigned cpu_features(void);
+
+/* Non-zero when every requested feature is present. */
+int cpu_has(unsigned features);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -10,6 +10,8 @@
 
 #include "c_groestl.h"
 #include "groestl_tables.h"
+#include "../sha3/sph_groestl.h"
+#include "../algo/groestl/aes_ni/groestl-backend.h"
 
 #define P_TYPE 0
 #define Q_TYPE 1
@@ -338,6 +340,15 @@ void groestl(const BitSequence* data,
 
   hashState context;
 
+  /* whole bytes go through the SIMD backend when the CPU has one */
+  if (!(databitlen & 7) && groestl256_backend()) {
+    sph_groestl256_context ctx;
+    sph_groestl256_init(&ctx);
+    sph_groestl256(&ctx, data, databitlen >> 3);
+    sph_groestl256_close(&ctx, hashval);
+    return;
+  }
+
   /* initialise */
     Init(&context);
 
@@ -6,6 +6,11 @@
 #include "../hash.h"
 #include "../wild_keccak.h"
 
+#include <vector>
+#ifdef _MSC_VER
+#include <xmmintrin.h>
+#endif
+
 
 namespace cryptonote
 {
@@ -27,4 +32,57 @@ namespace cryptonote
     });
     return true;
   }
+
+  /*
+   * get_blob_longhash_bb over several blobs at once.  locate(index) maps a
+   * state word to the scratchpad entry it selects; every entry a lane needs
+   * for its next round is prefetched before the other lanes run theirs.
+   */
+  template<typename locator_t>
+  bool get_blob_longhash_bb_batch(const blobdata* bds, crypto::hash* res, size_t count, uint64_t height, locator_t locate)
+  {
+    if (!count)
+      return true;
+
+    std::vector<const uint8_t*> in(count);
+    std::vector<size_t> inlen(count);
+    std::vector<uint8_t*> md(count);
+    for (size_t i = 0; i != count; i++)
+    {
+      in[i] = reinterpret_cast<const uint8_t*>(bds[i].data());
+      inlen[i] = bds[i].size();
+      md[i] = reinterpret_cast<uint8_t*>(&res[i]);
+    }
+
+    crypto::wild_keccak_dbl_batch<crypto::mul_f>(&in[0], &inlen[0], &md[0], sizeof(crypto::hash), count,
+      [&](const crypto::state_t_m& st, const void** refs)
+      {
+        if(!height)
+          return;
+        for(size_t i = 0; i != KK_MIXIN_SIZE; i++)
+        {
+          refs[i] = &locate(st[i]);
+#if defined(__GNUC__)
+          __builtin_prefetch(refs[i]);
+#elif defined(_MSC_VER)
+          _mm_prefetch((const char*)refs[i], _MM_HINT_T0);
+#endif
+        }
+      },
+      [&](const void* const* refs, crypto::mixin_t& mix)
+      {
+        if(!height)
+        {
+          memset(&mix, 0, sizeof(mix));
+          return;
+        }
+#define GET_REF(index) (*(const crypto::hash*)refs[index])
+        for(size_t i = 0; i!=6; i++)
+        {
+          *(crypto::hash*)&mix[i*4]  = XOR_4(GET_REF(i*4), GET_REF(i*4+1), GET_REF(i*4+2), GET_REF(i*4+3));
+        }
+#undef GET_REF
+      });
+    return true;
+  }
 }
@@ -153,6 +153,113 @@ namespace crypto
     return 0;
   }
 
+  /*
+   * Several independent wild_keccak_dbl computations run one round at a time
+   * in lockstep.  After each round a lane's next scratchpad references are
+   * computed and prefetched by prepare(st, refs), so their memory latency is
+   * hidden behind the rounds of the other lanes; mix(refs, mix_in) then reads
+   * them when the lane comes round again.
+   */
+  template<class f_traits, class prepare_t, class mix_t>
+  int wild_keccak_dbl_batch(const uint8_t* const* in, const size_t* inlen, uint8_t* const* md, size_t mdlen, size_t count, prepare_t prepare, mix_t mix)
+  {
+    struct lane_t
+    {
+      state_t_m st;
+      const void* refs[KK_MIXIN_SIZE];
+      uint8_t temp[144];
+      const uint8_t* in;
+      size_t inlen;
+      size_t block;
+      size_t blocks;
+      size_t round;
+      int pass;
+    };
+
+    const size_t max_lanes = 8;
+    lane_t lanes[max_lanes];
+    uint64_t rsiz = sizeof(state_t_m) == mdlen ? HASH_DATA_AREA : 200 - 2 * mdlen;
+    uint64_t rsizw = rsiz / 8;
+
+    for (size_t base = 0; base < count; base += max_lanes)
+    {
+      size_t n = count - base < max_lanes ? count - base : max_lanes;
+      size_t active = n;
+
+      for (size_t l = 0; l != n; l++)
+      {
+        lane_t& lane = lanes[l];
+        memset(&lane.st[0], 0, 25*sizeof(lane.st[0]));
+        lane.in = in[base + l];
+        lane.inlen = inlen[base + l];
+        lane.blocks = lane.inlen / rsiz + 1;
+        lane.block = 0;
+        lane.round = 0;
+        lane.pass = 0;
+      }
+
+      while (active)
+      {
+        for (size_t l = 0; l != n; l++)
+        {
+          lane_t& lane = lanes[l];
+          if (lane.pass == 2)
+            continue;
+
+          if (lane.round == 0)
+          {
+            const uint8_t* block = lane.in + lane.block * rsiz;
+            if (lane.block + 1 == lane.blocks)
+            {
+              // last block and padding
+              size_t left = lane.inlen - lane.block * rsiz;
+              memcpy(lane.temp, block, left);
+              lane.temp[left++] = 1;
+              memset(lane.temp + left, 0, rsiz - left);
+              lane.temp[rsiz - 1] |= 0x80;
+              block = lane.temp;
+            }
+            for (size_t i = 0; i < rsizw; i++)
+              lane.st[i] ^= ((const uint64_t *) block)[i];
+          }
+          else
+          {
+            mixin_t mix_in;
+            mix(lane.refs, mix_in);
+            for (size_t k = 0; k < KK_MIXIN_SIZE; k++)
+              lane.st[k] ^= mix_in[k];
+          }
+          f_traits::keccakf(lane.st, 1);
+
+          if (++lane.round == KECCAK_ROUNDS)
+          {
+            lane.round = 0;
+            if (++lane.block == lane.blocks)
+            {
+              uint8_t* out = md[base + l];
+              memcpy(out, lane.st, mdlen);
+              if (++lane.pass == 2)
+              {
+                active--;
+                continue;
+              }
+              //Satoshi's classic: hash the first result again
+              memset(&lane.st[0], 0, 25*sizeof(lane.st[0]));
+              lane.in = out;
+              lane.inlen = mdlen;
+              lane.blocks = mdlen / rsiz + 1;
+              lane.block = 0;
+            }
+          }
+
+          if (lane.round != 0)
+            prepare(lane.st, lane.refs);
+        }
+      }
+    }
+    return 0;
+  }
+
   class regular_f
   {
   public:
@@ -0,0 +1,147 @@
+#include "drop.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "sha3/sph_jh.h"
+#include "compat.h"
+#include "chain.h"
+
+#define POK_BOOL_MASK   0x00008000
+#define POK_DATA_MASK   0xFFFF0000
+
+#define DROP_ALGOS      10
+#define DROP_ROUNDS_MAX 5
+
+/* The jump table the steps index, numbered as in the reference switchHash() */
+static const chain_stage* const drop_stages[DROP_ALGOS] = {
+    &chain_keccak512, &chain_blake512, &chain_groestl512, &chain_skein512, &chain_luffa512,
+    &chain_echo512, &chain_shavite512, &chain_fugue512, &chain_simd512, &chain_cubehash512
+};
+
+/*
+ * The rounds of a hash: i runs from start to 30 and then from 0 to below
+ * start, in steps of nine.  Round i starts at algorithm i % 10 and shifts by
+ * i & 3 bits.
+ */
+static uint32_t drop_rounds(uint32_t start, uint8_t rounds[DROP_ROUNDS_MAX])
+{
+    uint32_t i, n = 0;
+
+    for (i = start; i < 31; i += 9)
+        rounds[n++] = (uint8_t) i;
+    for (i = 0; i < start; i += 9)
+        rounds[n++] = (uint8_t) i;
+    return n;
+}
+
+/* The 512 bit hash, least significant word first, shifted left in place */
+static void drop_shift(uint32_t* hash, unsigned shift)
+{
+    int i;
+
+    if (!shift)
+        return;
+    for (i = 15; i > 0; i--)
+        hash[i] = (hash[i] << shift) | (hash[i - 1] >> (32 - shift));
+    hash[0] <<= shift;
+}
+
+static void drop_jh(const uint32_t* header, uint32_t* hash)
+{
+    sph_jh512_context ctx;
+
+    sph_jh512_init(&ctx);
+    sph_jh512(&ctx, header, DROP_HEADER_SIZE);
+    sph_jh512_close(&ctx, hash);
+}
+
+static void drop_one(const uint32_t* header, uint32_t* hash)
+{
+    uint8_t rounds[DROP_ROUNDS_MAX];
+    uint32_t r, n, step;
+
+    drop_jh(header, hash);
+    n = drop_rounds(hash[0] % 31, rounds);
+    for (r = 0; r < n; r++) {
+        for (step = 0; step < DROP_ALGOS; step++) {
+            drop_shift(hash, rounds[r] & 3);
+            drop_stages[(rounds[r] + step) % DROP_ALGOS]->one(hash);
+        }
+    }
+}
+
+void drop_hash(const char* input, char* output)
+{
+    uint32_t header[20];
+    chain_hash _ALIGN(64) hash;
+
+    memcpy(header, input, DROP_HEADER_SIZE);
+    if (header[0] & POK_BOOL_MASK) {
+        header[0] &= ~POK_DATA_MASK;
+        drop_one(header, hash);
+        header[0] |= hash[0] & POK_DATA_MASK;
+        if (!(hash[0] & POK_DATA_MASK)) {
+            memcpy(output, hash, 32);
+            return;
+        }
+    }
+    drop_one(header, hash);
+    memcpy(output, hash, 32);
+}
+
+static void drop_chunk(const uint32_t (*headers)[20], chain_hash* hashes, uint32_t count)
+{
+    uint8_t rounds[CHAIN_BATCH_MAX][DROP_ROUNDS_MAX], nrounds[CHAIN_BATCH_MAX], ways[CHAIN_BATCH_MAX];
+    uint32_t i, r, step;
+
+    for (i = 0; i < count; i++) {
+        drop_jh(headers[i], hashes[i]);
+        nrounds[i] = (uint8_t) drop_rounds(hashes[i][0] % 31, rounds[i]);
+    }
+
+    /* Hashes with four rounds sit out the fifth */
+    for (r = 0; r < DROP_ROUNDS_MAX; r++) {
+        for (step = 0; step < DROP_ALGOS; step++) {
+            for (i = 0; i < count; i++) {
+                if (r < nrounds[i]) {
+                    drop_shift(hashes[i], rounds[i][r] & 3);
+                    ways[i] = (uint8_t) ((rounds[i][r] + step) % DROP_ALGOS);
+                } else {
+                    ways[i] = DROP_ALGOS;
+                }
+            }
+            chain_switch(drop_stages, DROP_ALGOS, ways, hashes, count);
+        }
+    }
+}
+
+void drop_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint32_t headers[CHAIN_BATCH_MAX][20];
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    uint32_t again[CHAIN_BATCH_MAX];
+    uint32_t i, n, m;
+
+    for (; count; count -= n, inputs += n, outputs += n) {
+        n = count < CHAIN_BATCH_MAX ? count : CHAIN_BATCH_MAX;
+        for (i = 0; i < n; i++) {
+            memcpy(headers[i], inputs[i], DROP_HEADER_SIZE);
+            if (headers[i][0] & POK_BOOL_MASK)
+                headers[i][0] &= ~POK_DATA_MASK;
+        }
+        drop_chunk((const uint32_t (*)[20]) headers, hashes, n);
+
+        /* The headers whose PoK data changes go round again, moved to the front */
+        for (i = 0, m = 0; i < n; i++) {
+            memcpy(outputs[i], hashes[i], 32);
+            if ((headers[i][0] & POK_BOOL_MASK) && (hashes[i][0] & POK_DATA_MASK)) {
+                memmove(headers[m], headers[i], DROP_HEADER_SIZE);
+                headers[m][0] |= hashes[i][0] & POK_DATA_MASK;
+                again[m++] = i;
+            }
+        }
+        drop_chunk((const uint32_t (*)[20]) headers, hashes, m);
+        for (i = 0; i < m; i++)
+            memcpy(outputs[again[i]], hashes[i], 32);
+    }
+}
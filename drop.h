@@ -0,0 +1,28 @@
+#ifndef DROP_H
+#define DROP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define DROP_HEADER_SIZE    80
+
+/*
+ * Dropcoin's DropLP over an 80 byte block header: JH-512, then four or five
+ * rounds of ten X11 algorithms, each round starting at another algorithm
+ * and shifting the hash left by up to three bits before every step.  The
+ * JH hash picks where the rounds start.  PoK versions are folded in as for
+ * zr5_hash().
+ */
+void drop_hash(const char* input, char* output);
+
+/* Same as drop_hash() for count headers, which run step by step, grouped by the algorithm of each step. */
+void drop_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,69 @@
+#include "hasher.h"
+
+#include <string.h>
+
+#include "sha3/sph_blake.h"
+#include "sha3/sph_bmw.h"
+#include "sha3/sph_groestl.h"
+#include "sha3/sph_jh.h"
+#include "sha3/sph_keccak.h"
+#include "sha3/sph_skein.h"
+#include "sha3/sph_cubehash.h"
+#include "sha3/sph_shabal.h"
+#include "sha3/sph_whirlpool.h"
+#include "sha256.h"
+
+static void sha256_init(void *cc)
+{
+	SHA256_Init((SHA256_CTX*)cc);
+}
+
+static void sha256_update(void *cc, const void *data, size_t len)
+{
+	SHA256_Update((SHA256_CTX*)cc, data, len);
+}
+
+static void sha256_close(void *cc, void *dst)
+{
+	/* SHA256_Final wipes the context, so start over explicitly */
+	SHA256_Final((unsigned char*)dst, (SHA256_CTX*)cc);
+	SHA256_Init((SHA256_CTX*)cc);
+}
+
+#define SPH_HASHER(algo, bits) \
+	{ #algo #bits, sizeof(sph_##algo##bits##_context), (bits) / 8, \
+	  sph_##algo##bits##_init, sph_##algo##bits, sph_##algo##bits##_close }
+
+const hasher_algo hasher_algos[] = {
+	SPH_HASHER(blake, 256),
+	SPH_HASHER(blake, 512),
+	SPH_HASHER(bmw, 256),
+	SPH_HASHER(bmw, 512),
+	SPH_HASHER(cubehash, 256),
+	SPH_HASHER(cubehash, 512),
+	SPH_HASHER(groestl, 256),
+	SPH_HASHER(groestl, 512),
+	SPH_HASHER(jh, 256),
+	SPH_HASHER(jh, 512),
+	SPH_HASHER(keccak, 256),
+	SPH_HASHER(keccak, 512),
+	SPH_HASHER(shabal, 256),
+	SPH_HASHER(shabal, 512),
+	SPH_HASHER(skein, 256),
+	SPH_HASHER(skein, 512),
+	{ "whirlpool", sizeof(sph_whirlpool_context), 64,
+	  sph_whirlpool_init, sph_whirlpool, sph_whirlpool_close },
+	{ "sha256", sizeof(SHA256_CTX), 32,
+	  sha256_init, sha256_update, sha256_close },
+	{ NULL, 0, 0, NULL, NULL, NULL }
+};
+
+const hasher_algo* hasher_find(const char *name)
+{
+	const hasher_algo *algo;
+
+	for (algo = hasher_algos; algo->name; algo++)
+		if (!strcmp(algo->name, name))
+			return algo;
+	return NULL;
+}
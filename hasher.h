@@ -0,0 +1,36 @@
+#ifndef HASHER_H
+#define HASHER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Incremental hashers over the single primitives, so large inputs can be fed
+ * in chunks instead of being concatenated into one buffer first.
+ *
+ * close() writes digest_size bytes and leaves the context initialized again,
+ * ready for the next message.
+ */
+typedef struct hasher_algo {
+	const char *name;
+	size_t ctx_size;
+	size_t digest_size;
+	void (*init)(void *cc);
+	void (*update)(void *cc, const void *data, size_t len);
+	void (*close)(void *cc, void *dst);
+} hasher_algo;
+
+/* NULL if the name is unknown */
+const hasher_algo* hasher_find(const char *name);
+
+/* NULL terminated list of every algorithm, for error messages and listings */
+extern const hasher_algo hasher_algos[];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,202 @@
+/*
+ * HEFTY1 compression of eight blocks on AVX2, one state per 32 bit lane,
+ * selected at run time by hefty1.c.  Every Mangle() and Br() case is
+ * computed in every lane and the one each lane's sponge picks is kept by
+ * masks, as in the scalar code.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+static const uint32_t hefty1_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ADD(a, b)       _mm256_add_epi32(a, b)
+#define XOR(a, b)       _mm256_xor_si256(a, b)
+#define AND(a, b)       _mm256_and_si256(a, b)
+#define OR(a, b)        _mm256_or_si256(a, b)
+#define ANDNOT(a, b)    _mm256_andnot_si256(a, b)
+#define SET1(x)         _mm256_set1_epi32((int) (x))
+#define ROTR(x, n)      OR(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+/* Rotation by a per-lane count of 0..31; a shift by 32 gives zero */
+#define ROTRV(x, n)     OR(_mm256_srlv_epi32(x, n), _mm256_sllv_epi32(x, _mm256_sub_epi32(SET1(32), n)))
+
+#define BSG0(x)         XOR(ROTR(x, 2), XOR(ROTR(x, 13), ROTR(x, 22)))
+#define BSG1(x)         XOR(ROTR(x, 6), XOR(ROTR(x, 11), ROTR(x, 25)))
+#define SSG0(x)         XOR(ROTR(x, 7), XOR(ROTR(x, 18), _mm256_srli_epi32(x, 3)))
+#define SSG1(x)         XOR(ROTR(x, 17), XOR(ROTR(x, 19), _mm256_srli_epi32(x, 10)))
+#define CH(x, y, z)     XOR(AND(x, XOR(y, z)), z)
+#define MAJ(x, y, z)    OR(AND(x, OR(y, z)), AND(y, z))
+
+/* Eight rows of eight words each into eight vectors of one word from each row, and back */
+#define TRANSPOSE8(r)   do { \
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]); \
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]); \
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]); \
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]); \
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2); \
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3); \
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6); \
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7); \
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20); \
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20); \
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20); \
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20); \
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31); \
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31); \
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31); \
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31); \
+} while (0)
+
+/* Smoosh4() of the byte at bit 8 * b */
+#define SMOOSH4(x, b)   AND(XOR(_mm256_srli_epi32(x, 8 * (b)), _mm256_srli_epi32(x, 8 * (b) + 4)), SET1(0xf))
+
+static inline __m256i smoosh2(__m256i x)
+{
+    x = XOR(x, _mm256_srli_epi32(x, 16));
+    x = XOR(x, _mm256_srli_epi32(x, 8));
+    x = XOR(x, _mm256_srli_epi32(x, 4));
+    x = XOR(x, _mm256_srli_epi32(x, 2));
+    return AND(x, SET1(3));
+}
+
+/* One diffusion step of Mangle(); rn holds the four rotation nibbles, r-th at bit 4 * r */
+static inline __m256i diffuse(__m256i c, __m256i R, int i, __m256i r, __m256i rn)
+{
+    __m256i n = ADD(AND(_mm256_srlv_epi32(rn, _mm256_slli_epi32(r, 2)), SET1(0xf)), SET1(i));
+    __m256i t = ROTRV(R, n);
+    __m256i is_add = _mm256_cmpeq_epi32(r, SET1(1));
+    __m256i is_and = _mm256_cmpeq_epi32(r, SET1(2));
+    __m256i is_xor = _mm256_cmpeq_epi32(AND(XOR(r, _mm256_srli_epi32(r, 1)), SET1(1)), _mm256_setzero_si256());
+
+    return OR(OR(AND(XOR(c, t), is_xor), AND(ADD(c, XOR(t, SET1(-1))), is_add)), AND(ANDNOT(t, c), is_and));
+}
+
+static inline void mangle(__m256i S[4])
+{
+    __m256i R = S[0];
+    __m256i r0 = SMOOSH4(R, 3);
+    __m256i rn = OR(OR(r0, _mm256_slli_epi32(SMOOSH4(R, 2), 4)),
+        OR(_mm256_slli_epi32(SMOOSH4(R, 1), 8), _mm256_slli_epi32(SMOOSH4(R, 0), 12)));
+    __m256i c0, c1, c2;
+
+    c0 = XOR(S[1], ROTRV(R, r0));
+    c1 = diffuse(S[2], R, 1, smoosh2(c0), rn);
+    c2 = diffuse(S[3], R, 2, smoosh2(XOR(c0, c1)), rn);
+    S[1] = c0;
+    S[2] = c1;
+    S[3] = c2;
+    S[0] = XOR(R, ADD(XOR(c0, c1), c2));
+}
+
+static inline void absorb(__m256i S[4], __m256i x)
+{
+    S[0] = XOR(S[0], x);
+    mangle(S);
+}
+
+static inline __m256i br(__m256i S[4], __m256i x)
+{
+    __m256i R = S[0];
+    __m256i y = _mm256_sllv_epi32(SET1(1), AND(_mm256_srli_epi32(R, 8), SET1(31)));
+    __m256i clear = _mm256_cmpeq_epi32(AND(R, SET1(1)), SET1(1));
+    __m256i set = _mm256_cmpeq_epi32(AND(R, SET1(2)), SET1(2));
+
+    mangle(S);
+    return XOR(x, AND(y, OR(AND(x, clear), ANDNOT(x, set))));
+}
+
+/*
+ * One block into each of eight states; state[i] is the eight chaining words
+ * of a state then its four sponge words.
+ */
+void hefty1_blocks_x8_avx2(uint32_t* const state[8], const unsigned char* const block[8])
+{
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i H[8], S[4], W[64];
+    __m256i A, B, C, D, E, F, G, Hh;
+    uint32_t sponge[4][8];
+    int i, t;
+
+    for (i = 0; i < 8; i++) {
+        W[i] = _mm256_loadu_si256((const __m256i*) block[i]);
+        W[i + 8] = _mm256_loadu_si256((const __m256i*) (block[i] + 32));
+        H[i] = _mm256_loadu_si256((const __m256i*) state[i]);
+    }
+    TRANSPOSE8(W);
+    TRANSPOSE8((W + 8));
+    TRANSPOSE8(H);
+    for (i = 0; i < 4; i++)
+        S[i] = _mm256_setr_epi32((int) state[0][8 + i], (int) state[1][8 + i], (int) state[2][8 + i],
+            (int) state[3][8 + i], (int) state[4][8 + i], (int) state[5][8 + i], (int) state[6][8 + i],
+            (int) state[7][8 + i]);
+
+    for (t = 0; t < 16; t++) {
+        W[t] = _mm256_shuffle_epi8(W[t], bswap);
+        absorb(S, XOR(W[t], SET1(hefty1_k[t])));
+    }
+    for (t = 16; t < 64; t++)
+        W[t] = ADD(ADD(SSG1(W[t - 2]), W[t - 7]), ADD(SSG0(W[t - 15]), W[t - 16]));
+
+    A = H[0]; B = H[1]; C = H[2]; D = H[3];
+    E = H[4]; F = H[5]; G = H[6]; Hh = H[7];
+
+    for (t = 0; t < 64; t++) {
+        __m256i brG, brF, brE, brC, brB, brA, tmp2, tmp4;
+
+        absorb(S, t < 16 ? XOR(D, Hh) : ADD(D, Hh));
+        brG = br(S, G);
+        brF = br(S, F);
+        tmp2 = ADD(ADD(CH(E, brF, brG), Hh), ADD(W[t], SET1(hefty1_k[t])));
+        brE = br(S, E);
+        tmp2 = ADD(tmp2, BSG1(brE));
+        brC = br(S, C);
+        brB = br(S, B);
+        brA = br(S, A);
+        tmp4 = MAJ(brA, brB, brC);
+        brA = br(S, A);
+        tmp4 = ADD(tmp4, BSG0(brA));
+        Hh = G;
+        G = F;
+        F = E;
+        E = ADD(D, br(S, tmp2));
+        D = C;
+        C = B;
+        B = A;
+        A = ADD(tmp2, tmp4);
+    }
+
+    H[0] = ADD(H[0], A); H[1] = ADD(H[1], B); H[2] = ADD(H[2], C); H[3] = ADD(H[3], D);
+    H[4] = ADD(H[4], E); H[5] = ADD(H[5], F); H[6] = ADD(H[6], G); H[7] = ADD(H[7], Hh);
+    TRANSPOSE8(H);
+    for (i = 0; i < 4; i++)
+        _mm256_storeu_si256((__m256i*) sponge[i], S[i]);
+    for (i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i*) state[i], H[i]);
+        for (t = 0; t < 4; t++)
+            state[i][8 + t] = sponge[t][i];
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
@@ -1,63 +1,607 @@
 #include "hefty1.h"
+#include <string.h>
 
-#include "sha3/sph_hefty1.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "compat.h"
+#include "cpu_features.h"
+#include "sha256_core.h"
 #include "sha3/sph_keccak.h"
 #include "sha3/sph_groestl.h"
 #include "sha3/sph_blake.h"
-#include "sha256.h"
+#include "sha3/keccakf1600.h"
 
-void hefty1_hash(const char* input, char* output, uint32_t len)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HEFTY1_AVX2 1
+/* hefty1-avx2.c */
+extern void hefty1_blocks_x8_avx2(uint32_t* const state[8], const unsigned char* const block[8]);
+#endif
+
+#define HEFTY1_LANES    8
+#define HEFTY1_BATCH    64
+#define KECCAK512_RATE  72
+
+/*
+ * HEFTY1 is SHA-256 with every input of every round first passed through
+ * Br(), which flips, sets or clears a bit chosen by a four word sponge that
+ * is stirred (Mangle) before each use: nine stirs a round.  sph_hefty1.c
+ * picks each operation with a switch on the data, which mispredicts about
+ * every other time; here every case is computed and the right one kept by
+ * masks, which is also what lets hefty1-avx2.c run eight headers in
+ * lockstep.
+ *
+ * A state is the eight chaining words, then the four sponge words.
+ */
+typedef struct {
+    uint32_t h[8];
+    uint32_t sponge[4];
+} hefty1_state;
+
+static const uint32_t hefty1_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t hefty1_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* Backend selection */
+
+static int s_avx2;
+
+static void select_backend(void)
+{
+#ifdef HEFTY1_AVX2
+    s_avx2 = cpu_has(CPU_FEATURE_AVX2);
+#endif
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    select_backend();
+    return TRUE;
+}
+#define BACKEND_INIT_ONCE()     InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()     pthread_once(&s_backend_once, select_backend)
+#endif
+
+/* The HEFTY1 core */
+
+static inline uint32_t rotr(uint32_t x, uint32_t n)
+{
+    return (x >> n) | (x << ((32 - n) & 31));
+}
+
+static inline uint32_t be32(const unsigned char* p)
+{
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+/* Smoosh4(): the two nibbles of the low byte folded into one */
+static inline uint32_t smoosh4(uint32_t x)
 {
-    HEFTY1_CTX              ctx_hefty1;
-    SHA256_CTX              ctx_sha256;
-    sph_keccak512_context   ctx_keccak;
-    sph_groestl512_context  ctx_groestl;
-    sph_blake512_context    ctx_blake;
-    
-    char hash32_1[32];
-    char hash32_2[32];
-    char hash64_3[64];
-    char hash64_4[64];
-    char hash64_5[64];
-    
-    HEFTY1_Init(&ctx_hefty1);
-    HEFTY1_Update(&ctx_hefty1, (const void*) input, len);
-    HEFTY1_Final((unsigned char*) &hash32_1, &ctx_hefty1); // 1
-    
-    SHA256_Init(&ctx_sha256);
-    SHA256_Update(&ctx_sha256, (const void*) input, len);
-    SHA256_Update(&ctx_sha256, (unsigned char*) &hash32_1, 32); // 1
-    SHA256_Final((unsigned char*) &hash32_2, &ctx_sha256); // 2
-    
-    sph_keccak512_init(&ctx_keccak);
-    sph_keccak512(&ctx_keccak, (const void*) input, len);
-    sph_keccak512(&ctx_keccak, (unsigned char*) &hash32_1, 32); //1
-    sph_keccak512_close(&ctx_keccak, (void*) &hash64_3); // 3
-    
-    sph_groestl512_init(&ctx_groestl);
-    sph_groestl512(&ctx_groestl, (const void*) input, len);
-    sph_groestl512(&ctx_groestl, (unsigned char*) &hash32_1, 32); // 1
-    sph_groestl512_close(&ctx_groestl, (void*) &hash64_4); // 4
-    
-    sph_blake512_init(&ctx_blake);
-    sph_blake512(&ctx_blake, (const void*) input, len);
-    sph_blake512(&ctx_blake, (unsigned char*) &hash32_1, 32); // 1
-    sph_blake512_close(&ctx_blake, (void*) &hash64_5); // 5
-    
-    memset(output, 0, 32);
-    
-    char* hash[4] = { hash32_2, hash64_3, hash64_4, hash64_5 };
-    
-    uint32_t i;
-    uint32_t j;
-    
-    #define OUTPUT_BIT (i * 4 + j)
-    
-    for(i = 0; i < 64; i++) {
-        for(j = 0; j < 4; j++) {
-            if((*(hash[j] + (i / 8)) & (0x80 >> (i % 8))) != 0)
-                *(output + (OUTPUT_BIT / 8)) |= 0x80 >> (OUTPUT_BIT % 8);
+    return (x ^ (x >> 4)) & 0xf;
+}
+
+/* Smoosh2(): the sixteen bit pairs of a word folded into one */
+static inline uint32_t smoosh2(uint32_t x)
+{
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    return x & 3;
+}
+
+/*
+ * One diffusion step of Mangle(): r = 0 and 3 XOR c with R, r = 1 adds and
+ * r = 2 ANDs ~R, rotated in every case by i plus the r-th nibble of R.
+ */
+static inline uint32_t diffuse(uint32_t c, uint32_t R, uint32_t i, uint32_t r, const uint32_t rn[4])
+{
+    uint32_t t = rotr(R, i + rn[r]);
+    uint32_t xor_mask = 0 - (uint32_t) (((r ^ (r >> 1)) & 1) == 0);
+    uint32_t add_mask = 0 - (uint32_t) (r == 1);
+    uint32_t and_mask = 0 - (uint32_t) (r == 2);
+
+    return ((c ^ t) & xor_mask) | ((c + ~t) & add_mask) | (c & ~t & and_mask);
+}
+
+static inline void mangle(uint32_t S[4])
+{
+    uint32_t R = S[0];
+    const uint32_t rn[4] = { smoosh4(R >> 24), smoosh4(R >> 16), smoosh4(R >> 8), smoosh4(R) };
+    uint32_t c0, c1, c2;
+
+    /* The first step always sees a zero accumulator, so always XORs */
+    c0 = S[1] ^ rotr(R, rn[0]);
+    c1 = diffuse(S[2], R, 1, smoosh2(c0), rn);
+    c2 = diffuse(S[3], R, 2, smoosh2(c0 ^ c1), rn);
+    S[1] = c0;
+    S[2] = c1;
+    S[3] = c2;
+    S[0] = R ^ ((c0 ^ c1) + c2);
+}
+
+static inline void absorb(uint32_t S[4], uint32_t x)
+{
+    S[0] ^= x;
+    mangle(S);
+}
+
+/* Br(): bit (R >> 8) % 32 of x left alone, cleared, set or flipped as R % 4 says */
+static inline uint32_t br(uint32_t S[4], uint32_t x)
+{
+    uint32_t R = S[0];
+    uint32_t y = (uint32_t) 1 << ((R >> 8) & 31);
+    uint32_t clear = 0 - (R & 1);
+    uint32_t set = 0 - ((R >> 1) & 1);
+
+    mangle(S);
+    return x ^ (y & ((x & clear) | (~x & set)));
+}
+
+#define BSG0(x)         (rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22))
+#define BSG1(x)         (rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25))
+#define SSG0(x)         (rotr(x, 7) ^ rotr(x, 18) ^ ((x) >> 3))
+#define SSG1(x)         (rotr(x, 17) ^ rotr(x, 19) ^ ((x) >> 10))
+#define CH(x, y, z)     (((x) & (y)) ^ (~(x) & (z)))
+#define MAJ(x, y, z)    (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+
+static void hefty1_block(hefty1_state* st, const unsigned char* block)
+{
+    uint32_t* S = st->sponge;
+    uint32_t W[64];
+    uint32_t A, B, C, D, E, F, G, H;
+    int t;
+
+    for (t = 0; t < 16; t++) {
+        W[t] = be32(block + 4 * t);
+        absorb(S, W[t] ^ hefty1_k[t]);
+    }
+    for (t = 16; t < 64; t++)
+        W[t] = SSG1(W[t - 2]) + W[t - 7] + SSG0(W[t - 15]) + W[t - 16];
+
+    A = st->h[0]; B = st->h[1]; C = st->h[2]; D = st->h[3];
+    E = st->h[4]; F = st->h[5]; G = st->h[6]; H = st->h[7];
+
+    /* The Br() calls in the order sph_hefty1.c's RoundFunc makes them */
+    for (t = 0; t < 64; t++) {
+        uint32_t brG, brF, brE, brC, brB, brA, tmp2, tmp4;
+
+        absorb(S, t < 16 ? D ^ H : D + H);
+        brG = br(S, G);
+        brF = br(S, F);
+        tmp2 = CH(E, brF, brG) + H + W[t] + hefty1_k[t];
+        brE = br(S, E);
+        tmp2 += BSG1(brE);
+        brC = br(S, C);
+        brB = br(S, B);
+        brA = br(S, A);
+        tmp4 = MAJ(brA, brB, brC);
+        brA = br(S, A);
+        tmp4 += BSG0(brA);
+        H = G;
+        G = F;
+        F = E;
+        E = D + br(S, tmp2);
+        D = C;
+        C = B;
+        B = A;
+        A = tmp2 + tmp4;
+    }
+
+    st->h[0] += A; st->h[1] += B; st->h[2] += C; st->h[3] += D;
+    st->h[4] += E; st->h[5] += F; st->h[6] += G; st->h[7] += H;
+}
+
+static void hefty1_init(hefty1_state* st)
+{
+    memcpy(st->h, hefty1_iv, sizeof st->h);
+    memset(st->sponge, 0, sizeof st->sponge);
+}
+
+/* The padded last block(s) of a total byte message whose last len (< 64) bytes are data */
+static int hefty1_pad(unsigned char block[128], const unsigned char* data, size_t len, uint64_t total)
+{
+    int blocks = len + 9 <= 64 ? 1 : 2;
+    uint64_t bits = total << 3;
+    int i;
+
+    memset(block, 0, 64 * blocks);
+    memcpy(block, data, len);
+    block[len] = 0x80;
+    for (i = 0; i < 8; i++)
+        block[64 * blocks - 1 - i] = (unsigned char) (bits >> (8 * i));
+    return blocks;
+}
+
+static void hefty1_output(const hefty1_state* st, unsigned char* digest)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        digest[4 * i + 0] = (unsigned char) (st->h[i] >> 24);
+        digest[4 * i + 1] = (unsigned char) (st->h[i] >> 16);
+        digest[4 * i + 2] = (unsigned char) (st->h[i] >> 8);
+        digest[4 * i + 3] = (unsigned char) st->h[i];
+    }
+}
+
+void hefty1_digest(const char* input, uint32_t len, unsigned char* digest)
+{
+    const unsigned char* in = (const unsigned char*) input;
+    unsigned char block[128];
+    hefty1_state st;
+    uint32_t done;
+    int i, blocks;
+
+    hefty1_init(&st);
+    for (done = 0; len - done >= 64; done += 64)
+        hefty1_block(&st, in + done);
+    blocks = hefty1_pad(block, in + done, len - done, len);
+    for (i = 0; i < blocks; i++)
+        hefty1_block(&st, block + 64 * i);
+    hefty1_output(&st, digest);
+}
+
+/*
+ * One block into each of n states, eight at a time on AVX2.  A short last
+ * group is filled up with scratch copies of its first lane.
+ */
+static void hefty1_blocks(hefty1_state* const* st, const unsigned char* const* block, uint32_t n)
+{
+    uint32_t i = 0;
+
+#ifdef HEFTY1_AVX2
+    if (s_avx2) {
+        hefty1_state spare[HEFTY1_LANES];
+        uint32_t* lanes[HEFTY1_LANES];
+        const unsigned char* blocks[HEFTY1_LANES];
+        uint32_t l;
+
+        for (; i < n; i += HEFTY1_LANES) {
+            for (l = 0; l < HEFTY1_LANES; l++) {
+                if (i + l < n) {
+                    lanes[l] = (uint32_t*) st[i + l];
+                    blocks[l] = block[i + l];
+                } else {
+                    spare[l] = *st[i];
+                    lanes[l] = (uint32_t*) &spare[l];
+                    blocks[l] = block[i];
+                }
+            }
+            hefty1_blocks_x8_avx2(lanes, blocks);
         }
     }
+#endif
+    for (; i < n; i++)
+        hefty1_block(st[i], block[i]);
+}
+
+/* Index of the header before i in the run that shares i's first 64 bytes, or i */
+static uint32_t prefix_run(const char* const* inputs, uint32_t i, uint32_t prev)
+{
+    if (prev < i && memcmp(inputs[prev], inputs[i], 64) == 0)
+        return prev;
+    return i;
+}
+
+/*
+ * HEFTY1 of up to HEFTY1_BATCH inputs.  An 80 byte header is its first
+ * block and a final block of the last 16 bytes and padding; the first block
+ * is compressed once per run of headers with the same 64 bytes.
+ */
+static void hefty1_digest_chunk(const char* const* inputs, const uint32_t* input_lens, uint32_t count,
+    unsigned char* const* digests)
+{
+    hefty1_state st[HEFTY1_BATCH];
+    hefty1_state* lanes[HEFTY1_BATCH];
+    const unsigned char* blocks[HEFTY1_BATCH];
+    unsigned char last[HEFTY1_BATCH][128];
+    uint32_t run[HEFTY1_BATCH];
+    uint32_t i, n = 0, prev = HEFTY1_BATCH;
+
+    for (i = 0; i < count; i++) {
+        if (input_lens[i] != HEFTY1_HEADER_SIZE)
+            continue;
+        run[i] = prev = prefix_run(inputs, i, prev);
+        if (run[i] == i) {
+            hefty1_init(&st[i]);
+            lanes[n] = &st[i];
+            blocks[n++] = (const unsigned char*) inputs[i];
+        }
+    }
+    hefty1_blocks(lanes, blocks, n);
+
+    for (i = 0, n = 0; i < count; i++) {
+        if (input_lens[i] != HEFTY1_HEADER_SIZE)
+            continue;
+        if (run[i] != i)
+            st[i] = st[run[i]];
+        hefty1_pad(last[i], (const unsigned char*) inputs[i] + 64, HEFTY1_HEADER_SIZE - 64, HEFTY1_HEADER_SIZE);
+        lanes[n] = &st[i];
+        blocks[n++] = last[i];
+    }
+    hefty1_blocks(lanes, blocks, n);
+
+    for (i = 0; i < count; i++) {
+        if (input_lens[i] == HEFTY1_HEADER_SIZE)
+            hefty1_output(&st[i], digests[i]);
+        else
+            hefty1_digest(inputs[i], input_lens[i], digests[i]);
+    }
 }
 
+void hefty1_digest_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count,
+    unsigned char* const* digests)
+{
+    uint32_t n;
+
+    BACKEND_INIT_ONCE();
+    for (; count; count -= n, inputs += n, input_lens += n, digests += n) {
+        n = count < HEFTY1_BATCH ? count : HEFTY1_BATCH;
+        hefty1_digest_chunk(inputs, input_lens, n, digests);
+    }
+}
+
+/* The four hashes of input || HEFTY1(input) */
+
+typedef struct {
+    unsigned char sha256[32];
+    unsigned char keccak[64];
+    unsigned char groestl[64];
+    unsigned char blake[64];
+} hefty1_tails;
+
+typedef void (*hefty1_combine_fn)(const hefty1_tails* t, char* output);
+
+/* SHA-256 of the message whose first done bytes are in state, then the rest of input and the digest */
+static void tail_sha256(const uint32_t state[8], uint32_t done, const char* input, uint32_t len,
+    const unsigned char* digest, unsigned char* out)
+{
+    unsigned char rest[64 + 32];
+
+    memcpy(rest, input + done, len - done);
+    memcpy(rest + len - done, digest, 32);
+    sha256_core_final(state, done, rest, len - done + 32, out);
+}
+
+static void tails_one(const char* input, uint32_t len, const unsigned char* digest, hefty1_tails* t)
+{
+    sph_keccak512_context keccak;
+    sph_groestl512_context groestl;
+    sph_blake512_context blake;
+    uint32_t state[8];
+    uint32_t done = len & ~63u;
+
+    sha256_core_init(state);
+    sha256_core_blocks(state, input, done / 64);
+    tail_sha256(state, done, input, len, digest, t->sha256);
+
+    sph_keccak512_init(&keccak);
+    sph_keccak512(&keccak, input, len);
+    sph_keccak512(&keccak, digest, 32);
+    sph_keccak512_close(&keccak, t->keccak);
+
+    sph_groestl512_init(&groestl);
+    sph_groestl512(&groestl, input, len);
+    sph_groestl512(&groestl, digest, 32);
+    sph_groestl512_close(&groestl, t->groestl);
+
+    sph_blake512_init(&blake);
+    sph_blake512(&blake, input, len);
+    sph_blake512(&blake, digest, 32);
+    sph_blake512_close(&blake, t->blake);
+}
+
+/* Keccak-512 of four messages of len bytes through one 4-lane permutation per block */
+static void keccak512_x4(const unsigned char* const msg[4], size_t len, unsigned char* const out[4])
+{
+    uint64_t _ALIGN(32) st[100];
+    unsigned char block[KECCAK512_RATE];
+    size_t done = 0;
+    int i, j;
+
+    memset(st, 0, sizeof st);
+    for (;;) {
+        size_t n = len - done < KECCAK512_RATE ? len - done : KECCAK512_RATE;
+        int last = n < KECCAK512_RATE;
+
+        for (j = 0; j < 4; j++) {
+            memcpy(block, msg[j] + done, n);
+            if (last) {
+                memset(block + n, 0, KECCAK512_RATE - n);
+                block[n] |= 0x01;
+                block[KECCAK512_RATE - 1] |= 0x80;
+            }
+            for (i = 0; i < KECCAK512_RATE / 8; i++) {
+                uint64_t w;
+
+                memcpy(&w, block + 8 * i, 8);
+                st[4 * i + j] ^= w;
+            }
+        }
+        keccakf1600_x4(st);
+        if (last)
+            break;
+        done += n;
+    }
+
+    for (j = 0; j < 4; j++)
+        for (i = 0; i < 8; i++)
+            memcpy(out[j] + 8 * i, &st[4 * i + j], 8);
+}
+
+/*
+ * The tails of up to HEFTY1_BATCH inputs and their digests.  For 80 byte
+ * headers SHA-256 starts from a midstate of each run of equal first 64
+ * bytes, and Keccak-512 runs four messages at a time.
+ */
+static void tails_chunk(const char* const* inputs, const uint32_t* input_lens, uint32_t count,
+    unsigned char (*digests)[32], hefty1_tails* t)
+{
+    unsigned char msg[HEFTY1_BATCH][HEFTY1_HEADER_SIZE + 32];
+    const unsigned char* group[4];
+    unsigned char* out[4];
+    uint32_t mid[8];
+    uint32_t i, n = 0, prev = HEFTY1_BATCH;
+
+    for (i = 0; i < count; i++) {
+        sph_groestl512_context groestl;
+        sph_blake512_context blake;
+
+        if (input_lens[i] != HEFTY1_HEADER_SIZE) {
+            tails_one(inputs[i], input_lens[i], digests[i], &t[i]);
+            continue;
+        }
+
+        if (prefix_run(inputs, i, prev) == i) {
+            sha256_core_init(mid);
+            sha256_core_blocks(mid, inputs[i], 1);
+        }
+        prev = i;
+        tail_sha256(mid, 64, inputs[i], HEFTY1_HEADER_SIZE, digests[i], t[i].sha256);
+
+        memcpy(msg[i], inputs[i], HEFTY1_HEADER_SIZE);
+        memcpy(msg[i] + HEFTY1_HEADER_SIZE, digests[i], 32);
+
+        sph_groestl512_init(&groestl);
+        sph_groestl512(&groestl, msg[i], sizeof msg[i]);
+        sph_groestl512_close(&groestl, t[i].groestl);
+
+        sph_blake512_init(&blake);
+        sph_blake512(&blake, msg[i], sizeof msg[i]);
+        sph_blake512_close(&blake, t[i].blake);
+
+        group[n] = msg[i];
+        out[n] = t[i].keccak;
+        if (++n == 4) {
+            keccak512_x4(group, sizeof msg[i], out);
+            n = 0;
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        sph_keccak512_context keccak;
+
+        sph_keccak512_init(&keccak);
+        sph_keccak512(&keccak, group[i], HEFTY1_HEADER_SIZE + 32);
+        sph_keccak512_close(&keccak, out[i]);
+    }
+}
+
+/* Bits 7..0 of a byte moved to bits 28, 24, ..., 0 */
+static uint32_t spread4(uint32_t b)
+{
+    b = (b | (b << 12)) & 0x000F000F;
+    b = (b | (b << 6)) & 0x03030303;
+    b = (b | (b << 3)) & 0x11111111;
+    return b;
+}
+
+/* Four bytes interleaved bit by bit from the top, a's bit first */
+static uint32_t interleave4(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+    return (spread4(a) << 3) | (spread4(b) << 2) | (spread4(c) << 1) | spread4(d);
+}
+
+/* hefty1: bytes 0..7 of each hash, bit by bit from the top of byte 0, written big endian */
+static void hefty1_combine(const hefty1_tails* t, char* output)
+{
+    int k;
+
+    for (k = 0; k < 8; k++) {
+        uint32_t w = interleave4(t->sha256[k], t->keccak[k], t->groestl[k], t->blake[k]);
+
+        output[4 * k + 0] = (char) (w >> 24);
+        output[4 * k + 1] = (char) (w >> 16);
+        output[4 * k + 2] = (char) (w >> 8);
+        output[4 * k + 3] = (char) w;
+    }
+}
+
+/*
+ * heavy: the top 64 bits of each hash read as a little endian number,
+ * bytes 31 down to 24, into the output from its top word down.
+ */
+static void heavy_combine(const hefty1_tails* t, char* output)
+{
+    int q;
+
+    for (q = 0; q < 8; q++) {
+        int b = 31 - q;
+        uint32_t w = interleave4(t->sha256[b], t->keccak[b], t->groestl[b], t->blake[b]);
+        char* out = output + 4 * (7 - q);
+
+        out[0] = (char) w;
+        out[1] = (char) (w >> 8);
+        out[2] = (char) (w >> 16);
+        out[3] = (char) (w >> 24);
+    }
+}
+
+static void hefty1_family_hash(hefty1_combine_fn combine, const char* input, char* output, uint32_t len)
+{
+    unsigned char digest[32];
+    hefty1_tails t;
+
+    hefty1_digest(input, len, digest);
+    tails_one(input, len, digest, &t);
+    combine(&t, output);
+}
+
+static void hefty1_family_batch(hefty1_combine_fn combine, const char* const* inputs, const uint32_t* input_lens,
+    uint32_t count, char* const* outputs)
+{
+    unsigned char digests[HEFTY1_BATCH][32];
+    unsigned char* dp[HEFTY1_BATCH];
+    hefty1_tails t[HEFTY1_BATCH];
+    uint32_t i, n;
+
+    BACKEND_INIT_ONCE();
+    for (i = 0; i < HEFTY1_BATCH; i++)
+        dp[i] = digests[i];
+    for (; count; count -= n, inputs += n, input_lens += n, outputs += n) {
+        n = count < HEFTY1_BATCH ? count : HEFTY1_BATCH;
+        hefty1_digest_chunk(inputs, input_lens, n, dp);
+        tails_chunk(inputs, input_lens, n, digests, t);
+        for (i = 0; i < n; i++)
+            combine(&t[i], outputs[i]);
+    }
+}
+
+void hefty1_hash(const char* input, char* output, uint32_t len)
+{
+    hefty1_family_hash(hefty1_combine, input, output, len);
+}
+
+void hefty1_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    hefty1_family_batch(hefty1_combine, inputs, input_lens, count, outputs);
+}
+
+void heavy_hash(const char* input, char* output, uint32_t len)
+{
+    hefty1_family_hash(heavy_combine, input, output, len);
+}
+
+void heavy_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    hefty1_family_batch(heavy_combine, inputs, input_lens, count, outputs);
+}
@@ -7,7 +7,27 @@ extern "C" {
 
 #include <stdint.h>
 
+#define HEFTY1_HEADER_SIZE 80
+
+/*
+ * HEFTY1 alone, the 32 byte digest the Heavycoin family starts from.  The
+ * batch runs 80 byte headers eight at a time on AVX2 and compresses the
+ * first block once for headers that share their first 64 bytes.
+ */
+void hefty1_digest(const char* input, uint32_t len, unsigned char* digest);
+void hefty1_digest_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count,
+    unsigned char* const* digests);
+
+/*
+ * SHA-256, Keccak-512, Groestl-512 and BLAKE-512 of input || HEFTY1(input),
+ * their leading 64 bits interleaved bit by bit.  hefty1 takes the first 8
+ * bytes of each; heavy (Heavycoin) the top 64 bits of each as a 256 bit
+ * little endian number, as algo/heavy/heavy.c does.
+ */
 void hefty1_hash(const char* input, char* output, uint32_t len);
+void hefty1_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+void heavy_hash(const char* input, char* output, uint32_t len);
+void heavy_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,67 @@
+#include "hmq1725.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "chain.h"
+#include "sha3/sph_bmw.h"
+
+/* Branches test these bits of the first word, as in algo/hmq1725.c */
+#define HMQ1725_MASK    24
+
+static void hmq1725_chunk(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    sph_bmw512_context ctx_bmw;
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        sph_bmw512_init(&ctx_bmw);
+        sph_bmw512(&ctx_bmw, inputs[i], input_lens[i]);
+        sph_bmw512_close(&ctx_bmw, hashes[i]);
+    }
+
+    chain_run(&chain_whirlpool, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_groestl512, &chain_skein512, hashes, count);
+    chain_run(&chain_jh512, hashes, count);
+    chain_run(&chain_keccak512, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_blake512, &chain_bmw512, hashes, count);
+    chain_run(&chain_luffa512, hashes, count);
+    chain_run(&chain_cubehash512, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_keccak512, &chain_jh512, hashes, count);
+    chain_run(&chain_shavite512, hashes, count);
+    chain_run(&chain_simd512, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_whirlpool, &chain_haval256_5, hashes, count);
+    chain_run(&chain_echo512, hashes, count);
+    chain_run(&chain_blake512, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_shavite512, &chain_luffa512, hashes, count);
+    chain_run(&chain_hamsi512, hashes, count);
+    chain_run(&chain_fugue512, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_echo512, &chain_simd512, hashes, count);
+    chain_run(&chain_shabal512, hashes, count);
+    chain_run(&chain_whirlpool, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_fugue512, &chain_sha512, hashes, count);
+    chain_run(&chain_groestl512, hashes, count);
+    chain_run(&chain_sha512, hashes, count);
+    chain_branch(HMQ1725_MASK, &chain_haval256_5, &chain_whirlpool, hashes, count);
+    chain_run(&chain_bmw512, hashes, count);
+
+    for (i = 0; i < count; i++)
+        memcpy(outputs[i], hashes[i], 32);
+}
+
+void hmq1725_hash(const char* input, char* output, uint32_t len)
+{
+    hmq1725_chunk(&input, &len, 1, &output);
+}
+
+void hmq1725_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint32_t i, n;
+
+    for (i = 0; i < count; i += n) {
+        n = count - i < CHAIN_BATCH_MAX ? count - i : CHAIN_BATCH_MAX;
+        hmq1725_chunk(inputs + i, input_lens + i, n, outputs + i);
+    }
+}
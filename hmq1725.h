@@ -0,0 +1,22 @@
+#ifndef HMQ1725_H
+#define HMQ1725_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+void hmq1725_hash(const char* input, char* output, uint32_t len);
+
+/*
+ * Hashes count inputs stage by stage, regrouping the hashes by the branch
+ * they take at each of the eight data dependent steps.
+ */
+void hmq1725_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
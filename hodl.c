@@ -0,0 +1,321 @@
+#include "hodl.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "compat.h"
+#include "cpu_features.h"
+
+/* Same layout as algo/hodl/hodl-wolf.h */
+#define AES_ITERATIONS      15
+#define GARBAGE_SIZE        (1 << 30)
+#define GARBAGE_CHUNK_SIZE  (1 << 6)
+#define GARBAGE_SLICE_SIZE  (1 << 12)
+#define TOTAL_CHUNKS        (1 << 24)
+#define COMPARE_SIZE        (1 << 18)
+
+/* A share's collision is the slice value that ends below this */
+#define HODL_SOLUTION_LIMIT 1000
+
+/* Builder threads, a power of two so the chunks split evenly */
+#define HODL_MAX_BUILDERS   64
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HODL_AVX2 1
+/* algo/hodl/sha512-avx2-dispatch.c */
+extern void hodl_sha512_x8_avx2(uint64_t* data[8], uint64_t* digest[8]);
+#endif
+
+typedef union {
+    uint32_t dwords[GARBAGE_SLICE_SIZE >> 2];
+    uint8_t bytes[GARBAGE_SLICE_SIZE];
+} hodl_slice;
+
+/*
+ * The garbage of the prepared template.  Validation holds the lock shared
+ * and gives up rather than wait while hodl_prepare() holds it exclusive for
+ * a rebuild.
+ */
+static uint8_t* s_garbage;
+static uint8_t s_midhash[32];
+static int s_valid;
+#ifdef _WIN32
+static SRWLOCK s_lock = SRWLOCK_INIT;
+#define TRY_LOCK_SHARED()   (TryAcquireSRWLockShared(&s_lock) != 0)
+#define UNLOCK_SHARED()     ReleaseSRWLockShared(&s_lock)
+#define LOCK_EXCLUSIVE()    AcquireSRWLockExclusive(&s_lock)
+#define UNLOCK_EXCLUSIVE()  ReleaseSRWLockExclusive(&s_lock)
+#else
+static pthread_rwlock_t s_lock = PTHREAD_RWLOCK_INITIALIZER;
+#define TRY_LOCK_SHARED()   (pthread_rwlock_tryrdlock(&s_lock) == 0)
+#define UNLOCK_SHARED()     pthread_rwlock_unlock(&s_lock)
+#define LOCK_EXCLUSIVE()    pthread_rwlock_wrlock(&s_lock)
+#define UNLOCK_EXCLUSIVE()  pthread_rwlock_unlock(&s_lock)
+#endif
+
+/*
+ * One mapping for the life of the process, on huge pages where the system
+ * has them: the AES walk lands on a random 4 KiB slice of the whole GiB,
+ * which would otherwise miss the TLB on nearly every lookup.
+ */
+static uint8_t* garbage_map(void)
+{
+#ifdef _WIN32
+    SIZE_T large = GetLargePageMinimum();
+    void* p = NULL;
+
+    if (large && (GARBAGE_SIZE % large) == 0)
+        p = VirtualAlloc(NULL, GARBAGE_SIZE, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    if (!p)
+        p = VirtualAlloc(NULL, GARBAGE_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    return (uint8_t*) p;
+#else
+    void* p = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    p = mmap(NULL, GARBAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (p == MAP_FAILED) {
+        p = mmap(NULL, GARBAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            return NULL;
+#ifdef MADV_HUGEPAGE
+        madvise(p, GARBAGE_SIZE, MADV_HUGEPAGE);
+#endif
+    }
+    return (uint8_t*) p;
+#endif
+}
+
+static void sha256d(uint8_t* hash, const uint8_t* data, size_t len)
+{
+    SHA256(data, len, hash);
+    SHA256(hash, 32, hash);
+}
+
+typedef struct {
+    uint32_t id;
+    uint32_t count;
+    int avx2;
+} garbage_builder;
+
+/* GenerateGarbageCore(): chunk i is the SHA-512 of the midhash with its first word set to i. */
+static void garbage_build_slice(uint32_t id, uint32_t count, int avx2)
+{
+    uint32_t start = id * (TOTAL_CHUNKS / count);
+    uint32_t end = start + TOTAL_CHUNKS / count;
+    uint32_t i = start;
+
+#ifdef HODL_AVX2
+    if (avx2) {
+        uint64_t _ALIGN(32) bufs[8][4];
+        uint64_t* data[8];
+        uint64_t* digest[8];
+        int j;
+
+        for (j = 0; j < 8; j++) {
+            memcpy(bufs[j], s_midhash, 32);
+            data[j] = bufs[j];
+        }
+        for (; i < end; i += 8) {
+            for (j = 0; j < 8; j++) {
+                uint32_t word = i + j;
+                memcpy(bufs[j], &word, 4);
+                digest[j] = (uint64_t*) (s_garbage + (size_t) (i + j) * GARBAGE_CHUNK_SIZE);
+            }
+            hodl_sha512_x8_avx2(data, digest);
+        }
+    }
+#endif
+    {
+        uint32_t buf[8];
+
+        memcpy(buf, s_midhash, 32);
+        for (; i < end; i++) {
+            buf[0] = i;
+            SHA512((const uint8_t*) buf, 32, s_garbage + (size_t) i * GARBAGE_CHUNK_SIZE);
+        }
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI garbage_builder_main(LPVOID arg)
+#else
+static void* garbage_builder_main(void* arg)
+#endif
+{
+    garbage_builder* b = (garbage_builder*) arg;
+    garbage_build_slice(b->id, b->count, b->avx2);
+    return 0;
+}
+
+static uint32_t builder_count(void)
+{
+    uint32_t count = 1;
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    long cpus;
+
+    GetSystemInfo(&si);
+    cpus = (long) si.dwNumberOfProcessors;
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    while (count * 2 <= (uint32_t) cpus && count * 2 <= HODL_MAX_BUILDERS)
+        count *= 2;
+    return count;
+}
+
+/*
+ * Fills the garbage for s_midhash, every core building its own slice of the
+ * chunks.  Slices whose thread could not be started are built here.
+ */
+static void garbage_build(void)
+{
+    garbage_builder builders[HODL_MAX_BUILDERS];
+#ifdef _WIN32
+    HANDLE threads[HODL_MAX_BUILDERS];
+#else
+    pthread_t threads[HODL_MAX_BUILDERS];
+#endif
+    int started[HODL_MAX_BUILDERS];
+    uint32_t count = builder_count();
+    int avx2 = cpu_has(CPU_FEATURE_AVX2);
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        builders[i].id = i;
+        builders[i].count = count;
+        builders[i].avx2 = avx2;
+        started[i] = 0;
+        if (i == 0)
+            continue;
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, garbage_builder_main, &builders[i], 0, NULL);
+        started[i] = threads[i] != NULL;
+#else
+        started[i] = pthread_create(&threads[i], NULL, garbage_builder_main, &builders[i]) == 0;
+#endif
+    }
+
+    for (i = 0; i < count; i++) {
+        if (!started[i])
+            garbage_build_slice(i, count, avx2);
+    }
+
+    for (i = 1; i < count; i++) {
+        if (!started[i])
+            continue;
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+}
+
+int hodl_prepare(const char* header, char* output)
+{
+    uint8_t midhash[32];
+    int ret = 0;
+
+    sha256d(midhash, (const uint8_t*) header, HODL_TEMPLATE_SIZE);
+    LOCK_EXCLUSIVE();
+    if (!s_garbage)
+        s_garbage = garbage_map();
+    if (!s_garbage)
+        ret = -1;
+    else if (!s_valid || memcmp(s_midhash, midhash, 32) != 0) {
+        memcpy(s_midhash, midhash, 32);
+        garbage_build();
+        s_valid = 1;
+    }
+    UNLOCK_EXCLUSIVE();
+
+    if (!ret)
+        memcpy(output, midhash, 32);
+    return ret;
+}
+
+static uint32_t le32(const uint8_t* p)
+{
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+/*
+ * The scanhash_hodl_wolf() walk from one start slice: 15 rounds of XORing
+ * in the slice the last word points at and AES-256-CBC encrypting the
+ * result, keyed by its last 32 bytes with its last 16 as IV.  OpenSSL picks
+ * AES-NI by itself where the CPU has it.
+ */
+static int garbage_walk(uint32_t start, hodl_slice* cache)
+{
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    hodl_slice tmp;
+    int j, i, len;
+
+    if (!ctx)
+        return -1;
+
+    memcpy(cache->bytes, s_garbage + (size_t) start * GARBAGE_SLICE_SIZE, GARBAGE_SLICE_SIZE);
+    for (j = 0; j < AES_ITERATIONS; j++) {
+        uint32_t next = cache->dwords[(GARBAGE_SLICE_SIZE >> 2) - 1] & (COMPARE_SIZE - 1);
+        const uint32_t* src = (const uint32_t*) (s_garbage + (size_t) next * GARBAGE_SLICE_SIZE);
+
+        for (i = 0; i < (GARBAGE_SLICE_SIZE >> 2); i++)
+            tmp.dwords[i] = cache->dwords[i] ^ src[i];
+
+        if (!EVP_EncryptInit_ex(ctx, j ? NULL : EVP_aes_256_cbc(), NULL,
+                                tmp.bytes + GARBAGE_SLICE_SIZE - 32, tmp.bytes + GARBAGE_SLICE_SIZE - 16) ||
+            !EVP_CIPHER_CTX_set_padding(ctx, 0) ||
+            !EVP_EncryptUpdate(ctx, cache->bytes, &len, tmp.bytes, GARBAGE_SLICE_SIZE)) {
+            EVP_CIPHER_CTX_free(ctx);
+            return -1;
+        }
+    }
+    EVP_CIPHER_CTX_free(ctx);
+    return 0;
+}
+
+int hodl_hash(const char* input, char* output)
+{
+    const uint8_t* header = (const uint8_t*) input;
+    uint32_t start = le32(header + 80);
+    uint32_t final = le32(header + 84);
+    uint8_t midhash[32];
+    hodl_slice cache;
+    int err;
+
+    if (start >= COMPARE_SIZE)
+        return 0;
+
+    sha256d(midhash, header, HODL_TEMPLATE_SIZE);
+    if (!TRY_LOCK_SHARED())
+        return -1;
+    if (!s_valid || memcmp(s_midhash, midhash, 32) != 0) {
+        UNLOCK_SHARED();
+        return -1;
+    }
+    err = garbage_walk(start, &cache);
+    UNLOCK_SHARED();
+    if (err)
+        return -2;
+
+    if ((cache.dwords[(GARBAGE_SLICE_SIZE >> 2) - 1] & (COMPARE_SIZE - 1)) >= HODL_SOLUTION_LIMIT ||
+        cache.dwords[(GARBAGE_SLICE_SIZE >> 2) - 2] != final)
+        return 0;
+
+    sha256d((uint8_t*) output, header, HODL_HEADER_SIZE);
+    return 1;
+}
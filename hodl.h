@@ -0,0 +1,41 @@
+#ifndef HODL_H
+#define HODL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define HODL_HEADER_SIZE    88
+/* The block header part, all the template hash covers */
+#define HODL_TEMPLATE_SIZE  80
+
+/*
+ * HODL validates a share against 1 GiB of SHA-512 garbage derived from the
+ * block template (the sha256d of the first 80 header bytes).  The process
+ * keeps one garbage buffer, shared by every thread, built for one template
+ * at a time by hodl_prepare().
+ *
+ * hodl_prepare() builds the garbage for an 80 byte header on all cores,
+ * which takes seconds, so it belongs off any latency sensitive thread.  It
+ * writes the 32 byte template hash and returns 0, or -1 when the buffer
+ * could not be allocated.
+ */
+int hodl_prepare(const char* header, char* output);
+
+/*
+ * input is the 88 byte header: the 80 byte block header followed by
+ * nStartLocation and nFinalCalculation.  Returns 1 and writes the sha256d
+ * of the header when the AES collision checks out, 0 when it does not, -1
+ * when the garbage in place is not that of the header's template (or is
+ * being rebuilt), and -2 when the cipher context could not be allocated.
+ * It never builds the garbage itself.
+ */
+int hodl_hash(const char* input, char* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
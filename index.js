@@ -1 +1,43 @@
-module.exports = require('bindings')('multihashing.node')
\ No newline at end of file
+var stream = require('stream');
+var util = require('util');
+
+var multihashing = module.exports = require('bindings')('multihashing.node');
+
+multihashing.createHasher = function(algorithm) {
+    return new multihashing.Hasher(algorithm);
+};
+
+// SHA-256 state after the first 64 bytes of a job's header, for sha256d/sha256t
+multihashing.sha256Midstate = function(header) {
+    return new multihashing.Sha256Midstate(header);
+};
+
+// Skein-512 state after the first 64 bytes of a job's header, for veltor
+multihashing.veltorMidstate = function(header) {
+    return new multihashing.VeltorMidstate(header);
+};
+
+// Transform stream that hashes everything written to it and emits the digest
+// as its only chunk once the input ends.
+function HashStream(algorithm, options) {
+    if (!(this instanceof HashStream))
+        return new HashStream(algorithm, options);
+    stream.Transform.call(this, options);
+    this._hasher = new multihashing.Hasher(algorithm);
+}
+util.inherits(HashStream, stream.Transform);
+
+HashStream.prototype._transform = function(chunk, encoding, callback) {
+    this._hasher.update(chunk);
+    callback();
+};
+
+HashStream.prototype._flush = function(callback) {
+    this.push(this._hasher.digest());
+    callback();
+};
+
+multihashing.HashStream = HashStream;
+multihashing.createHashStream = function(algorithm, options) {
+    return new HashStream(algorithm, options);
+};
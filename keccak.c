@@ -1,7 +1,11 @@
 #include "keccak.h"
 
+#include <string.h>
+
+#include "common.h"
 #include "sha3/sph_types.h"
 #include "sha3/sph_keccak.h"
+#include "sha3/keccakf1600.h"
 
 
 void keccak_hash(const char* input, char* output, uint32_t size)
@@ -12,3 +16,70 @@ void keccak_hash(const char* input, char* output, uint32_t size)
     sph_keccak256_close(&ctx_keccak, output);
 }
 
+#define KECCAK256_RATE 136
+
+/* absorb one rate-sized block of each of the four inputs */
+static void keccak256_x4_absorb(uint64_t* st, const char* const block[4])
+{
+    uint64_t w;
+    int i, j;
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < KECCAK256_RATE / 8; i++) {
+            memcpy(&w, block[j] + 8 * i, 8);
+            st[4 * i + j] ^= w;
+        }
+    }
+}
+
+/* Four same-length inputs through one interleaved state. */
+static void keccak_hash_x4(const char* const input[4], char* const output[4], uint32_t size)
+{
+    uint64_t _ALIGN(32) st[100];
+    char pad[4][KECCAK256_RATE];
+    const char* block[4];
+    uint32_t offset = 0;
+    uint32_t rem;
+    int i, j;
+
+    memset(st, 0, sizeof(st));
+
+    for (; size - offset >= KECCAK256_RATE; offset += KECCAK256_RATE) {
+        for (j = 0; j < 4; j++)
+            block[j] = input[j] + offset;
+        keccak256_x4_absorb(st, block);
+        keccakf1600_x4(st);
+    }
+
+    /* original Keccak padding, as sph_keccak256 uses */
+    rem = size - offset;
+    for (j = 0; j < 4; j++) {
+        memcpy(pad[j], input[j] + offset, rem);
+        memset(pad[j] + rem, 0, KECCAK256_RATE - rem);
+        pad[j][rem] = 0x01;
+        pad[j][KECCAK256_RATE - 1] |= 0x80;
+        block[j] = pad[j];
+    }
+    keccak256_x4_absorb(st, block);
+    keccakf1600_x4(st);
+
+    for (j = 0; j < 4; j++)
+        for (i = 0; i < 4; i++)
+            memcpy(output[j] + 8 * i, &st[4 * i + j], 8);
+}
+
+void keccak_hash_batch(const char* const* inputs, const uint32_t* sizes, char* const* outputs, uint32_t count)
+{
+    uint32_t i = 0;
+
+    while (i < count) {
+        if (i + 4 <= count && sizes[i + 1] == sizes[i] && sizes[i + 2] == sizes[i] && sizes[i + 3] == sizes[i]) {
+            keccak_hash_x4(inputs + i, outputs + i, sizes[i]);
+            i += 4;
+        }
+        else {
+            keccak_hash(inputs[i], outputs[i], sizes[i]);
+            i++;
+        }
+    }
+}
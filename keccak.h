@@ -9,6 +9,13 @@ extern "C" {
 
 void keccak_hash(const char* input, char* output, uint32_t size);
 
+/*
+ * Hashes count inputs.  Runs of four inputs of equal size share one 4-lane
+ * permutation, so batches of same-length headers hash in a quarter of the
+ * permutations when AVX2 is available.
+ */
+void keccak_hash_batch(const char* const* inputs, const uint32_t* sizes, char* const* outputs, uint32_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,220 @@
+#include "lbry.h"
+#include <stdint.h>
+#include <string.h>
+#include <openssl/sha.h>
+
+#include "compat.h"
+#include "sha256_core.h"
+
+/* Same layout as algo/lbry.c, whose nonce is word 27 */
+#define LBRY_MIDSTATE_LEN   64
+
+typedef struct {
+    int has_midstate;
+    unsigned char prefix[LBRY_MIDSTATE_LEN];
+    uint32_t state[8];
+} lbry_state;
+
+static __thread lbry_state s_state;
+
+static uint32_t le32dec(const uint8_t* p)
+{
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void le32enc(uint8_t* p, uint32_t x)
+{
+    p[0] = (uint8_t) x;
+    p[1] = (uint8_t) (x >> 8);
+    p[2] = (uint8_t) (x >> 16);
+    p[3] = (uint8_t) (x >> 24);
+}
+
+/* RIPEMD-160, as in algo/ripemd/sph_ripemd.c */
+#define ROTL32(x, n)    (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define F1(x, y, z)     ((x) ^ (y) ^ (z))
+#define F2(x, y, z)     ((((y) ^ (z)) & (x)) ^ (z))
+#define F3(x, y, z)     (((x) | ~(y)) ^ (z))
+#define F4(x, y, z)     ((((x) ^ (y)) & (z)) ^ (y))
+#define F5(x, y, z)     ((x) ^ ((y) | ~(z)))
+
+#define KL0     0x00000000
+#define KL1     0x5A827999
+#define KL2     0x6ED9EBA1
+#define KL3     0x8F1BBCDC
+#define KL4     0xA953FD4E
+#define KR0     0x50A28BE6
+#define KR1     0x5C4DD124
+#define KR2     0x6D703EF3
+#define KR3     0x7A6D76E9
+#define KR4     0x00000000
+
+/* One step of a line for both messages; the working words rotate by name. */
+#define RMD2(f, a, b, c, d, e, x, s, k) do { \
+        a##0 = ROTL32(a##0 + f(b##0, c##0, d##0) + X0[x] + (k), s) + e##0; \
+        a##1 = ROTL32(a##1 + f(b##1, c##1, d##1) + X1[x] + (k), s) + e##1; \
+        c##0 = ROTL32(c##0, 10); \
+        c##1 = ROTL32(c##1, 10); \
+    } while (0)
+
+/*
+ * RIPEMD-160 of two 32 byte messages at once.  Both are a single padded
+ * block, and the two lines of both messages are independent chains, so
+ * stepping all four together keeps the pipeline full where one digest
+ * after the other would wait on each rotate.
+ */
+static void ripemd160_x2(const uint8_t* in0, const uint8_t* in1, uint8_t* out0, uint8_t* out1)
+{
+    static const uint32_t iv[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    uint32_t X0[16], X1[16];
+    uint32_t AL0, BL0, CL0, DL0, EL0, AR0, BR0, CR0, DR0, ER0;
+    uint32_t AL1, BL1, CL1, DL1, EL1, AR1, BR1, CR1, DR1, ER1;
+    uint32_t t;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        X0[i] = le32dec(in0 + 4 * i);
+        X1[i] = le32dec(in1 + 4 * i);
+    }
+    /* 0x80 after the message, its 256 bit length in word 14 */
+    X0[8] = X1[8] = 0x80;
+    for (i = 9; i < 16; i++)
+        X0[i] = X1[i] = 0;
+    X0[14] = X1[14] = 256;
+
+    AL0 = AR0 = AL1 = AR1 = iv[0];
+    BL0 = BR0 = BL1 = BR1 = iv[1];
+    CL0 = CR0 = CL1 = CR1 = iv[2];
+    DL0 = DR0 = DL1 = DR1 = iv[3];
+    EL0 = ER0 = EL1 = ER1 = iv[4];
+
+    RMD2(F1, AL, BL, CL, DL, EL,  0, 11, KL0); RMD2(F5, AR, BR, CR, DR, ER,  5,  8, KR0);
+    RMD2(F1, EL, AL, BL, CL, DL,  1, 14, KL0); RMD2(F5, ER, AR, BR, CR, DR, 14,  9, KR0);
+    RMD2(F1, DL, EL, AL, BL, CL,  2, 15, KL0); RMD2(F5, DR, ER, AR, BR, CR,  7,  9, KR0);
+    RMD2(F1, CL, DL, EL, AL, BL,  3, 12, KL0); RMD2(F5, CR, DR, ER, AR, BR,  0, 11, KR0);
+    RMD2(F1, BL, CL, DL, EL, AL,  4,  5, KL0); RMD2(F5, BR, CR, DR, ER, AR,  9, 13, KR0);
+    RMD2(F1, AL, BL, CL, DL, EL,  5,  8, KL0); RMD2(F5, AR, BR, CR, DR, ER,  2, 15, KR0);
+    RMD2(F1, EL, AL, BL, CL, DL,  6,  7, KL0); RMD2(F5, ER, AR, BR, CR, DR, 11, 15, KR0);
+    RMD2(F1, DL, EL, AL, BL, CL,  7,  9, KL0); RMD2(F5, DR, ER, AR, BR, CR,  4,  5, KR0);
+    RMD2(F1, CL, DL, EL, AL, BL,  8, 11, KL0); RMD2(F5, CR, DR, ER, AR, BR, 13,  7, KR0);
+    RMD2(F1, BL, CL, DL, EL, AL,  9, 13, KL0); RMD2(F5, BR, CR, DR, ER, AR,  6,  7, KR0);
+    RMD2(F1, AL, BL, CL, DL, EL, 10, 14, KL0); RMD2(F5, AR, BR, CR, DR, ER, 15,  8, KR0);
+    RMD2(F1, EL, AL, BL, CL, DL, 11, 15, KL0); RMD2(F5, ER, AR, BR, CR, DR,  8, 11, KR0);
+    RMD2(F1, DL, EL, AL, BL, CL, 12,  6, KL0); RMD2(F5, DR, ER, AR, BR, CR,  1, 14, KR0);
+    RMD2(F1, CL, DL, EL, AL, BL, 13,  7, KL0); RMD2(F5, CR, DR, ER, AR, BR, 10, 14, KR0);
+    RMD2(F1, BL, CL, DL, EL, AL, 14,  9, KL0); RMD2(F5, BR, CR, DR, ER, AR,  3, 12, KR0);
+    RMD2(F1, AL, BL, CL, DL, EL, 15,  8, KL0); RMD2(F5, AR, BR, CR, DR, ER, 12,  6, KR0);
+
+    RMD2(F2, EL, AL, BL, CL, DL,  7,  7, KL1); RMD2(F4, ER, AR, BR, CR, DR,  6,  9, KR1);
+    RMD2(F2, DL, EL, AL, BL, CL,  4,  6, KL1); RMD2(F4, DR, ER, AR, BR, CR, 11, 13, KR1);
+    RMD2(F2, CL, DL, EL, AL, BL, 13,  8, KL1); RMD2(F4, CR, DR, ER, AR, BR,  3, 15, KR1);
+    RMD2(F2, BL, CL, DL, EL, AL,  1, 13, KL1); RMD2(F4, BR, CR, DR, ER, AR,  7,  7, KR1);
+    RMD2(F2, AL, BL, CL, DL, EL, 10, 11, KL1); RMD2(F4, AR, BR, CR, DR, ER,  0, 12, KR1);
+    RMD2(F2, EL, AL, BL, CL, DL,  6,  9, KL1); RMD2(F4, ER, AR, BR, CR, DR, 13,  8, KR1);
+    RMD2(F2, DL, EL, AL, BL, CL, 15,  7, KL1); RMD2(F4, DR, ER, AR, BR, CR,  5,  9, KR1);
+    RMD2(F2, CL, DL, EL, AL, BL,  3, 15, KL1); RMD2(F4, CR, DR, ER, AR, BR, 10, 11, KR1);
+    RMD2(F2, BL, CL, DL, EL, AL, 12,  7, KL1); RMD2(F4, BR, CR, DR, ER, AR, 14,  7, KR1);
+    RMD2(F2, AL, BL, CL, DL, EL,  0, 12, KL1); RMD2(F4, AR, BR, CR, DR, ER, 15,  7, KR1);
+    RMD2(F2, EL, AL, BL, CL, DL,  9, 15, KL1); RMD2(F4, ER, AR, BR, CR, DR,  8, 12, KR1);
+    RMD2(F2, DL, EL, AL, BL, CL,  5,  9, KL1); RMD2(F4, DR, ER, AR, BR, CR, 12,  7, KR1);
+    RMD2(F2, CL, DL, EL, AL, BL,  2, 11, KL1); RMD2(F4, CR, DR, ER, AR, BR,  4,  6, KR1);
+    RMD2(F2, BL, CL, DL, EL, AL, 14,  7, KL1); RMD2(F4, BR, CR, DR, ER, AR,  9, 15, KR1);
+    RMD2(F2, AL, BL, CL, DL, EL, 11, 13, KL1); RMD2(F4, AR, BR, CR, DR, ER,  1, 13, KR1);
+    RMD2(F2, EL, AL, BL, CL, DL,  8, 12, KL1); RMD2(F4, ER, AR, BR, CR, DR,  2, 11, KR1);
+
+    RMD2(F3, DL, EL, AL, BL, CL,  3, 11, KL2); RMD2(F3, DR, ER, AR, BR, CR, 15,  9, KR2);
+    RMD2(F3, CL, DL, EL, AL, BL, 10, 13, KL2); RMD2(F3, CR, DR, ER, AR, BR,  5,  7, KR2);
+    RMD2(F3, BL, CL, DL, EL, AL, 14,  6, KL2); RMD2(F3, BR, CR, DR, ER, AR,  1, 15, KR2);
+    RMD2(F3, AL, BL, CL, DL, EL,  4,  7, KL2); RMD2(F3, AR, BR, CR, DR, ER,  3, 11, KR2);
+    RMD2(F3, EL, AL, BL, CL, DL,  9, 14, KL2); RMD2(F3, ER, AR, BR, CR, DR,  7,  8, KR2);
+    RMD2(F3, DL, EL, AL, BL, CL, 15,  9, KL2); RMD2(F3, DR, ER, AR, BR, CR, 14,  6, KR2);
+    RMD2(F3, CL, DL, EL, AL, BL,  8, 13, KL2); RMD2(F3, CR, DR, ER, AR, BR,  6,  6, KR2);
+    RMD2(F3, BL, CL, DL, EL, AL,  1, 15, KL2); RMD2(F3, BR, CR, DR, ER, AR,  9, 14, KR2);
+    RMD2(F3, AL, BL, CL, DL, EL,  2, 14, KL2); RMD2(F3, AR, BR, CR, DR, ER, 11, 12, KR2);
+    RMD2(F3, EL, AL, BL, CL, DL,  7,  8, KL2); RMD2(F3, ER, AR, BR, CR, DR,  8, 13, KR2);
+    RMD2(F3, DL, EL, AL, BL, CL,  0, 13, KL2); RMD2(F3, DR, ER, AR, BR, CR, 12,  5, KR2);
+    RMD2(F3, CL, DL, EL, AL, BL,  6,  6, KL2); RMD2(F3, CR, DR, ER, AR, BR,  2, 14, KR2);
+    RMD2(F3, BL, CL, DL, EL, AL, 13,  5, KL2); RMD2(F3, BR, CR, DR, ER, AR, 10, 13, KR2);
+    RMD2(F3, AL, BL, CL, DL, EL, 11, 12, KL2); RMD2(F3, AR, BR, CR, DR, ER,  0, 13, KR2);
+    RMD2(F3, EL, AL, BL, CL, DL,  5,  7, KL2); RMD2(F3, ER, AR, BR, CR, DR,  4,  7, KR2);
+    RMD2(F3, DL, EL, AL, BL, CL, 12,  5, KL2); RMD2(F3, DR, ER, AR, BR, CR, 13,  5, KR2);
+
+    RMD2(F4, CL, DL, EL, AL, BL,  1, 11, KL3); RMD2(F2, CR, DR, ER, AR, BR,  8, 15, KR3);
+    RMD2(F4, BL, CL, DL, EL, AL,  9, 12, KL3); RMD2(F2, BR, CR, DR, ER, AR,  6,  5, KR3);
+    RMD2(F4, AL, BL, CL, DL, EL, 11, 14, KL3); RMD2(F2, AR, BR, CR, DR, ER,  4,  8, KR3);
+    RMD2(F4, EL, AL, BL, CL, DL, 10, 15, KL3); RMD2(F2, ER, AR, BR, CR, DR,  1, 11, KR3);
+    RMD2(F4, DL, EL, AL, BL, CL,  0, 14, KL3); RMD2(F2, DR, ER, AR, BR, CR,  3, 14, KR3);
+    RMD2(F4, CL, DL, EL, AL, BL,  8, 15, KL3); RMD2(F2, CR, DR, ER, AR, BR, 11, 14, KR3);
+    RMD2(F4, BL, CL, DL, EL, AL, 12,  9, KL3); RMD2(F2, BR, CR, DR, ER, AR, 15,  6, KR3);
+    RMD2(F4, AL, BL, CL, DL, EL,  4,  8, KL3); RMD2(F2, AR, BR, CR, DR, ER,  0, 14, KR3);
+    RMD2(F4, EL, AL, BL, CL, DL, 13,  9, KL3); RMD2(F2, ER, AR, BR, CR, DR,  5,  6, KR3);
+    RMD2(F4, DL, EL, AL, BL, CL,  3, 14, KL3); RMD2(F2, DR, ER, AR, BR, CR, 12,  9, KR3);
+    RMD2(F4, CL, DL, EL, AL, BL,  7,  5, KL3); RMD2(F2, CR, DR, ER, AR, BR,  2, 12, KR3);
+    RMD2(F4, BL, CL, DL, EL, AL, 15,  6, KL3); RMD2(F2, BR, CR, DR, ER, AR, 13,  9, KR3);
+    RMD2(F4, AL, BL, CL, DL, EL, 14,  8, KL3); RMD2(F2, AR, BR, CR, DR, ER,  9, 12, KR3);
+    RMD2(F4, EL, AL, BL, CL, DL,  5,  6, KL3); RMD2(F2, ER, AR, BR, CR, DR,  7,  5, KR3);
+    RMD2(F4, DL, EL, AL, BL, CL,  6,  5, KL3); RMD2(F2, DR, ER, AR, BR, CR, 10, 15, KR3);
+    RMD2(F4, CL, DL, EL, AL, BL,  2, 12, KL3); RMD2(F2, CR, DR, ER, AR, BR, 14,  8, KR3);
+
+    RMD2(F5, BL, CL, DL, EL, AL,  4,  9, KL4); RMD2(F1, BR, CR, DR, ER, AR, 12,  8, KR4);
+    RMD2(F5, AL, BL, CL, DL, EL,  0, 15, KL4); RMD2(F1, AR, BR, CR, DR, ER, 15,  5, KR4);
+    RMD2(F5, EL, AL, BL, CL, DL,  5,  5, KL4); RMD2(F1, ER, AR, BR, CR, DR, 10, 12, KR4);
+    RMD2(F5, DL, EL, AL, BL, CL,  9, 11, KL4); RMD2(F1, DR, ER, AR, BR, CR,  4,  9, KR4);
+    RMD2(F5, CL, DL, EL, AL, BL,  7,  6, KL4); RMD2(F1, CR, DR, ER, AR, BR,  1, 12, KR4);
+    RMD2(F5, BL, CL, DL, EL, AL, 12,  8, KL4); RMD2(F1, BR, CR, DR, ER, AR,  5,  5, KR4);
+    RMD2(F5, AL, BL, CL, DL, EL,  2, 13, KL4); RMD2(F1, AR, BR, CR, DR, ER,  8, 14, KR4);
+    RMD2(F5, EL, AL, BL, CL, DL, 10, 12, KL4); RMD2(F1, ER, AR, BR, CR, DR,  7,  6, KR4);
+    RMD2(F5, DL, EL, AL, BL, CL, 14,  5, KL4); RMD2(F1, DR, ER, AR, BR, CR,  6,  8, KR4);
+    RMD2(F5, CL, DL, EL, AL, BL,  1, 12, KL4); RMD2(F1, CR, DR, ER, AR, BR,  2, 13, KR4);
+    RMD2(F5, BL, CL, DL, EL, AL,  3, 13, KL4); RMD2(F1, BR, CR, DR, ER, AR, 13,  6, KR4);
+    RMD2(F5, AL, BL, CL, DL, EL,  8, 14, KL4); RMD2(F1, AR, BR, CR, DR, ER, 14,  5, KR4);
+    RMD2(F5, EL, AL, BL, CL, DL, 11, 11, KL4); RMD2(F1, ER, AR, BR, CR, DR,  0, 15, KR4);
+    RMD2(F5, DL, EL, AL, BL, CL,  6,  8, KL4); RMD2(F1, DR, ER, AR, BR, CR,  3, 13, KR4);
+    RMD2(F5, CL, DL, EL, AL, BL, 15,  5, KL4); RMD2(F1, CR, DR, ER, AR, BR,  9, 11, KR4);
+    RMD2(F5, BL, CL, DL, EL, AL, 13,  6, KL4); RMD2(F1, BR, CR, DR, ER, AR, 11, 11, KR4);
+
+    t = iv[1] + CL0 + DR0;
+    le32enc(out0 + 4, iv[2] + DL0 + ER0);
+    le32enc(out0 + 8, iv[3] + EL0 + AR0);
+    le32enc(out0 + 12, iv[4] + AL0 + BR0);
+    le32enc(out0 + 16, iv[0] + BL0 + CR0);
+    le32enc(out0, t);
+
+    t = iv[1] + CL1 + DR1;
+    le32enc(out1 + 4, iv[2] + DL1 + ER1);
+    le32enc(out1 + 8, iv[3] + EL1 + AR1);
+    le32enc(out1 + 12, iv[4] + AL1 + BR1);
+    le32enc(out1 + 16, iv[0] + BL1 + CR1);
+    le32enc(out1, t);
+}
+
+void lbry_hash(const char* input, char* output)
+{
+    lbry_state* st = &s_state;
+    uint8_t _ALIGN(64) hashA[32];
+    uint8_t _ALIGN(64) wide[64];
+    uint8_t _ALIGN(64) halves[40];
+    SHA512_CTX ctx_sha512;
+
+    if (!st->has_midstate || memcmp(st->prefix, input, LBRY_MIDSTATE_LEN) != 0) {
+        sha256_core_init(st->state);
+        sha256_core_blocks(st->state, input, 1);
+        memcpy(st->prefix, input, LBRY_MIDSTATE_LEN);
+        st->has_midstate = 1;
+    }
+
+    sha256_core_final(st->state, LBRY_MIDSTATE_LEN, input + LBRY_MIDSTATE_LEN,
+                      LBRY_HEADER_SIZE - LBRY_MIDSTATE_LEN, hashA);
+    sha256_core_hash(hashA, 32, hashA);
+
+    /* OpenSSL picks its own SHA-512 code for the CPU; the SHA512() one-shot costs a provider lookup on 3.x */
+    SHA512_Init(&ctx_sha512);
+    SHA512_Update(&ctx_sha512, hashA, 32);
+    SHA512_Final(wide, &ctx_sha512);
+
+    ripemd160_x2(wide, wide + 32, halves, halves + 20);
+
+    sha256_core_hash(halves, 40, hashA);
+    sha256_core_hash(hashA, 32, output);
+}
@@ -0,0 +1,23 @@
+#ifndef LBRY_H
+#define LBRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define LBRY_HEADER_SIZE    112
+
+/*
+ * LBRY over a 112 byte block header: sha256d, sha512, ripemd160 of each
+ * half and sha256d of the two digests.  The first 64 bytes hold no nonce,
+ * so each thread keeps their SHA-256 midstate while they stay the same.
+ */
+void lbry_hash(const char* input, char* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
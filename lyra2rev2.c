@@ -0,0 +1,89 @@
+#include "lyra2rev2.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "common.h"
+#include "scratch_pool.h"
+#include "sha3/sph_blake.h"
+#include "sha3/sph_keccak.h"
+#include "sha3/sph_skein.h"
+#include "sha3/sph_bmw.h"
+#include "algo/cubehash/sse2/cubehash_sse2.h"
+#include "algo/lyra2/lyra2.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/* 4 rows of 4 columns of 96 byte blocks */
+#define LYRA2REV2_MATRIX_SIZE   (BLOCK_LEN_INT64 * 8 * 4 * 4)
+
+static scratch_pool s_matrices = SCRATCH_POOL_INIT(LYRA2REV2_MATRIX_SIZE, 32);
+
+/* CubeHash-256 state right after its 160 initialization rounds */
+static cubehashParam s_cube_init;
+
+#ifdef _WIN32
+static INIT_ONCE s_cube_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK init_cube(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    cubehashInit(&s_cube_init, 256, 16, 32);
+    return TRUE;
+}
+#define CUBE_INIT_ONCE()    InitOnceExecuteOnce(&s_cube_once, init_cube, NULL, NULL)
+#else
+static pthread_once_t s_cube_once = PTHREAD_ONCE_INIT;
+static void init_cube(void)
+{
+    cubehashInit(&s_cube_init, 256, 16, 32);
+}
+#define CUBE_INIT_ONCE()    pthread_once(&s_cube_once, init_cube)
+#endif
+
+int lyra2rev2_hash(const char* input, char* output, uint32_t len)
+{
+    sph_blake256_context     ctx_blake;
+    sph_keccak256_context    ctx_keccak;
+    sph_skein256_context     ctx_skein;
+    sph_bmw256_context       ctx_bmw;
+    cubehashParam            ctx_cube;
+
+    uint32_t _ALIGN(64) hashA[8], hashB[8];
+    uint64_t* matrix;
+
+    matrix = (uint64_t*) scratch_pool_acquire(&s_matrices);
+    if (!matrix)
+        return -1;
+    CUBE_INIT_ONCE();
+
+    sph_blake256_init(&ctx_blake);
+    sph_blake256(&ctx_blake, input, len);
+    sph_blake256_close(&ctx_blake, hashA);
+
+    sph_keccak256_init(&ctx_keccak);
+    sph_keccak256(&ctx_keccak, hashA, 32);
+    sph_keccak256_close(&ctx_keccak, hashB);
+
+    memcpy(&ctx_cube, &s_cube_init, sizeof ctx_cube);
+    cubehashUpdateDigest(&ctx_cube, (byte*) hashA, (const byte*) hashB, 32);
+
+    LYRA2REV2(matrix, hashB, 32, hashA, 32, hashA, 32, 1, 4, 4);
+    scratch_pool_release(&s_matrices, matrix);
+
+    sph_skein256_init(&ctx_skein);
+    sph_skein256(&ctx_skein, hashB, 32);
+    sph_skein256_close(&ctx_skein, hashA);
+
+    memcpy(&ctx_cube, &s_cube_init, sizeof ctx_cube);
+    cubehashUpdateDigest(&ctx_cube, (byte*) hashB, (const byte*) hashA, 32);
+
+    sph_bmw256_init(&ctx_bmw);
+    sph_bmw256(&ctx_bmw, hashB, 32);
+    sph_bmw256_close(&ctx_bmw, hashA);
+
+    memcpy(output, hashA, 32);
+    return 0;
+}
@@ -0,0 +1,17 @@
+#ifndef LYRA2REV2_H
+#define LYRA2REV2_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Returns 0, or -1 when no sponge matrix could be allocated. */
+int lyra2rev2_hash(const char* input, char* output, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
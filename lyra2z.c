@@ -0,0 +1,35 @@
+#include "lyra2z.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "common.h"
+#include "scratch_pool.h"
+#include "sha3/sph_blake.h"
+#include "algo/lyra2/lyra2.h"
+
+/* 8 rows of 8 columns of 96 byte blocks */
+#define LYRA2Z_MATRIX_SIZE      (BLOCK_LEN_INT64 * 8 * 8 * 8)
+
+static scratch_pool s_matrices = SCRATCH_POOL_INIT(LYRA2Z_MATRIX_SIZE, 32);
+
+int lyra2z_hash(const char* input, char* output, uint32_t len)
+{
+    sph_blake256_context ctx_blake;
+    uint32_t _ALIGN(64) hash[8];
+    uint64_t* matrix;
+
+    matrix = (uint64_t*) scratch_pool_acquire(&s_matrices);
+    if (!matrix)
+        return -1;
+
+    sph_blake256_init(&ctx_blake);
+    sph_blake256(&ctx_blake, input, len);
+    sph_blake256_close(&ctx_blake, hash);
+
+    LYRA2Z(matrix, hash, 32, hash, 32, hash, 32, 8, 8, 8);
+    scratch_pool_release(&s_matrices, matrix);
+
+    memcpy(output, hash, 32);
+    return 0;
+}
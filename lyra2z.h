@@ -0,0 +1,17 @@
+#ifndef LYRA2Z_H
+#define LYRA2Z_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Returns 0, or -1 when no sponge matrix could be allocated. */
+int lyra2z_hash(const char* input, char* output, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
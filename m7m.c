@@ -0,0 +1,325 @@
+#include "m7m.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <gmp.h>
+#include <openssl/sha.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "compat.h"
+#include "sha3/sph_keccak.h"
+#include "sha3/sph_whirlpool.h"
+#include "algo/haval/sph-haval.h"
+#include "algo/tiger/sph_tiger.h"
+#include "algo/ripemd/sph_ripemd.h"
+
+/* Same constants as algo/m7m.c */
+#define EPSa                DBL_EPSILON
+#define EPS                 DBL_EPSILON
+#define BITS_PER_DIGIT      3.32192809488736234787
+#define M7M_MIDSTATE_LEN    76
+#define M7M_ROUNDS          5
+
+/* Largest export of the product, with room to spare */
+#define M7M_BDATA_SIZE      8192
+
+static double exp_n(double xt)
+{
+    if (xt < -700.0)
+        return 0;
+    else if (xt > 700.0)
+        return 1e200;
+    else if (xt > -0.8e-8 && xt < 0.8e-8)
+        return (1.0 + xt);
+    else
+        return exp(xt);
+}
+
+static double swit2_(double wvnmb)
+{
+    return pow((5.55243 * (exp_n(-0.3 * wvnmb / 15.762) - exp_n(-0.6 * wvnmb / 15.762))) * wvnmb, 0.5)
+        / 1034.66 * pow(sin(wvnmb / 65.), 2.);
+}
+
+/* Five point Gauss-Legendre quadrature of swit2_ over [x1, x2], as in algo/m7m.c */
+static double GaussianQuad_N2(const double x1, const double x2)
+{
+    double s = 0.0;
+    double x[6], w[6];
+    double z1, z, xm, xl, pp, p3, p2, p1;
+    int i, j;
+
+    xm = 0.5 * (x2 + x1);
+    xl = 0.5 * (x2 - x1);
+    for (i = 1; i <= 3; i++) {
+        z = (i == 1) ? 0.909632 : -0.0;
+        z = (i == 2) ? 0.540641 : z;
+        do {
+            p3 = 1;
+            p2 = z;
+            p1 = ((3.0 * z * z) - 1) / 2;
+            p3 = p2;
+            p2 = p1;
+            p1 = ((5.0 * z * p2) - (2.0 * z)) / 3;
+            p3 = p2;
+            p2 = p1;
+            p1 = ((7.0 * z * p2) - (3.0 * p3)) / 4;
+            p3 = p2;
+            p2 = p1;
+            p1 = ((9.0 * z * p2) - (4.0 * p3)) / 5;
+            pp = 5 * (z * p1 - p2) / (z * z - 1.0);
+            z1 = z;
+            z = z1 - p1 / pp;
+        } while (fabs(z - z1) > 3.0e-11);
+        x[i] = xm - xl * z;
+        x[5 + 1 - i] = xm + xl * z;
+        w[i] = 2.0 * xl / ((1.0 - z * z) * pp * pp);
+        w[5 + 1 - i] = w[i];
+    }
+    for (j = 1; j <= 5; j++)
+        s += w[j] * swit2_(x[j]);
+    return s;
+}
+
+static uint32_t sw2_(int nnounce)
+{
+    double wmax = ((sqrt((double) (nnounce)) * (1. + EPSa)) / 450 + 100);
+    return ((uint32_t) (GaussianQuad_N2(0., wmax) * (1. + EPSa) * 1.e6));
+}
+
+/*
+ * Everything one hash needs: the GMP numbers at their full precision, the
+ * export buffer, and the seven hash states after the first 76 header bytes,
+ * which only change with the job.  States are set up once and kept in a
+ * small pool rather than per thread, so threads that stop hashing leave
+ * nothing behind.
+ */
+typedef struct m7m_state {
+    struct m7m_state* next;
+    mpz_t magipi, magisw, product, bns0, bns1;
+    mpf_t magifpi, magifpi0, mpt1, mpt2, mptmp, mpten;
+    mp_bitcnt_t prec0;
+
+    int has_midstate;
+    unsigned char prefix[M7M_MIDSTATE_LEN];
+    SHA256_CTX               sha256;
+    SHA512_CTX               sha512;
+    sph_keccak512_context    keccak;
+    sph_whirlpool_context    whirlpool;
+    sph_haval256_5_context   haval;
+    sph_tiger_context        tiger;
+    sph_ripemd160_context    ripemd;
+
+    uint8_t _ALIGN(64) bdata[M7M_BDATA_SIZE];
+} m7m_state;
+
+/* Idle states kept for reuse; more than this many are torn down on release */
+#define M7M_MAX_IDLE        32
+
+static m7m_state* s_idle;
+static unsigned s_idle_count;
+#ifdef _WIN32
+static SRWLOCK s_idle_lock = SRWLOCK_INIT;
+#define IDLE_LOCK()         AcquireSRWLockExclusive(&s_idle_lock)
+#define IDLE_UNLOCK()       ReleaseSRWLockExclusive(&s_idle_lock)
+#else
+static pthread_mutex_t s_idle_lock = PTHREAD_MUTEX_INITIALIZER;
+#define IDLE_LOCK()         pthread_mutex_lock(&s_idle_lock)
+#define IDLE_UNLOCK()       pthread_mutex_unlock(&s_idle_lock)
+#endif
+
+static m7m_state* state_new(void)
+{
+    m7m_state* st = (m7m_state*) malloc(sizeof(m7m_state));
+    if (!st)
+        return NULL;
+
+    /* mpf_init2() rather than the process wide default precision */
+    st->prec0 = (long int) ((int) ((sqrt((double) (INT_MAX)) * (1. + EPS)) / 9000 + 75) * BITS_PER_DIGIT + 16);
+    mpz_inits(st->magipi, st->magisw, st->bns0, st->bns1, NULL);
+    mpz_init2(st->product, 512);
+    mpf_init2(st->magifpi, st->prec0);
+    mpf_init2(st->magifpi0, st->prec0);
+    mpf_init2(st->mpt1, st->prec0);
+    mpf_init2(st->mpt2, st->prec0);
+    mpf_init2(st->mptmp, st->prec0);
+    mpf_init2(st->mpten, st->prec0);
+    mpf_set_ui(st->mpten, 10);
+    mpf_set_str(st->mpt2, "0.8e3b1a9b359805c2e54c6415037f2e336893b6457f7754f6b4ae045eb6c5f2bedb26a114030846be7", 16);
+    mpf_set_str(st->magifpi0, "0.b7bfc6837e20bdb22653f1fc419f6bc33ca80eb65b7b0246f7f3b65689560aea1a2f2fd95f254d68c", 16);
+    st->has_midstate = 0;
+    return st;
+}
+
+static void state_free(m7m_state* st)
+{
+    /* mpf_clear() needs the precision the numbers were allocated with */
+    mpf_set_prec_raw(st->magifpi, st->prec0);
+    mpf_set_prec_raw(st->mptmp, st->prec0);
+    mpf_set_prec_raw(st->mpt1, st->prec0);
+    mpf_set_prec_raw(st->mpt2, st->prec0);
+    mpz_clears(st->magipi, st->magisw, st->bns0, st->bns1, st->product, NULL);
+    mpf_clears(st->magifpi, st->magifpi0, st->mpt1, st->mpt2, st->mptmp, st->mpten, NULL);
+    free(st);
+}
+
+static m7m_state* state_acquire(void)
+{
+    m7m_state* st;
+
+    IDLE_LOCK();
+    st = s_idle;
+    if (st) {
+        s_idle = st->next;
+        s_idle_count--;
+    }
+    IDLE_UNLOCK();
+    return st ? st : state_new();
+}
+
+static void state_release(m7m_state* st)
+{
+    IDLE_LOCK();
+    if (s_idle_count < M7M_MAX_IDLE) {
+        st->next = s_idle;
+        s_idle = st;
+        s_idle_count++;
+        st = NULL;
+    }
+    IDLE_UNLOCK();
+
+    if (st)
+        state_free(st);
+}
+
+static void update_midstate(m7m_state* st, const char* header)
+{
+    if (st->has_midstate && memcmp(st->prefix, header, M7M_MIDSTATE_LEN) == 0)
+        return;
+
+    SHA256_Init(&st->sha256);
+    SHA512_Init(&st->sha512);
+    sph_keccak512_init(&st->keccak);
+    sph_whirlpool_init(&st->whirlpool);
+    sph_haval256_5_init(&st->haval);
+    sph_tiger_init(&st->tiger);
+    sph_ripemd160_init(&st->ripemd);
+
+    SHA256_Update(&st->sha256, header, M7M_MIDSTATE_LEN);
+    SHA512_Update(&st->sha512, header, M7M_MIDSTATE_LEN);
+    sph_keccak512(&st->keccak, header, M7M_MIDSTATE_LEN);
+    sph_whirlpool(&st->whirlpool, header, M7M_MIDSTATE_LEN);
+    sph_haval256_5(&st->haval, header, M7M_MIDSTATE_LEN);
+    sph_tiger(&st->tiger, header, M7M_MIDSTATE_LEN);
+    sph_ripemd160(&st->ripemd, header, M7M_MIDSTATE_LEN);
+
+    memcpy(st->prefix, header, M7M_MIDSTATE_LEN);
+    st->has_midstate = 1;
+}
+
+int m7m_hash(const char* input, char* output)
+{
+    const size_t p = sizeof(unsigned long), a = 64 / p, b = 32 / p;
+    const char* tail = input + M7M_MIDSTATE_LEN;
+    const size_t tail_len = M7M_HEADER_SIZE - M7M_MIDSTATE_LEN;
+    uint8_t _ALIGN(64) bhash[7][64];
+    uint32_t _ALIGN(64) hash[8];
+    SHA256_CTX               ctx_sha256;
+    SHA512_CTX               ctx_sha512;
+    sph_keccak512_context    ctx_keccak;
+    sph_whirlpool_context    ctx_whirlpool;
+    sph_haval256_5_context   ctx_haval;
+    sph_tiger_context        ctx_tiger;
+    sph_ripemd160_context    ctx_ripemd;
+    m7m_state* st;
+    uint32_t n, usw_, mpzscale;
+    mp_bitcnt_t prec;
+    size_t bytes;
+    int i, digits;
+
+    st = state_acquire();
+    if (!st)
+        return -1;
+    update_midstate(st, input);
+
+    memset(bhash, 0, sizeof bhash);
+    memcpy(&ctx_sha256, &st->sha256, sizeof ctx_sha256);
+    SHA256_Update(&ctx_sha256, tail, tail_len);
+    SHA256_Final(bhash[0], &ctx_sha256);
+    memcpy(&ctx_sha512, &st->sha512, sizeof ctx_sha512);
+    SHA512_Update(&ctx_sha512, tail, tail_len);
+    SHA512_Final(bhash[1], &ctx_sha512);
+    memcpy(&ctx_keccak, &st->keccak, sizeof ctx_keccak);
+    sph_keccak512(&ctx_keccak, tail, tail_len);
+    sph_keccak512_close(&ctx_keccak, bhash[2]);
+    memcpy(&ctx_whirlpool, &st->whirlpool, sizeof ctx_whirlpool);
+    sph_whirlpool(&ctx_whirlpool, tail, tail_len);
+    sph_whirlpool_close(&ctx_whirlpool, bhash[3]);
+    memcpy(&ctx_haval, &st->haval, sizeof ctx_haval);
+    sph_haval256_5(&ctx_haval, tail, tail_len);
+    sph_haval256_5_close(&ctx_haval, bhash[4]);
+    memcpy(&ctx_tiger, &st->tiger, sizeof ctx_tiger);
+    sph_tiger(&ctx_tiger, tail, tail_len);
+    sph_tiger_close(&ctx_tiger, bhash[5]);
+    memcpy(&ctx_ripemd, &st->ripemd, sizeof ctx_ripemd);
+    sph_ripemd160(&ctx_ripemd, tail, tail_len);
+    sph_ripemd160_close(&ctx_ripemd, bhash[6]);
+
+    mpz_import(st->bns0, a, -1, p, -1, 0, bhash[0]);
+    mpz_set(st->bns1, st->bns0);
+    mpz_set(st->product, st->bns0);
+    for (i = 1; i < 7; i++) {
+        mpz_import(st->bns0, a, -1, p, -1, 0, bhash[i]);
+        mpz_add(st->bns1, st->bns1, st->bns0);
+        mpz_mul(st->product, st->product, st->bns0);
+    }
+    mpz_mul(st->product, st->product, st->bns1);
+    mpz_mul(st->product, st->product, st->product);
+    bytes = mpz_sizeinbase(st->product, 256);
+    mpz_export(st->bdata, NULL, -1, 1, 0, 0, st->product);
+    SHA256(st->bdata, bytes, (unsigned char*) hash);
+
+    /* The nonce, as algo/m7m.c reads it from its host order header */
+    memcpy(&n, input + M7M_MIDSTATE_LEN, 4);
+    digits = (int) ((sqrt((double) (n / 2)) * (1. + EPS)) / 9000 + 75);
+    prec = (long int) (digits * BITS_PER_DIGIT + 16);
+    mpf_set_prec_raw(st->magifpi, prec);
+    mpf_set_prec_raw(st->mptmp, prec);
+    mpf_set_prec_raw(st->mpt1, prec);
+    mpf_set_prec_raw(st->mpt2, prec);
+
+    usw_ = sw2_(n / 2);
+    mpzscale = 1;
+    mpz_set_ui(st->magisw, usw_);
+    for (i = 0; i < M7M_ROUNDS; i++) {
+        mpf_set_d(st->mpt1, 0.25 * mpzscale);
+        mpf_sub(st->mpt1, st->mpt1, st->mpt2);
+        mpf_abs(st->mpt1, st->mpt1);
+        mpf_div(st->magifpi, st->magifpi0, st->mpt1);
+        mpf_pow_ui(st->mptmp, st->mpten, digits >> 1);
+        mpf_mul(st->magifpi, st->magifpi, st->mptmp);
+        mpz_set_f(st->magipi, st->magifpi);
+        mpz_add(st->magipi, st->magipi, st->magisw);
+        mpz_add(st->product, st->product, st->magipi);
+        mpz_import(st->bns0, b, -1, p, -1, 0, (void*) hash);
+        mpz_add(st->bns1, st->bns1, st->bns0);
+        mpz_mul(st->product, st->product, st->bns1);
+        mpz_cdiv_q(st->product, st->product, st->bns0);
+        bytes = mpz_sizeinbase(st->product, 256);
+        mpzscale = bytes;
+        mpz_export(st->bdata, NULL, -1, 1, 0, 0, st->product);
+        SHA256(st->bdata, bytes, (unsigned char*) hash);
+    }
+
+    memcpy(output, hash, 32);
+    state_release(st);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#ifndef M7M_H
+#define M7M_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define M7M_HEADER_SIZE     80
+
+/*
+ * Magi's M7M over an 80 byte block header, whose last word is the nonce.
+ * The GMP integers and floats come from a pool of idle states shared by
+ * every thread.  Returns 0, or -1 when a new state could not be allocated.
+ */
+int m7m_hash(const char* input, char* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,7 +1,10 @@
 #include <node.h>
 #include <node_buffer.h>
 #include <v8.h>
+#include <uv.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <vector>
 
 extern "C" {
     #include "bcrypt.h"
@@ -27,6 +30,31 @@ extern "C" {
     #include "sha1.h",
     #include "x15.h"
 	#include "fresh.h"
+    #include "lyra2rev2.h"
+    #include "lyra2z.h"
+    #include "yescrypt.h"
+    #include "neoscrypt.h"
+    #include "ar2.h"
+    #include "hodl.h"
+    #include "axiom.h"
+    #include "xevan.h"
+    #include "hmq1725.h"
+    #include "m7m.h"
+    #include "lbry.h"
+    #include "x14.h"
+    #include "x17.h"
+    #include "skunk.h"
+    #include "x11gost.h"
+    #include "zr5.h"
+    #include "drop.h"
+    #include "pluck.h"
+    #include "sha256d.h"
+    #include "phi1612.h"
+    #include "c11.h"
+    #include "x11evo.h"
+    #include "veltor.h"
+    #include "bastion.h"
+    #include "hasher.h"
 }
 
 #include "boolberry.h"
@@ -240,6 +268,42 @@ Handle<Value> keccak(const Arguments& args) {
     return scope.Close(buff->handle_);
 }
 
+Handle<Value> keccakBatch(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1 || !args[0]->IsArray())
+        return except("You must provide an array of buffers.");
+
+    Local<Array> targets = Local<Array>::Cast(args[0]);
+    uint32_t count = targets->Length();
+
+    std::vector<const char*> inputs(count);
+    std::vector<uint32_t> sizes(count);
+    std::vector<char> hashes(count * 32);
+    std::vector<char*> outputs(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Local<Value> target = targets->Get(i);
+
+        if(!Buffer::HasInstance(target))
+            return except("Array elements should be buffer objects.");
+
+        inputs[i] = Buffer::Data(target);
+        sizes[i] = Buffer::Length(target);
+        outputs[i] = &hashes[i * 32];
+    }
+
+    if (count)
+        keccak_hash_batch(&inputs[0], &sizes[0], &outputs[0], count);
+
+    Local<Array> results = Array::New(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Buffer* buff = Buffer::New(outputs[i], 32);
+        results->Set(i, buff->handle_);
+    }
+    return scope.Close(results);
+}
+
 
 Handle<Value> bcrypt(const Arguments& args) {
     HandleScope scope;
@@ -543,6 +607,200 @@ Handle<Value> tribus(const Arguments& args) {
 	return scope.Close(buff->handle_);
 }
 
+class BoolberryScratchpad : public ObjectWrap {
+public:
+    static Persistent<FunctionTemplate> constructor;
+
+    static void Init(Handle<Object> exports) {
+        Local<FunctionTemplate> tpl = FunctionTemplate::New(New);
+        tpl->SetClassName(String::NewSymbol("BoolberryScratchpad"));
+        tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+        NODE_SET_PROTOTYPE_METHOD(tpl, "load", Load);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "append", Append);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "pop", Pop);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "refresh", Refresh);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "size", Size);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "height", Height);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "close", Close);
+
+        constructor = Persistent<FunctionTemplate>::New(tpl);
+        exports->Set(String::NewSymbol("BoolberryScratchpad"), constructor->GetFunction());
+    }
+
+    static bool HasInstance(Handle<Value> value) {
+        return value->IsObject() && constructor->HasInstance(value);
+    }
+
+    boolberry_scratchpad* spad;
+    bool writable;
+
+private:
+    BoolberryScratchpad(boolberry_scratchpad* spad, bool writable) : spad(spad), writable(writable) {}
+
+    ~BoolberryScratchpad() {
+        if (spad)
+            spad->release();
+    }
+
+    static BoolberryScratchpad* Self(const Arguments& args) {
+        BoolberryScratchpad* self = ObjectWrap::Unwrap<BoolberryScratchpad>(args.This());
+        return self->spad ? self : NULL;
+    }
+
+    // new BoolberryScratchpad([path], [writable])
+    static Handle<Value> New(const Arguments& args) {
+        HandleScope scope;
+
+        if (!args.IsConstructCall())
+            return except("Use the new operator to create a BoolberryScratchpad.");
+
+        boolberry_scratchpad* spad;
+        bool writable = true;
+
+        if (args.Length() >= 2)
+            writable = args[1]->BooleanValue();
+
+        if (args.Length() >= 1 && args[0]->IsString()) {
+            std::string err;
+            String::Utf8Value path(args[0]);
+            spad = boolberry_scratchpad::open(*path, writable, err);
+            if (!spad)
+                return except(err.c_str());
+        }
+        else {
+            spad = boolberry_scratchpad::create();
+            writable = true;
+        }
+
+        BoolberryScratchpad* self = new BoolberryScratchpad(spad, writable);
+        self->Wrap(args.This());
+        return args.This();
+    }
+
+    static Handle<Value> Write(const Arguments& args, bool append) {
+        HandleScope scope;
+
+        BoolberryScratchpad* self = Self(args);
+        if (!self)
+            return except("Scratchpad is closed.");
+        if (!self->writable)
+            return except("Scratchpad is read-only.");
+
+        if (args.Length() < 1)
+            return except("You must provide one argument.");
+
+        Local<Object> target = args[0]->ToObject();
+
+        if(!Buffer::HasInstance(target))
+            return except("Argument 1 should be a buffer object.");
+
+        uint64_t height = self->spad->height();
+        if (args.Length() >= 2) {
+            if (!args[1]->IsNumber() || args[1]->IntegerValue() < 0)
+                return except("Argument 2 should be a non-negative number.");
+            height = args[1]->IntegerValue();
+        }
+
+        std::string err;
+        bool ok = append ?
+            self->spad->append(Buffer::Data(target), Buffer::Length(target), height, err) :
+            self->spad->load(Buffer::Data(target), Buffer::Length(target), height, err);
+        if (!ok)
+            return except(err.c_str());
+
+        return scope.Close(Number::New(self->spad->size() / 32));
+    }
+
+    // load(buffer, [height]): replace the contents
+    static Handle<Value> Load(const Arguments& args) {
+        return Write(args, false);
+    }
+
+    // append(buffer, [height]): add the hashes of new blocks
+    static Handle<Value> Append(const Arguments& args) {
+        return Write(args, true);
+    }
+
+    // pop(count, [height]): drop hashes of orphaned blocks
+    static Handle<Value> Pop(const Arguments& args) {
+        HandleScope scope;
+
+        BoolberryScratchpad* self = Self(args);
+        if (!self)
+            return except("Scratchpad is closed.");
+        if (!self->writable)
+            return except("Scratchpad is read-only.");
+
+        if (args.Length() < 1 || !args[0]->IsNumber() || args[0]->IntegerValue() < 0)
+            return except("Argument 1 should be a non-negative number.");
+
+        uint64_t count = args[0]->IntegerValue();
+        uint64_t height = self->spad->height();
+        if (args.Length() >= 2) {
+            if (!args[1]->IsNumber() || args[1]->IntegerValue() < 0)
+                return except("Argument 2 should be a non-negative number.");
+            height = args[1]->IntegerValue();
+        }
+
+        std::string err;
+        if (!self->spad->pop(count, height, err))
+            return except(err.c_str());
+
+        return scope.Close(Number::New(self->spad->size() / 32));
+    }
+
+    // refresh(): pick up growth written by another process
+    static Handle<Value> Refresh(const Arguments& args) {
+        HandleScope scope;
+
+        BoolberryScratchpad* self = Self(args);
+        if (!self)
+            return except("Scratchpad is closed.");
+
+        std::string err;
+        if (!self->spad->refresh(err))
+            return except(err.c_str());
+
+        return scope.Close(Number::New(self->spad->size() / 32));
+    }
+
+    // size(): number of 32 byte hashes
+    static Handle<Value> Size(const Arguments& args) {
+        HandleScope scope;
+
+        BoolberryScratchpad* self = Self(args);
+        if (!self)
+            return except("Scratchpad is closed.");
+
+        return scope.Close(Number::New(self->spad->size() / 32));
+    }
+
+    static Handle<Value> Height(const Arguments& args) {
+        HandleScope scope;
+
+        BoolberryScratchpad* self = Self(args);
+        if (!self)
+            return except("Scratchpad is closed.");
+
+        return scope.Close(Number::New(self->spad->height()));
+    }
+
+    // close(): drop this handle's reference without waiting for GC
+    static Handle<Value> Close(const Arguments& args) {
+        HandleScope scope;
+
+        BoolberryScratchpad* self = ObjectWrap::Unwrap<BoolberryScratchpad>(args.This());
+        if (self->spad) {
+            self->spad->release();
+            self->spad = NULL;
+        }
+        return scope.Close(Undefined());
+    }
+};
+
+Persistent<FunctionTemplate> BoolberryScratchpad::constructor;
+
 Handle<Value> boolberry(const Arguments& args) {
     HandleScope scope;
 
@@ -550,15 +808,11 @@ Handle<Value> boolberry(const Arguments& args) {
         return except("You must provide two arguments.");
 
     Local<Object> target = args[0]->ToObject();
-    Local<Object> target_spad = args[1]->ToObject();
     uint32_t height = 1;
 
     if(!Buffer::HasInstance(target))
         return except("Argument 1 should be a buffer object.");
 
-    if(!Buffer::HasInstance(target_spad))
-        return except("Argument 2 should be a buffer object.");
-
     if(args.Length() >= 3)
         if(args[2]->IsUint32())
             height = args[2]->ToUint32()->Uint32Value();
@@ -566,18 +820,98 @@ Handle<Value> boolberry(const Arguments& args) {
             return except("Argument 3 should be an unsigned integer.");
 
     char * input = Buffer::Data(target);
-    char * scratchpad = Buffer::Data(target_spad);
     char output[32];
 
     uint32_t input_len = Buffer::Length(target);
-    uint64_t spad_len = Buffer::Length(target_spad);
 
-    boolberry_hash(input, input_len, scratchpad, spad_len, output, height);
+    if (BoolberryScratchpad::HasInstance(args[1])) {
+        BoolberryScratchpad* spad = ObjectWrap::Unwrap<BoolberryScratchpad>(args[1]->ToObject());
+        if (!spad->spad)
+            return except("Scratchpad is closed.");
+
+        std::string err;
+        if (!spad->spad->hash(input, input_len, output, height, err))
+            return except(err.c_str());
+    }
+    else {
+        Local<Object> target_spad = args[1]->ToObject();
+
+        if(!Buffer::HasInstance(target_spad))
+            return except("Argument 2 should be a buffer object or a BoolberryScratchpad.");
+
+        char * scratchpad = Buffer::Data(target_spad);
+        uint64_t spad_len = Buffer::Length(target_spad);
+
+        boolberry_hash(input, input_len, scratchpad, spad_len, output, height);
+    }
 
     Buffer* buff = Buffer::New(output, 32);
     return scope.Close(buff->handle_);
 }
 
+Handle<Value> boolberryBatch(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 2)
+        return except("You must provide two arguments.");
+
+    if (!args[0]->IsArray())
+        return except("Argument 1 should be an array of buffers.");
+
+    uint32_t height = 1;
+
+    if(args.Length() >= 3)
+        if(args[2]->IsUint32())
+            height = args[2]->ToUint32()->Uint32Value();
+        else
+            return except("Argument 3 should be an unsigned integer.");
+
+    Local<Array> targets = Local<Array>::Cast(args[0]);
+    uint32_t count = targets->Length();
+
+    std::vector<const char*> inputs(count);
+    std::vector<uint32_t> input_lens(count);
+    std::vector<char> hashes(count * 32);
+    std::vector<char*> outputs(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Local<Value> target = targets->Get(i);
+
+        if(!Buffer::HasInstance(target))
+            return except("Array elements should be buffer objects.");
+
+        inputs[i] = Buffer::Data(target);
+        input_lens[i] = Buffer::Length(target);
+        outputs[i] = &hashes[i * 32];
+    }
+
+    if (BoolberryScratchpad::HasInstance(args[1])) {
+        BoolberryScratchpad* spad = ObjectWrap::Unwrap<BoolberryScratchpad>(args[1]->ToObject());
+        if (!spad->spad)
+            return except("Scratchpad is closed.");
+
+        std::string err;
+        if (count && !spad->spad->hash_batch(&inputs[0], &input_lens[0], count, &outputs[0], height, err))
+            return except(err.c_str());
+    }
+    else {
+        Local<Object> target_spad = args[1]->ToObject();
+
+        if(!Buffer::HasInstance(target_spad))
+            return except("Argument 2 should be a buffer object or a BoolberryScratchpad.");
+
+        if (count)
+            boolberry_hash_batch(&inputs[0], &input_lens[0], count, Buffer::Data(target_spad), Buffer::Length(target_spad), &outputs[0], height);
+    }
+
+    Local<Array> results = Array::New(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Buffer* buff = Buffer::New(outputs[i], 32);
+        results->Set(i, buff->handle_);
+    }
+    return scope.Close(results);
+}
+
 Handle<Value> nist5(const Arguments& args) {
     HandleScope scope;
 
@@ -666,6 +1000,1133 @@ Handle<Value> fresh(const Arguments& args) {
     return scope.Close(buff->handle_);
 }
 
+Handle<Value> lyra2rev2(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    if (lyra2rev2_hash(input, output, input_len) != 0)
+        return except("Unable to allocate the lyra2rev2 matrix.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> lyra2z(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    if (lyra2z_hash(input, output, input_len) != 0)
+        return except("Unable to allocate the lyra2z matrix.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> yescrypt(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    if (yescrypt_hash(input, output, input_len) != 0)
+        return except("Unable to allocate the yescrypt scratch region.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> yescryptBatch(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    if (!args[0]->IsArray())
+        return except("Argument should be an array of buffers.");
+
+    Local<Array> targets = Local<Array>::Cast(args[0]);
+    uint32_t count = targets->Length();
+
+    std::vector<const char*> inputs(count);
+    std::vector<uint32_t> input_lens(count);
+    std::vector<char> hashes(count * 32);
+    std::vector<char*> outputs(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Local<Value> target = targets->Get(i);
+
+        if(!Buffer::HasInstance(target))
+            return except("Array elements should be buffer objects.");
+
+        inputs[i] = Buffer::Data(target);
+        input_lens[i] = Buffer::Length(target);
+        outputs[i] = &hashes[i * 32];
+    }
+
+    if (count && yescrypt_hash_batch(&inputs[0], &input_lens[0], count, &outputs[0]) != 0)
+        return except("Unable to allocate the yescrypt scratch region.");
+
+    Local<Array> results = Array::New(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Buffer* buff = Buffer::New(outputs[i], 32);
+        results->Set(i, buff->handle_);
+    }
+    return scope.Close(results);
+}
+
+Handle<Value> neoscrypt(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    if (neoscrypt_hash(input, output, input_len) != 0)
+        return except("Unable to allocate the neoscrypt scratch memory.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> neoscryptBatch(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    if (!args[0]->IsArray())
+        return except("Argument should be an array of buffers.");
+
+    Local<Array> targets = Local<Array>::Cast(args[0]);
+    uint32_t count = targets->Length();
+
+    std::vector<const char*> inputs(count);
+    std::vector<uint32_t> input_lens(count);
+    std::vector<char> hashes(count * 32);
+    std::vector<char*> outputs(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Local<Value> target = targets->Get(i);
+
+        if(!Buffer::HasInstance(target))
+            return except("Array elements should be buffer objects.");
+
+        inputs[i] = Buffer::Data(target);
+        input_lens[i] = Buffer::Length(target);
+        outputs[i] = &hashes[i * 32];
+    }
+
+    if (count && neoscrypt_hash_batch(&inputs[0], &input_lens[0], count, &outputs[0]) != 0)
+        return except("Unable to allocate the neoscrypt scratch memory.");
+
+    Local<Array> results = Array::New(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Buffer* buff = Buffer::New(outputs[i], 32);
+        results->Set(i, buff->handle_);
+    }
+    return scope.Close(results);
+}
+
+Handle<Value> argon2(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    if (ar2_hash(input, output, input_len) != 0)
+        return except("Unable to allocate the argon2 block memory.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> hodl(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < HODL_HEADER_SIZE)
+        return except("Argument should be an 88 byte hodl block header.");
+
+    char output[32];
+
+    int result = hodl_hash(Buffer::Data(target), output);
+    if (result == -1)
+        return except("The block template of this header has not been prepared with hodlPrepare.");
+    if (result < 0)
+        return except("Unable to allocate the hodl cipher context.");
+    if (result == 0)
+        return scope.Close(Null());
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> xevan(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    xevan_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> m7m(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < M7M_HEADER_SIZE)
+        return except("Argument should be an 80 byte block header.");
+
+    char output[32];
+
+    if (m7m_hash(Buffer::Data(target), output) != 0)
+        return except("Unable to allocate the m7m state.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> lbry(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < LBRY_HEADER_SIZE)
+        return except("Argument should be a 112 byte block header.");
+
+    char output[32];
+
+    lbry_hash(Buffer::Data(target), output);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+/*
+ * The array of buffers args[0] of fnBatch([buffer, ...], ...) and room for
+ * their 32 byte hashes.  Functions that read a whole block header pass its
+ * size as min_len.  Collect() returns an empty handle, or the exception for
+ * a bad argument; Results() is the array of hashes in input order.
+ */
+struct BatchInputs {
+    std::vector<const char*> inputs;
+    std::vector<uint32_t> input_lens;
+    std::vector<char> hashes;
+    std::vector<char*> outputs;
+    uint32_t count;
+
+    Handle<Value> Collect(const Arguments& args, uint32_t min_len) {
+        if (args.Length() < 1)
+            return except("You must provide one argument.");
+
+        if (!args[0]->IsArray())
+            return except("Argument should be an array of buffers.");
+
+        Local<Array> targets = Local<Array>::Cast(args[0]);
+        count = targets->Length();
+
+        inputs.resize(count);
+        input_lens.resize(count);
+        hashes.resize(count * 32);
+        outputs.resize(count);
+
+        for (uint32_t i = 0; i < count; i++) {
+            Local<Value> target = targets->Get(i);
+
+            if(!Buffer::HasInstance(target))
+                return except("Array elements should be buffer objects.");
+
+            inputs[i] = Buffer::Data(target);
+            input_lens[i] = Buffer::Length(target);
+            outputs[i] = &hashes[i * 32];
+
+            if (input_lens[i] < min_len)
+                return except("Array elements should be block headers.");
+        }
+        return Handle<Value>();
+    }
+
+    Local<Array> Results() {
+        Local<Array> results = Array::New(count);
+        for (uint32_t i = 0; i < count; i++) {
+            Buffer* buff = Buffer::New(outputs[i], 32);
+            results->Set(i, buff->handle_);
+        }
+        return results;
+    }
+};
+
+/* fnBatch([buffer, ...]) for batch functions that cannot fail. */
+typedef void (*batch_hash_fn)(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+static Handle<Value> HashBatch(const Arguments& args, batch_hash_fn fn, uint32_t min_len = 0) {
+    HandleScope scope;
+    BatchInputs batch;
+
+    Handle<Value> error = batch.Collect(args, min_len);
+    if (!error.IsEmpty())
+        return error;
+
+    if (batch.count)
+        fn(&batch.inputs[0], &batch.input_lens[0], batch.count, &batch.outputs[0]);
+
+    return scope.Close(batch.Results());
+}
+
+/* fnBatch([buffer, ...]) for batch functions that return 0, or non-zero with error thrown. */
+typedef int (*checked_batch_hash_fn)(const char* const* inputs, const uint32_t* input_lens, uint32_t count,
+                                     char* const* outputs);
+
+static Handle<Value> HashBatch(const Arguments& args, checked_batch_hash_fn fn, uint32_t min_len, const char* error) {
+    HandleScope scope;
+    BatchInputs batch;
+
+    Handle<Value> bad = batch.Collect(args, min_len);
+    if (!bad.IsEmpty())
+        return bad;
+
+    if (batch.count && fn(&batch.inputs[0], &batch.input_lens[0], batch.count, &batch.outputs[0]) != 0)
+        return except(error);
+
+    return scope.Close(batch.Results());
+}
+
+Handle<Value> quarkBatch(const Arguments& args) {
+    return HashBatch(args, quark_hash_batch);
+}
+
+Handle<Value> hmq1725(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    hmq1725_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> hmq1725Batch(const Arguments& args) {
+    return HashBatch(args, hmq1725_hash_batch);
+}
+
+Handle<Value> x14(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    x14_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> x14Batch(const Arguments& args) {
+    return HashBatch(args, x14_hash_batch);
+}
+
+Handle<Value> x17(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    x17_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> x17Batch(const Arguments& args) {
+    return HashBatch(args, x17_hash_batch);
+}
+
+Handle<Value> x13sm3Batch(const Arguments& args) {
+    return HashBatch(args, x13sm3_hash_batch, X13SM3_HEADER_SIZE);
+}
+
+Handle<Value> skunk(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    skunk_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> x11gost(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    x11gost_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> zr5(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < ZR5_HEADER_SIZE)
+        return except("Argument should be an 80 byte block header.");
+
+    char output[32];
+
+    zr5_hash(Buffer::Data(target), output);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> zr5Batch(const Arguments& args) {
+    return HashBatch(args, zr5_hash_batch, ZR5_HEADER_SIZE);
+}
+
+Handle<Value> drop(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < DROP_HEADER_SIZE)
+        return except("Argument should be an 80 byte block header.");
+
+    char output[32];
+
+    drop_hash(Buffer::Data(target), output);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> dropBatch(const Arguments& args) {
+    return HashBatch(args, drop_hash_batch, DROP_HEADER_SIZE);
+}
+
+Handle<Value> pluck(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < PLUCK_HEADER_SIZE)
+        return except("Argument should be an 80 byte block header.");
+
+    char output[32];
+
+    if (pluck_hash(Buffer::Data(target), output) != 0)
+        return except("Unable to allocate the pluck hash buffer.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> pluckBatch(const Arguments& args) {
+    return HashBatch(args, pluck_hash_batch, PLUCK_HEADER_SIZE, "Unable to allocate the pluck hash buffers.");
+}
+
+/*
+ * The state after the first 64 bytes of a job's header, for the hashes that
+ * take one: Mid is the C struct and init() fills it in from the header.
+ */
+template <typename Mid, void (*init)(Mid*, const char*)>
+class Midstate : public ObjectWrap {
+public:
+    static Persistent<FunctionTemplate> constructor;
+    static const char* name;
+
+    static void Init(Handle<Object> exports, const char* class_name) {
+        name = class_name;
+
+        Local<FunctionTemplate> tpl = FunctionTemplate::New(New);
+        tpl->SetClassName(String::NewSymbol(name));
+        tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+        constructor = Persistent<FunctionTemplate>::New(tpl);
+        exports->Set(String::NewSymbol(name), constructor->GetFunction());
+    }
+
+    static bool HasInstance(Handle<Value> value) {
+        return value->IsObject() && constructor->HasInstance(value);
+    }
+
+    /*
+     * The optional midstate argument at index; NULL when it is left out.
+     * Inputs that do not start with its 64 bytes are hashed in full.
+     */
+    static bool Arg(const Arguments& args, int index, const Mid** mid) {
+        *mid = NULL;
+        if (args.Length() <= index || args[index]->IsUndefined() || args[index]->IsNull())
+            return true;
+        if (!HasInstance(args[index]))
+            return false;
+        *mid = &ObjectWrap::Unwrap<Midstate>(args[index]->ToObject())->mid;
+        return true;
+    }
+
+    Mid mid;
+
+private:
+    // new <name>(header), with header at least 64 bytes long
+    static Handle<Value> New(const Arguments& args) {
+        HandleScope scope;
+
+        if (!args.IsConstructCall())
+            return except((std::string("Use the new operator to create a ") + name + ".").c_str());
+
+        if (args.Length() < 1)
+            return except("You must provide one argument.");
+
+        Local<Object> target = args[0]->ToObject();
+
+        if(!Buffer::HasInstance(target))
+            return except("Argument should be a buffer object.");
+
+        if (Buffer::Length(target) < 64)
+            return except("Argument should be at least 64 bytes long.");
+
+        Midstate* self = new Midstate();
+        init(&self->mid, Buffer::Data(target));
+        self->Wrap(args.This());
+        return args.This();
+    }
+};
+
+template <typename Mid, void (*init)(Mid*, const char*)>
+Persistent<FunctionTemplate> Midstate<Mid, init>::constructor;
+
+template <typename Mid, void (*init)(Mid*, const char*)>
+const char* Midstate<Mid, init>::name;
+
+typedef Midstate<sha256_midstate, sha256_midstate_init> Sha256Midstate;
+typedef Midstate<veltor_midstate, veltor_midstate_init> VeltorMidstate;
+
+static Handle<Value> Sha256Rounds(const Arguments& args, int rounds) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    const sha256_midstate* mid;
+    if (!Sha256Midstate::Arg(args, 1, &mid))
+        return except("Argument 2 should be a Sha256Midstate.");
+
+    char output[32];
+
+    sha256n_hash(mid, rounds, Buffer::Data(target), output, Buffer::Length(target));
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+static Handle<Value> Sha256RoundsBatch(const Arguments& args, int rounds) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    if (!args[0]->IsArray())
+        return except("Argument should be an array of buffers.");
+
+    const sha256_midstate* mid;
+    if (!Sha256Midstate::Arg(args, 1, &mid))
+        return except("Argument 2 should be a Sha256Midstate.");
+
+    Local<Array> targets = Local<Array>::Cast(args[0]);
+    uint32_t count = targets->Length();
+
+    std::vector<const char*> inputs(count);
+    std::vector<uint32_t> input_lens(count);
+    std::vector<char> hashes(count * 32);
+    std::vector<char*> outputs(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Local<Value> target = targets->Get(i);
+
+        if(!Buffer::HasInstance(target))
+            return except("Array elements should be buffer objects.");
+
+        inputs[i] = Buffer::Data(target);
+        input_lens[i] = Buffer::Length(target);
+        outputs[i] = &hashes[i * 32];
+    }
+
+    if (count)
+        sha256n_hash_batch(mid, rounds, &inputs[0], &input_lens[0], count, &outputs[0]);
+
+    Local<Array> results = Array::New(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Buffer* buff = Buffer::New(outputs[i], 32);
+        results->Set(i, buff->handle_);
+    }
+    return scope.Close(results);
+}
+
+Handle<Value> sha256d(const Arguments& args) {
+    return Sha256Rounds(args, 2);
+}
+
+Handle<Value> sha256dBatch(const Arguments& args) {
+    return Sha256RoundsBatch(args, 2);
+}
+
+Handle<Value> sha256t(const Arguments& args) {
+    return Sha256Rounds(args, 3);
+}
+
+Handle<Value> sha256tBatch(const Arguments& args) {
+    return Sha256RoundsBatch(args, 3);
+}
+
+Handle<Value> phi1612(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    phi1612_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> phi1612Batch(const Arguments& args) {
+    return HashBatch(args, phi1612_hash_batch);
+}
+
+Handle<Value> c11(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    c11_hash(input, output, input_len);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> c11Batch(const Arguments& args) {
+    return HashBatch(args, c11_hash_batch);
+}
+
+Handle<Value> x11evo(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < X11EVO_HEADER_SIZE)
+        return except("Argument should be an 80 byte block header.");
+
+    char output[32];
+
+    x11evo_hash(Buffer::Data(target), output);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> x11evoBatch(const Arguments& args) {
+    return HashBatch(args, x11evo_hash_batch, X11EVO_HEADER_SIZE);
+}
+
+Handle<Value> veltor(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    const veltor_midstate* mid;
+    if (!VeltorMidstate::Arg(args, 1, &mid))
+        return except("Argument 2 should be a VeltorMidstate.");
+
+    char output[32];
+
+    veltor_hash(mid, Buffer::Data(target), output, Buffer::Length(target));
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+// veltorBatch([buffer, ...], mid): mid is optional
+Handle<Value> veltorBatch(const Arguments& args) {
+    HandleScope scope;
+    BatchInputs batch;
+
+    Handle<Value> error = batch.Collect(args, 0);
+    if (!error.IsEmpty())
+        return error;
+
+    const veltor_midstate* mid;
+    if (!VeltorMidstate::Arg(args, 1, &mid))
+        return except("Argument 2 should be a VeltorMidstate.");
+
+    if (batch.count)
+        veltor_hash_batch(mid, &batch.inputs[0], &batch.input_lens[0], batch.count, &batch.outputs[0]);
+
+    return scope.Close(batch.Results());
+}
+
+Handle<Value> hefty1Batch(const Arguments& args) {
+    return HashBatch(args, hefty1_hash_batch);
+}
+
+Handle<Value> heavy(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char output[32];
+
+    heavy_hash(Buffer::Data(target), output, Buffer::Length(target));
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> heavyBatch(const Arguments& args) {
+    return HashBatch(args, heavy_hash_batch);
+}
+
+Handle<Value> bastion(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    if (Buffer::Length(target) < BASTION_HEADER_SIZE)
+        return except("Argument should be an 80 byte block header.");
+
+    char output[32];
+
+    bastion_hash(Buffer::Data(target), output);
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> bastionBatch(const Arguments& args) {
+    return HashBatch(args, bastion_hash_batch, BASTION_HEADER_SIZE);
+}
+
+/*
+ * Hashes that take milliseconds each run off the event loop on libuv's
+ * thread pool: fn(input, output, len) is called on a worker thread and
+ * callback(err, hash) back on the loop.
+ */
+typedef int (*async_hash_fn)(const char* input, char* output, uint32_t len);
+
+struct AsyncHashBaton {
+    uv_work_t request;
+    async_hash_fn fn;
+    const char* error;
+    std::vector<char> input;
+    char output[32];
+    int result;
+    Persistent<Function> callback;
+};
+
+static void AsyncHashWork(uv_work_t* req) {
+    AsyncHashBaton* baton = static_cast<AsyncHashBaton*>(req->data);
+    baton->result = baton->fn(baton->input.empty() ? NULL : &baton->input[0], baton->output, baton->input.size());
+}
+
+static void AsyncHashAfter(uv_work_t* req, int status) {
+    HandleScope scope;
+    AsyncHashBaton* baton = static_cast<AsyncHashBaton*>(req->data);
+    Handle<Value> argv[2];
+
+    if (baton->result != 0) {
+        argv[0] = Exception::Error(String::New(baton->error));
+        argv[1] = Undefined();
+    } else {
+        argv[0] = Null();
+        argv[1] = Buffer::New(baton->output, 32)->handle_;
+    }
+
+    MakeCallback(Context::GetCurrent()->Global(), baton->callback, 2, argv);
+
+    baton->callback.Dispose();
+    delete baton;
+}
+
+// fnAsync(buffer, callback): copies the input so the caller may reuse it; shorter than min_len throws
+static Handle<Value> QueueHash(const Arguments& args, async_hash_fn fn, const char* error, uint32_t min_len = 0) {
+    HandleScope scope;
+
+    if (args.Length() < 2)
+        return except("You must provide two arguments.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument 1 should be a buffer object.");
+
+    if (Buffer::Length(target) < min_len)
+        return except("Argument 1 should be a block header.");
+
+    if (!args[1]->IsFunction())
+        return except("Argument 2 should be a callback function.");
+
+    const char* input = Buffer::Data(target);
+    AsyncHashBaton* baton = new AsyncHashBaton();
+    baton->request.data = baton;
+    baton->fn = fn;
+    baton->error = error;
+    baton->input.assign(input, input + Buffer::Length(target));
+    baton->result = 0;
+    baton->callback = Persistent<Function>::New(Local<Function>::Cast(args[1]));
+
+    uv_queue_work(uv_default_loop(), &baton->request, AsyncHashWork, AsyncHashAfter);
+
+    return scope.Close(Undefined());
+}
+
+Handle<Value> axiom(const Arguments& args) {
+    HandleScope scope;
+
+    if (args.Length() < 1)
+        return except("You must provide one argument.");
+
+    Local<Object> target = args[0]->ToObject();
+
+    if(!Buffer::HasInstance(target))
+        return except("Argument should be a buffer object.");
+
+    char * input = Buffer::Data(target);
+    char output[32];
+
+    uint32_t input_len = Buffer::Length(target);
+
+    if (axiom_hash(input, output, input_len) != 0)
+        return except("Unable to allocate the axiom matrix.");
+
+    Buffer* buff = Buffer::New(output, 32);
+    return scope.Close(buff->handle_);
+}
+
+Handle<Value> axiomAsync(const Arguments& args) {
+    return QueueHash(args, axiom_hash, "Unable to allocate the axiom matrix.");
+}
+
+// QueueHash has checked the header length
+static int hodl_prepare_job(const char* input, char* output, uint32_t len) {
+    (void) len;
+    return hodl_prepare(input, output);
+}
+
+// hodlPrepare(header, callback): builds the 1 GiB HODL garbage of the header's template
+Handle<Value> hodlPrepare(const Arguments& args) {
+    return QueueHash(args, hodl_prepare_job, "Unable to allocate the hodl garbage buffer.", HODL_TEMPLATE_SIZE);
+}
+
+class Hasher : public ObjectWrap {
+public:
+    static Persistent<FunctionTemplate> constructor;
+
+    static void Init(Handle<Object> exports) {
+        Local<FunctionTemplate> tpl = FunctionTemplate::New(New);
+        tpl->SetClassName(String::NewSymbol("Hasher"));
+        tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+        NODE_SET_PROTOTYPE_METHOD(tpl, "update", Update);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "digest", Digest);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "reset", Reset);
+
+        constructor = Persistent<FunctionTemplate>::New(tpl);
+        exports->Set(String::NewSymbol("Hasher"), constructor->GetFunction());
+
+        Local<Array> names = Array::New();
+        for (uint32_t i = 0; hasher_algos[i].name; i++)
+            names->Set(i, String::New(hasher_algos[i].name));
+        exports->Set(String::NewSymbol("hasherAlgorithms"), names);
+    }
+
+private:
+    Hasher(const hasher_algo* algo) : algo(algo), ctx(malloc(algo->ctx_size)) {
+        algo->init(ctx);
+    }
+
+    ~Hasher() {
+        free(ctx);
+    }
+
+    const hasher_algo* algo;
+    void* ctx;
+
+    // new Hasher(algorithm)
+    static Handle<Value> New(const Arguments& args) {
+        HandleScope scope;
+
+        if (!args.IsConstructCall())
+            return except("Use the new operator to create a Hasher.");
+
+        if (args.Length() < 1 || !args[0]->IsString())
+            return except("Argument 1 should be an algorithm name.");
+
+        String::Utf8Value name(args[0]);
+        const hasher_algo* algo = hasher_find(*name);
+        if (!algo)
+            return except((std::string("Unknown hasher algorithm: ") + *name).c_str());
+
+        Hasher* self = new Hasher(algo);
+        self->Wrap(args.This());
+        args.This()->Set(String::NewSymbol("algorithm"), String::New(algo->name));
+        args.This()->Set(String::NewSymbol("digestSize"), Number::New(algo->digest_size));
+        return args.This();
+    }
+
+    // update(buffer): hashes the chunk where it lies, returns this for chaining
+    static Handle<Value> Update(const Arguments& args) {
+        HandleScope scope;
+
+        if (args.Length() < 1)
+            return except("You must provide one argument.");
+
+        Local<Object> target = args[0]->ToObject();
+
+        if(!Buffer::HasInstance(target))
+            return except("Argument should be a buffer object.");
+
+        Hasher* self = ObjectWrap::Unwrap<Hasher>(args.This());
+        self->algo->update(self->ctx, Buffer::Data(target), Buffer::Length(target));
+
+        return scope.Close(args.This());
+    }
+
+    // digest(): hash of everything since creation or the last digest()/reset()
+    static Handle<Value> Digest(const Arguments& args) {
+        HandleScope scope;
+
+        Hasher* self = ObjectWrap::Unwrap<Hasher>(args.This());
+        char output[64];
+        self->algo->close(self->ctx, output);
+
+        Buffer* buff = Buffer::New(output, self->algo->digest_size);
+        return scope.Close(buff->handle_);
+    }
+
+    // reset(): drop any data fed so far
+    static Handle<Value> Reset(const Arguments& args) {
+        HandleScope scope;
+
+        Hasher* self = ObjectWrap::Unwrap<Hasher>(args.This());
+        self->algo->init(self->ctx);
+
+        return scope.Close(args.This());
+    }
+};
+
+Persistent<FunctionTemplate> Hasher::constructor;
+
 void init(Handle<Object> exports) {
     exports->Set(String::NewSymbol("quark"), FunctionTemplate::New(quark)->GetFunction());
     exports->Set(String::NewSymbol("x11"), FunctionTemplate::New(x11)->GetFunction());
@@ -675,6 +2136,7 @@ void init(Handle<Object> exports) {
     exports->Set(String::NewSymbol("scryptn"), FunctionTemplate::New(scryptn)->GetFunction());
     exports->Set(String::NewSymbol("scryptjane"), FunctionTemplate::New(scryptjane)->GetFunction());
     exports->Set(String::NewSymbol("keccak"), FunctionTemplate::New(keccak)->GetFunction());
+    exports->Set(String::NewSymbol("keccakBatch"), FunctionTemplate::New(keccakBatch)->GetFunction());
     exports->Set(String::NewSymbol("bcrypt"), FunctionTemplate::New(bcrypt)->GetFunction());
     exports->Set(String::NewSymbol("skein"), FunctionTemplate::New(skein)->GetFunction());
     exports->Set(String::NewSymbol("groestl"), FunctionTemplate::New(groestl)->GetFunction());
@@ -689,10 +2151,62 @@ void init(Handle<Object> exports) {
 	exports->Set(String::NewSymbol("x13sm3"), FunctionTemplate::New(x13sm3)->GetFunction());
 	exports->Set(String::NewSymbol("tribus"), FunctionTemplate::New(tribus)->GetFunction());
     exports->Set(String::NewSymbol("boolberry"), FunctionTemplate::New(boolberry)->GetFunction());
+    exports->Set(String::NewSymbol("boolberryBatch"), FunctionTemplate::New(boolberryBatch)->GetFunction());
+    BoolberryScratchpad::Init(exports);
     exports->Set(String::NewSymbol("nist5"), FunctionTemplate::New(nist5)->GetFunction());
     exports->Set(String::NewSymbol("sha1"), FunctionTemplate::New(sha1)->GetFunction());
     exports->Set(String::NewSymbol("x15"), FunctionTemplate::New(x15)->GetFunction());
     exports->Set(String::NewSymbol("fresh"), FunctionTemplate::New(fresh)->GetFunction());
+    exports->Set(String::NewSymbol("lyra2rev2"), FunctionTemplate::New(lyra2rev2)->GetFunction());
+    exports->Set(String::NewSymbol("lyra2z"), FunctionTemplate::New(lyra2z)->GetFunction());
+    exports->Set(String::NewSymbol("yescrypt"), FunctionTemplate::New(yescrypt)->GetFunction());
+    exports->Set(String::NewSymbol("yescryptBatch"), FunctionTemplate::New(yescryptBatch)->GetFunction());
+    exports->Set(String::NewSymbol("neoscrypt"), FunctionTemplate::New(neoscrypt)->GetFunction());
+    exports->Set(String::NewSymbol("neoscryptBatch"), FunctionTemplate::New(neoscryptBatch)->GetFunction());
+    exports->Set(String::NewSymbol("argon2"), FunctionTemplate::New(argon2)->GetFunction());
+    exports->Set(String::NewSymbol("hodlPrepare"), FunctionTemplate::New(hodlPrepare)->GetFunction());
+    exports->Set(String::NewSymbol("hodl"), FunctionTemplate::New(hodl)->GetFunction());
+    exports->Set(String::NewSymbol("axiom"), FunctionTemplate::New(axiom)->GetFunction());
+    exports->Set(String::NewSymbol("axiomAsync"), FunctionTemplate::New(axiomAsync)->GetFunction());
+    exports->Set(String::NewSymbol("xevan"), FunctionTemplate::New(xevan)->GetFunction());
+    exports->Set(String::NewSymbol("quarkBatch"), FunctionTemplate::New(quarkBatch)->GetFunction());
+    exports->Set(String::NewSymbol("hmq1725"), FunctionTemplate::New(hmq1725)->GetFunction());
+    exports->Set(String::NewSymbol("hmq1725Batch"), FunctionTemplate::New(hmq1725Batch)->GetFunction());
+    exports->Set(String::NewSymbol("m7m"), FunctionTemplate::New(m7m)->GetFunction());
+    exports->Set(String::NewSymbol("lbry"), FunctionTemplate::New(lbry)->GetFunction());
+    exports->Set(String::NewSymbol("x14"), FunctionTemplate::New(x14)->GetFunction());
+    exports->Set(String::NewSymbol("x14Batch"), FunctionTemplate::New(x14Batch)->GetFunction());
+    exports->Set(String::NewSymbol("x17"), FunctionTemplate::New(x17)->GetFunction());
+    exports->Set(String::NewSymbol("x17Batch"), FunctionTemplate::New(x17Batch)->GetFunction());
+    exports->Set(String::NewSymbol("x13sm3Batch"), FunctionTemplate::New(x13sm3Batch)->GetFunction());
+    exports->Set(String::NewSymbol("skunk"), FunctionTemplate::New(skunk)->GetFunction());
+    exports->Set(String::NewSymbol("x11gost"), FunctionTemplate::New(x11gost)->GetFunction());
+    exports->Set(String::NewSymbol("zr5"), FunctionTemplate::New(zr5)->GetFunction());
+    exports->Set(String::NewSymbol("zr5Batch"), FunctionTemplate::New(zr5Batch)->GetFunction());
+    exports->Set(String::NewSymbol("drop"), FunctionTemplate::New(drop)->GetFunction());
+    exports->Set(String::NewSymbol("dropBatch"), FunctionTemplate::New(dropBatch)->GetFunction());
+    exports->Set(String::NewSymbol("pluck"), FunctionTemplate::New(pluck)->GetFunction());
+    exports->Set(String::NewSymbol("pluckBatch"), FunctionTemplate::New(pluckBatch)->GetFunction());
+    exports->Set(String::NewSymbol("sha256d"), FunctionTemplate::New(sha256d)->GetFunction());
+    exports->Set(String::NewSymbol("sha256dBatch"), FunctionTemplate::New(sha256dBatch)->GetFunction());
+    exports->Set(String::NewSymbol("sha256t"), FunctionTemplate::New(sha256t)->GetFunction());
+    exports->Set(String::NewSymbol("sha256tBatch"), FunctionTemplate::New(sha256tBatch)->GetFunction());
+    exports->Set(String::NewSymbol("phi1612"), FunctionTemplate::New(phi1612)->GetFunction());
+    exports->Set(String::NewSymbol("phi1612Batch"), FunctionTemplate::New(phi1612Batch)->GetFunction());
+    exports->Set(String::NewSymbol("c11"), FunctionTemplate::New(c11)->GetFunction());
+    exports->Set(String::NewSymbol("c11Batch"), FunctionTemplate::New(c11Batch)->GetFunction());
+    exports->Set(String::NewSymbol("x11evo"), FunctionTemplate::New(x11evo)->GetFunction());
+    exports->Set(String::NewSymbol("x11evoBatch"), FunctionTemplate::New(x11evoBatch)->GetFunction());
+    exports->Set(String::NewSymbol("veltor"), FunctionTemplate::New(veltor)->GetFunction());
+    exports->Set(String::NewSymbol("veltorBatch"), FunctionTemplate::New(veltorBatch)->GetFunction());
+    exports->Set(String::NewSymbol("hefty1Batch"), FunctionTemplate::New(hefty1Batch)->GetFunction());
+    exports->Set(String::NewSymbol("heavy"), FunctionTemplate::New(heavy)->GetFunction());
+    exports->Set(String::NewSymbol("heavyBatch"), FunctionTemplate::New(heavyBatch)->GetFunction());
+    exports->Set(String::NewSymbol("bastion"), FunctionTemplate::New(bastion)->GetFunction());
+    exports->Set(String::NewSymbol("bastionBatch"), FunctionTemplate::New(bastionBatch)->GetFunction());
+    Hasher::Init(exports);
+    Sha256Midstate::Init(exports, "Sha256Midstate");
+    VeltorMidstate::Init(exports, "VeltorMidstate");
 }
 
 NODE_MODULE(multihashing, init)
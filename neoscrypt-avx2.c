@@ -0,0 +1,169 @@
+/*
+ * NeoScrypt block mixing for two hashes at once with AVX2, selected at run
+ * time by neoscrypt.c.  Row k of a block holds the first hash's row in the
+ * low half of the register and the second hash's in the high half, so the
+ * SSE2 round code carries over lane for lane; only the V lookups differ.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+#define NEOSCRYPT_N             128
+#define NEOSCRYPT_ROUNDS        20
+
+#define ROTL32_X8(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+static inline __m256i rotl16_x8(__m256i x)
+{
+    const __m256i r16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                        13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    return _mm256_shuffle_epi8(x, r16);
+}
+
+static inline __m256i rotl8_x8(__m256i x)
+{
+    const __m256i r8 = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                                       14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    return _mm256_shuffle_epi8(x, r8);
+}
+
+/* ChaCha20 on Z and Salsa20 on diagonal order X in one loop, see neoscrypt.c */
+static inline void chacha_salsa_x2(__m256i* Z, __m256i* X)
+{
+    __m256i a = Z[0], b = Z[1], c = Z[2], d = Z[3];
+    __m256i X0 = X[0], X1 = X[1], X2 = X[2], X3 = X[3];
+    int rounds;
+
+    for (rounds = NEOSCRYPT_ROUNDS; rounds; rounds -= 2) {
+        a = _mm256_add_epi32(a, b); d = rotl16_x8(_mm256_xor_si256(d, a));
+        X1 = _mm256_xor_si256(X1, ROTL32_X8(_mm256_add_epi32(X0, X3), 7));
+        c = _mm256_add_epi32(c, d); b = ROTL32_X8(_mm256_xor_si256(b, c), 12);
+        X2 = _mm256_xor_si256(X2, ROTL32_X8(_mm256_add_epi32(X1, X0), 9));
+        a = _mm256_add_epi32(a, b); d = rotl8_x8(_mm256_xor_si256(d, a));
+        X3 = _mm256_xor_si256(X3, ROTL32_X8(_mm256_add_epi32(X2, X1), 13));
+        c = _mm256_add_epi32(c, d); b = ROTL32_X8(_mm256_xor_si256(b, c), 7);
+        X0 = _mm256_xor_si256(X0, ROTL32_X8(_mm256_add_epi32(X3, X2), 18));
+
+        b = _mm256_shuffle_epi32(b, 0x39);
+        c = _mm256_shuffle_epi32(c, 0x4E);
+        d = _mm256_shuffle_epi32(d, 0x93);
+        X1 = _mm256_shuffle_epi32(X1, 0x93);
+        X2 = _mm256_shuffle_epi32(X2, 0x4E);
+        X3 = _mm256_shuffle_epi32(X3, 0x39);
+
+        a = _mm256_add_epi32(a, b); d = rotl16_x8(_mm256_xor_si256(d, a));
+        X3 = _mm256_xor_si256(X3, ROTL32_X8(_mm256_add_epi32(X0, X1), 7));
+        c = _mm256_add_epi32(c, d); b = ROTL32_X8(_mm256_xor_si256(b, c), 12);
+        X2 = _mm256_xor_si256(X2, ROTL32_X8(_mm256_add_epi32(X3, X0), 9));
+        a = _mm256_add_epi32(a, b); d = rotl8_x8(_mm256_xor_si256(d, a));
+        X1 = _mm256_xor_si256(X1, ROTL32_X8(_mm256_add_epi32(X2, X3), 13));
+        c = _mm256_add_epi32(c, d); b = ROTL32_X8(_mm256_xor_si256(b, c), 7);
+        X0 = _mm256_xor_si256(X0, ROTL32_X8(_mm256_add_epi32(X1, X2), 18));
+
+        b = _mm256_shuffle_epi32(b, 0x93);
+        c = _mm256_shuffle_epi32(c, 0x4E);
+        d = _mm256_shuffle_epi32(d, 0x39);
+        X1 = _mm256_shuffle_epi32(X1, 0x39);
+        X2 = _mm256_shuffle_epi32(X2, 0x4E);
+        X3 = _mm256_shuffle_epi32(X3, 0x93);
+    }
+
+    Z[0] = _mm256_add_epi32(Z[0], a);
+    Z[1] = _mm256_add_epi32(Z[1], b);
+    Z[2] = _mm256_add_epi32(Z[2], c);
+    Z[3] = _mm256_add_epi32(Z[3], d);
+    X[0] = _mm256_add_epi32(X[0], X0);
+    X[1] = _mm256_add_epi32(X[1], X1);
+    X[2] = _mm256_add_epi32(X[2], X2);
+    X[3] = _mm256_add_epi32(X[3], X3);
+}
+
+static inline void block_xor_x2(__m256i* D, const __m256i* S)
+{
+    D[0] = _mm256_xor_si256(D[0], S[0]);
+    D[1] = _mm256_xor_si256(D[1], S[1]);
+    D[2] = _mm256_xor_si256(D[2], S[2]);
+    D[3] = _mm256_xor_si256(D[3], S[3]);
+}
+
+/* The low half indexes V with the first hash's integerify, the high half with the second's. */
+static inline void block_xor_v_x2(__m256i* D, const __m256i* V, uint32_t x3w0, uint32_t x3w4)
+{
+    const __m256i* V0 = &V[(x3w0 & (NEOSCRYPT_N - 1)) * 16];
+    const __m256i* V1 = &V[(x3w4 & (NEOSCRYPT_N - 1)) * 16];
+    int k;
+
+    for (k = 0; k < 16; k++)
+        D[k] = _mm256_xor_si256(D[k], _mm256_blend_epi32(V0[k], V1[k], 0xF0));
+}
+
+static void interleave(__m256i* D, const uint32_t* A, const uint32_t* B)
+{
+    int k;
+
+    for (k = 0; k < 16; k++)
+        D[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_load_si128((const __m128i*) A + k)),
+                                       _mm_load_si128((const __m128i*) B + k), 1);
+}
+
+static void deinterleave(uint32_t* A, uint32_t* B, const __m256i* S)
+{
+    int k;
+
+    for (k = 0; k < 16; k++) {
+        _mm_store_si128((__m128i*) A + k, _mm256_castsi256_si128(S[k]));
+        _mm_store_si128((__m128i*) B + k, _mm256_extracti128_si256(S[k], 1));
+    }
+}
+
+/*
+ * Same contract as neoscrypt_mix_sse2() for two hashes; V is twice the size.
+ * Blocks are kept in place here (a rename would differ per block pair), so
+ * Xb and Xc are swapped after each mix.
+ */
+void neoscrypt_mix_x2_avx2(uint32_t* Z0, uint32_t* X0, uint32_t* Z1, uint32_t* X1, void* Vw)
+{
+    __m256i Z[16], X[16];
+    __m256i* VZ = (__m256i*) Vw;
+    __m256i* VX = VZ + NEOSCRYPT_N * 16;
+    uint32_t i, k;
+
+    interleave(Z, Z0, Z1);
+    interleave(X, X0, X1);
+
+    for (i = 0; i < 2 * NEOSCRYPT_N; i++) {
+        if (i < NEOSCRYPT_N) {
+            memcpy(&VZ[i * 16], Z, sizeof Z);
+            memcpy(&VX[i * 16], X, sizeof X);
+        } else {
+            block_xor_v_x2(Z, VZ, _mm256_extract_epi32(Z[12], 0), _mm256_extract_epi32(Z[12], 4));
+            block_xor_v_x2(X, VX, _mm256_extract_epi32(X[12], 0), _mm256_extract_epi32(X[12], 4));
+        }
+        block_xor_x2(&Z[0], &Z[12]); block_xor_x2(&X[0], &X[12]); chacha_salsa_x2(&Z[0], &X[0]);
+        block_xor_x2(&Z[4], &Z[0]);  block_xor_x2(&X[4], &X[0]);  chacha_salsa_x2(&Z[4], &X[4]);
+        block_xor_x2(&Z[8], &Z[4]);  block_xor_x2(&X[8], &X[4]);  chacha_salsa_x2(&Z[8], &X[8]);
+        block_xor_x2(&Z[12], &Z[8]); block_xor_x2(&X[12], &X[8]); chacha_salsa_x2(&Z[12], &X[12]);
+        for (k = 4; k < 8; k++) {
+            __m256i t = Z[k]; Z[k] = Z[k + 4]; Z[k + 4] = t;
+            t = X[k]; X[k] = X[k + 4]; X[k + 4] = t;
+        }
+    }
+
+    deinterleave(Z0, Z1, Z);
+    deinterleave(X0, X1, X);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
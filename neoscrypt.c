@@ -0,0 +1,754 @@
+#include "neoscrypt.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "cpu_features.h"
+#include "scratch_pool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define NEOSCRYPT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(NEOSCRYPT_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define NEOSCRYPT_AVX2 1
+#endif
+
+/* The default profile 0x80000620: N = 128, r = 2, ChaCha and Salsa, FastKDF */
+#define NEOSCRYPT_N             128
+#define NEOSCRYPT_R             2
+#define NEOSCRYPT_ROUNDS        20
+#define NEOSCRYPT_BLOCK_WORDS   16
+#define NEOSCRYPT_X_WORDS       (2 * NEOSCRYPT_R * NEOSCRYPT_BLOCK_WORDS)
+#define NEOSCRYPT_X_SIZE        (4 * NEOSCRYPT_X_WORDS)
+
+/* V for both SMix passes of two interleaved hashes, the most any backend needs */
+#define NEOSCRYPT_SCRATCH_SIZE  (4 * NEOSCRYPT_N * NEOSCRYPT_X_SIZE)
+
+#define FASTKDF_BUFFER_SIZE     256U
+#define FASTKDF_ITERATIONS      32
+#define FASTKDF_LANES           4
+#define PRF_INPUT_SIZE          64U
+#define PRF_KEY_SIZE            32U
+#define PRF_OUTPUT_SIZE         32U
+
+#define ROTL32(a, b) (((a) << (b)) | ((a) >> (32 - (b))))
+#define ROTR32(a, b) (((a) >> (b)) | ((a) << (32 - (b))))
+
+/* BLAKE2s */
+
+static const uint32_t blake2s_IV[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+static const uint8_t blake2s_sigma[10][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+};
+
+/* Parameter block word 0: 32 byte digest, 32 byte key, fanout 1, depth 1 */
+#define BLAKE2S_PARAM0          0x01012020U
+
+#define B2S_ROUND(G, r) \
+    G(r, 0, v[ 0], v[ 4], v[ 8], v[12]); \
+    G(r, 1, v[ 1], v[ 5], v[ 9], v[13]); \
+    G(r, 2, v[ 2], v[ 6], v[10], v[14]); \
+    G(r, 3, v[ 3], v[ 7], v[11], v[15]); \
+    G(r, 4, v[ 0], v[ 5], v[10], v[15]); \
+    G(r, 5, v[ 1], v[ 6], v[11], v[12]); \
+    G(r, 6, v[ 2], v[ 7], v[ 8], v[13]); \
+    G(r, 7, v[ 3], v[ 4], v[ 9], v[14]);
+
+#define B2S_ROUNDS(G) \
+    B2S_ROUND(G, 0) B2S_ROUND(G, 1) B2S_ROUND(G, 2) B2S_ROUND(G, 3) B2S_ROUND(G, 4) \
+    B2S_ROUND(G, 5) B2S_ROUND(G, 6) B2S_ROUND(G, 7) B2S_ROUND(G, 8) B2S_ROUND(G, 9)
+
+static void blake2s_compress(uint32_t h[8], const uint32_t m[16], uint32_t t, uint32_t f)
+{
+    uint32_t v[16];
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        v[i] = h[i];
+        v[i + 8] = blake2s_IV[i];
+    }
+    v[12] ^= t;
+    v[14] ^= f;
+
+#define G(r, i, a, b, c, d) \
+    a = a + b + m[blake2s_sigma[r][2 * i + 0]]; \
+    d = ROTR32(d ^ a, 16); \
+    c = c + d; \
+    b = ROTR32(b ^ c, 12); \
+    a = a + b + m[blake2s_sigma[r][2 * i + 1]]; \
+    d = ROTR32(d ^ a, 8); \
+    c = c + d; \
+    b = ROTR32(b ^ c, 7);
+    B2S_ROUNDS(G)
+#undef G
+
+    for (i = 0; i < 8; i++)
+        h[i] ^= v[i] ^ v[i + 8];
+}
+
+/*
+ * The FastKDF PRF, keyed BLAKE2s of one 64 byte block.  That is always two
+ * compressions: the zero padded key block, then the final input block.
+ */
+static void neoscrypt_prf(uint8_t* out, const uint8_t* in, const uint8_t* key)
+{
+    uint32_t h[8], m[16];
+
+    memcpy(h, blake2s_IV, sizeof h);
+    h[0] ^= BLAKE2S_PARAM0;
+
+    memcpy(m, key, PRF_KEY_SIZE);
+    memset(m + 8, 0, PRF_KEY_SIZE);
+    blake2s_compress(h, m, 64, 0);
+
+    memcpy(m, in, PRF_INPUT_SIZE);
+    blake2s_compress(h, m, 128, ~0U);
+
+    memcpy(out, h, PRF_OUTPUT_SIZE);
+}
+
+#ifdef NEOSCRYPT_SSE2
+
+/* a b c d rows of four lanes each become four lanes of a b c d, in place */
+#define TRANSPOSE4(a, b, c, d) do { \
+    __m128i t0 = _mm_unpacklo_epi32(a, b); \
+    __m128i t1 = _mm_unpacklo_epi32(c, d); \
+    __m128i t2 = _mm_unpackhi_epi32(a, b); \
+    __m128i t3 = _mm_unpackhi_epi32(c, d); \
+    a = _mm_unpacklo_epi64(t0, t1); \
+    b = _mm_unpackhi_epi64(t0, t1); \
+    c = _mm_unpacklo_epi64(t2, t3); \
+    d = _mm_unpackhi_epi64(t2, t3); \
+} while (0)
+
+#define ROTR32_X4(x, n) _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - (n)))
+#define ROTR16_X4(x)    _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xB1), 0xB1)
+
+static void blake2s_compress_x4(__m128i h[8], const __m128i m[16], uint32_t t, uint32_t f)
+{
+    __m128i v[16];
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        v[i] = h[i];
+        v[i + 8] = _mm_set1_epi32(blake2s_IV[i]);
+    }
+    v[12] = _mm_xor_si128(v[12], _mm_set1_epi32(t));
+    v[14] = _mm_xor_si128(v[14], _mm_set1_epi32(f));
+
+#define G(r, i, a, b, c, d) \
+    a = _mm_add_epi32(_mm_add_epi32(a, b), m[blake2s_sigma[r][2 * i + 0]]); \
+    d = ROTR16_X4(_mm_xor_si128(d, a)); \
+    c = _mm_add_epi32(c, d); \
+    b = ROTR32_X4(_mm_xor_si128(b, c), 12); \
+    a = _mm_add_epi32(_mm_add_epi32(a, b), m[blake2s_sigma[r][2 * i + 1]]); \
+    d = ROTR32_X4(_mm_xor_si128(d, a), 8); \
+    c = _mm_add_epi32(c, d); \
+    b = ROTR32_X4(_mm_xor_si128(b, c), 7);
+    B2S_ROUNDS(G)
+#undef G
+
+    for (i = 0; i < 8; i++)
+        h[i] = _mm_xor_si128(h[i], _mm_xor_si128(v[i], v[i + 8]));
+}
+
+/* Four independent PRF calls, one per 32-bit lane. */
+static void neoscrypt_prf_x4(uint8_t* const out[4], const uint8_t* const in[4], const uint8_t* const key[4])
+{
+    __m128i h[8], m[16];
+    int i;
+
+    for (i = 0; i < 8; i++)
+        h[i] = _mm_set1_epi32(blake2s_IV[i]);
+    h[0] = _mm_xor_si128(h[0], _mm_set1_epi32(BLAKE2S_PARAM0));
+
+    for (i = 0; i < 8; i += 4) {
+        m[i + 0] = _mm_loadu_si128((const __m128i*) (key[0] + 4 * i));
+        m[i + 1] = _mm_loadu_si128((const __m128i*) (key[1] + 4 * i));
+        m[i + 2] = _mm_loadu_si128((const __m128i*) (key[2] + 4 * i));
+        m[i + 3] = _mm_loadu_si128((const __m128i*) (key[3] + 4 * i));
+        TRANSPOSE4(m[i + 0], m[i + 1], m[i + 2], m[i + 3]);
+    }
+    for (i = 8; i < 16; i++)
+        m[i] = _mm_setzero_si128();
+    blake2s_compress_x4(h, m, 64, 0);
+
+    for (i = 0; i < 16; i += 4) {
+        m[i + 0] = _mm_loadu_si128((const __m128i*) (in[0] + 4 * i));
+        m[i + 1] = _mm_loadu_si128((const __m128i*) (in[1] + 4 * i));
+        m[i + 2] = _mm_loadu_si128((const __m128i*) (in[2] + 4 * i));
+        m[i + 3] = _mm_loadu_si128((const __m128i*) (in[3] + 4 * i));
+        TRANSPOSE4(m[i + 0], m[i + 1], m[i + 2], m[i + 3]);
+    }
+    blake2s_compress_x4(h, m, 128, ~0U);
+
+    for (i = 0; i < 8; i += 4) {
+        TRANSPOSE4(h[i + 0], h[i + 1], h[i + 2], h[i + 3]);
+        _mm_storeu_si128((__m128i*) (out[0] + 4 * i), h[i + 0]);
+        _mm_storeu_si128((__m128i*) (out[1] + 4 * i), h[i + 1]);
+        _mm_storeu_si128((__m128i*) (out[2] + 4 * i), h[i + 2]);
+        _mm_storeu_si128((__m128i*) (out[3] + 4 * i), h[i + 3]);
+    }
+}
+
+#else
+
+static void neoscrypt_prf_x4(uint8_t* const out[4], const uint8_t* const in[4], const uint8_t* const key[4])
+{
+    int l;
+
+    for (l = 0; l < 4; l++)
+        neoscrypt_prf(out[l], in[l], key[l]);
+}
+
+#endif
+
+/* FastKDF */
+
+typedef struct {
+    /* password buffer followed by a copy of its first PRF input */
+    uint8_t A[FASTKDF_BUFFER_SIZE + PRF_INPUT_SIZE];
+    /* salt buffer followed by a copy of its first PRF key */
+    uint8_t B[FASTKDF_BUFFER_SIZE + PRF_KEY_SIZE];
+    uint8_t prf[PRF_OUTPUT_SIZE];
+    uint32_t bufptr;
+} fastkdf_state;
+
+/* Fills the buffer with src repeated, then mirrors its head past the end. */
+static void fastkdf_fill(uint8_t* buf, uint32_t tail, const uint8_t* src, uint32_t len)
+{
+    uint32_t i;
+
+    if (len > FASTKDF_BUFFER_SIZE)
+        len = FASTKDF_BUFFER_SIZE;
+    if (!len)
+        memset(buf, 0, FASTKDF_BUFFER_SIZE);
+    for (i = 0; len && i < FASTKDF_BUFFER_SIZE; i += len)
+        memcpy(buf + i, src, FASTKDF_BUFFER_SIZE - i < len ? FASTKDF_BUFFER_SIZE - i : len);
+    memcpy(buf + FASTKDF_BUFFER_SIZE, buf, tail);
+}
+
+static void fastkdf_init(fastkdf_state* st, const uint8_t* password, uint32_t password_len, const uint8_t* salt, uint32_t salt_len)
+{
+    fastkdf_fill(st->A, PRF_INPUT_SIZE, password, password_len);
+    fastkdf_fill(st->B, PRF_KEY_SIZE, salt, salt_len);
+    st->bufptr = 0;
+}
+
+/* Folds the last PRF output into the salt buffer and moves the pointer. */
+static void fastkdf_step(fastkdf_state* st)
+{
+    uint32_t i, bufptr = 0;
+
+    for (i = 0; i < PRF_OUTPUT_SIZE; i++)
+        bufptr += st->prf[i];
+    bufptr &= FASTKDF_BUFFER_SIZE - 1;
+
+    for (i = 0; i < PRF_OUTPUT_SIZE; i++)
+        st->B[bufptr + i] ^= st->prf[i];
+
+    /* Head modified, tail updated */
+    if (bufptr < PRF_KEY_SIZE)
+        memcpy(&st->B[FASTKDF_BUFFER_SIZE + bufptr], &st->B[bufptr], PRF_KEY_SIZE - bufptr);
+
+    /* Tail modified, head updated */
+    if (FASTKDF_BUFFER_SIZE - bufptr < PRF_OUTPUT_SIZE)
+        memcpy(&st->B[0], &st->B[FASTKDF_BUFFER_SIZE], PRF_OUTPUT_SIZE - (FASTKDF_BUFFER_SIZE - bufptr));
+
+    st->bufptr = bufptr;
+}
+
+static void fastkdf_finish(fastkdf_state* st, uint8_t* output, uint32_t output_len)
+{
+    uint32_t i, a = FASTKDF_BUFFER_SIZE - st->bufptr;
+    uint8_t* B = &st->B[st->bufptr];
+
+    if (a >= output_len) {
+        for (i = 0; i < output_len; i++)
+            output[i] = B[i] ^ st->A[i];
+    } else {
+        for (i = 0; i < a; i++)
+            output[i] = B[i] ^ st->A[i];
+        for (; i < output_len; i++)
+            output[i] = st->B[i - a] ^ st->A[i];
+    }
+}
+
+static void neoscrypt_fastkdf(const uint8_t* password, uint32_t password_len, const uint8_t* salt, uint32_t salt_len,
+                              uint8_t* output, uint32_t output_len)
+{
+    fastkdf_state st;
+    int i;
+
+    fastkdf_init(&st, password, password_len, salt, salt_len);
+    for (i = 0; i < FASTKDF_ITERATIONS; i++) {
+        neoscrypt_prf(st.prf, &st.A[st.bufptr], &st.B[st.bufptr]);
+        fastkdf_step(&st);
+    }
+    fastkdf_finish(&st, output, output_len);
+}
+
+/*
+ * FastKDF of four headers at once.  The iteration count does not depend on
+ * the data, only the buffer offsets do, so the PRFs of all lanes run as one
+ * SIMD BLAKE2s.  Unused lanes repeat lane 0.
+ */
+static void neoscrypt_fastkdf_x4(const uint8_t* const password[4], const uint32_t password_len[4],
+                                 const uint8_t* const salt[4], const uint32_t salt_len[4],
+                                 uint8_t* const output[4], uint32_t output_len, int lanes)
+{
+    fastkdf_state st[FASTKDF_LANES];
+    const uint8_t* in[FASTKDF_LANES];
+    const uint8_t* key[FASTKDF_LANES];
+    uint8_t* out[FASTKDF_LANES];
+    int i, l;
+
+    for (l = 0; l < lanes; l++)
+        fastkdf_init(&st[l], password[l], password_len[l], salt[l], salt_len[l]);
+    for (; l < FASTKDF_LANES; l++)
+        st[l] = st[0];
+
+    for (i = 0; i < FASTKDF_ITERATIONS; i++) {
+        for (l = 0; l < FASTKDF_LANES; l++) {
+            in[l] = &st[l].A[st[l].bufptr];
+            key[l] = &st[l].B[st[l].bufptr];
+            out[l] = st[l].prf;
+        }
+        neoscrypt_prf_x4(out, in, key);
+        for (l = 0; l < FASTKDF_LANES; l++)
+            fastkdf_step(&st[l]);
+    }
+
+    for (l = 0; l < lanes; l++)
+        fastkdf_finish(&st[l], output[l], output_len);
+}
+
+/* Block mixing */
+
+static void neoscrypt_salsa(uint32_t* X)
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, t;
+    int rounds;
+
+    x0 = X[0];   x1 = X[1];   x2 = X[2];   x3 = X[3];
+    x4 = X[4];   x5 = X[5];   x6 = X[6];   x7 = X[7];
+    x8 = X[8];   x9 = X[9];  x10 = X[10]; x11 = X[11];
+   x12 = X[12]; x13 = X[13]; x14 = X[14]; x15 = X[15];
+
+#define quarter(a, b, c, d) \
+    t = a + d; t = ROTL32(t,  7); b ^= t; \
+    t = b + a; t = ROTL32(t,  9); c ^= t; \
+    t = c + b; t = ROTL32(t, 13); d ^= t; \
+    t = d + c; t = ROTL32(t, 18); a ^= t;
+
+    for (rounds = NEOSCRYPT_ROUNDS; rounds; rounds -= 2) {
+        quarter( x0,  x4,  x8, x12);
+        quarter( x5,  x9, x13,  x1);
+        quarter(x10, x14,  x2,  x6);
+        quarter(x15,  x3,  x7, x11);
+        quarter( x0,  x1,  x2,  x3);
+        quarter( x5,  x6,  x7,  x4);
+        quarter(x10, x11,  x8,  x9);
+        quarter(x15, x12, x13, x14);
+    }
+
+    X[0] += x0;   X[1] += x1;   X[2] += x2;   X[3] += x3;
+    X[4] += x4;   X[5] += x5;   X[6] += x6;   X[7] += x7;
+    X[8] += x8;   X[9] += x9;  X[10] += x10; X[11] += x11;
+   X[12] += x12; X[13] += x13; X[14] += x14; X[15] += x15;
+
+#undef quarter
+}
+
+static void neoscrypt_chacha(uint32_t* X)
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, t;
+    int rounds;
+
+    x0 = X[0];   x1 = X[1];   x2 = X[2];   x3 = X[3];
+    x4 = X[4];   x5 = X[5];   x6 = X[6];   x7 = X[7];
+    x8 = X[8];   x9 = X[9];  x10 = X[10]; x11 = X[11];
+   x12 = X[12]; x13 = X[13]; x14 = X[14]; x15 = X[15];
+
+#define quarter(a, b, c, d) \
+    a += b; t = d ^ a; d = ROTL32(t, 16); \
+    c += d; t = b ^ c; b = ROTL32(t, 12); \
+    a += b; t = d ^ a; d = ROTL32(t,  8); \
+    c += d; t = b ^ c; b = ROTL32(t,  7);
+
+    for (rounds = NEOSCRYPT_ROUNDS; rounds; rounds -= 2) {
+        quarter( x0,  x4,  x8, x12);
+        quarter( x1,  x5,  x9, x13);
+        quarter( x2,  x6, x10, x14);
+        quarter( x3,  x7, x11, x15);
+        quarter( x0,  x5, x10, x15);
+        quarter( x1,  x6, x11, x12);
+        quarter( x2,  x7,  x8, x13);
+        quarter( x3,  x4,  x9, x14);
+    }
+
+    X[0] += x0;   X[1] += x1;   X[2] += x2;   X[3] += x3;
+    X[4] += x4;   X[5] += x5;   X[6] += x6;   X[7] += x7;
+    X[8] += x8;   X[9] += x9;  X[10] += x10; X[11] += x11;
+   X[12] += x12; X[13] += x13; X[14] += x14; X[15] += x15;
+
+#undef quarter
+}
+
+static void block_xor(uint32_t* dst, const uint32_t* src, int words)
+{
+    int i;
+
+    for (i = 0; i < words; i++)
+        dst[i] ^= src[i];
+}
+
+/*
+ * The r = 2 NeoScrypt block mixer:
+ *   Xa ^= Xd; M(Xa); Xb ^= Xa; M(Xb); Xc ^= Xb; M(Xc); Xd ^= Xc; M(Xd);
+ *   then Xb and Xc trade places.
+ */
+static void neoscrypt_blkmix(uint32_t* X, void (*mix)(uint32_t*))
+{
+    uint32_t t[NEOSCRYPT_BLOCK_WORDS];
+
+    block_xor(&X[0], &X[48], NEOSCRYPT_BLOCK_WORDS);
+    mix(&X[0]);
+    block_xor(&X[16], &X[0], NEOSCRYPT_BLOCK_WORDS);
+    mix(&X[16]);
+    block_xor(&X[32], &X[16], NEOSCRYPT_BLOCK_WORDS);
+    mix(&X[32]);
+    block_xor(&X[48], &X[32], NEOSCRYPT_BLOCK_WORDS);
+    mix(&X[48]);
+
+    memcpy(t, &X[16], sizeof t);
+    memcpy(&X[16], &X[32], sizeof t);
+    memcpy(&X[32], t, sizeof t);
+}
+
+static void neoscrypt_smix(uint32_t* X, uint32_t* V, void (*mix)(uint32_t*))
+{
+    uint32_t i, j;
+
+    for (i = 0; i < NEOSCRYPT_N; i++) {
+        memcpy(&V[i * NEOSCRYPT_X_WORDS], X, NEOSCRYPT_X_SIZE);
+        neoscrypt_blkmix(X, mix);
+    }
+    for (i = 0; i < NEOSCRYPT_N; i++) {
+        j = X[48] & (NEOSCRYPT_N - 1);
+        block_xor(X, &V[j * NEOSCRYPT_X_WORDS], NEOSCRYPT_X_WORDS);
+        neoscrypt_blkmix(X, mix);
+    }
+}
+
+/* Portable core: Z is the ChaCha copy of X, both in natural word order. */
+static void neoscrypt_mix_scalar(uint32_t* Z, uint32_t* X, void* V)
+{
+    neoscrypt_smix(Z, (uint32_t*) V, neoscrypt_chacha);
+    neoscrypt_smix(X, (uint32_t*) V, neoscrypt_salsa);
+}
+
+#ifdef NEOSCRYPT_SSE2
+
+/*
+ * The SIMD cores keep Salsa blocks in diagonal order, rows (0 5 10 15),
+ * (4 9 14 3), (8 13 2 7) and (12 1 6 11), so that a column step is four
+ * vector operations.  Word 0 stays in place, so integerify is unchanged.
+ */
+static const uint8_t salsa_diagonal[16] = { 0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1, 6, 11 };
+
+static void salsa_tangle(uint32_t* X)
+{
+    uint32_t t[NEOSCRYPT_BLOCK_WORDS];
+    int b, i;
+
+    for (b = 0; b < NEOSCRYPT_X_WORDS; b += NEOSCRYPT_BLOCK_WORDS) {
+        for (i = 0; i < 16; i++)
+            t[i] = X[b + salsa_diagonal[i]];
+        memcpy(&X[b], t, sizeof t);
+    }
+}
+
+static void salsa_untangle(uint32_t* X)
+{
+    uint32_t t[NEOSCRYPT_BLOCK_WORDS];
+    int b, i;
+
+    for (b = 0; b < NEOSCRYPT_X_WORDS; b += NEOSCRYPT_BLOCK_WORDS) {
+        for (i = 0; i < 16; i++)
+            t[salsa_diagonal[i]] = X[b + i];
+        memcpy(&X[b], t, sizeof t);
+    }
+}
+
+#define ROTL32_X4(x, n) _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+#define ROTL16_X4(x)    _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xB1), 0xB1)
+
+/*
+ * One double round count of ChaCha20 on a natural order block and Salsa20 on
+ * a diagonal order block.  Each alone is a single dependency chain; the two
+ * SMix passes of a hash are independent, so running them in one loop keeps
+ * twice as many instructions in flight.
+ */
+static inline void chacha_salsa_sse2(__m128i* Z, __m128i* X)
+{
+    __m128i a = Z[0], b = Z[1], c = Z[2], d = Z[3];
+    __m128i X0 = X[0], X1 = X[1], X2 = X[2], X3 = X[3];
+    int rounds;
+
+    for (rounds = NEOSCRYPT_ROUNDS; rounds; rounds -= 2) {
+        /* ChaCha columns, Salsa columns */
+        a = _mm_add_epi32(a, b); d = ROTL16_X4(_mm_xor_si128(d, a));
+        X1 = _mm_xor_si128(X1, ROTL32_X4(_mm_add_epi32(X0, X3), 7));
+        c = _mm_add_epi32(c, d); b = ROTL32_X4(_mm_xor_si128(b, c), 12);
+        X2 = _mm_xor_si128(X2, ROTL32_X4(_mm_add_epi32(X1, X0), 9));
+        a = _mm_add_epi32(a, b); d = ROTL32_X4(_mm_xor_si128(d, a), 8);
+        X3 = _mm_xor_si128(X3, ROTL32_X4(_mm_add_epi32(X2, X1), 13));
+        c = _mm_add_epi32(c, d); b = ROTL32_X4(_mm_xor_si128(b, c), 7);
+        X0 = _mm_xor_si128(X0, ROTL32_X4(_mm_add_epi32(X3, X2), 18));
+
+        b = _mm_shuffle_epi32(b, 0x39);
+        c = _mm_shuffle_epi32(c, 0x4E);
+        d = _mm_shuffle_epi32(d, 0x93);
+        X1 = _mm_shuffle_epi32(X1, 0x93);
+        X2 = _mm_shuffle_epi32(X2, 0x4E);
+        X3 = _mm_shuffle_epi32(X3, 0x39);
+
+        /* ChaCha diagonals, Salsa rows */
+        a = _mm_add_epi32(a, b); d = ROTL16_X4(_mm_xor_si128(d, a));
+        X3 = _mm_xor_si128(X3, ROTL32_X4(_mm_add_epi32(X0, X1), 7));
+        c = _mm_add_epi32(c, d); b = ROTL32_X4(_mm_xor_si128(b, c), 12);
+        X2 = _mm_xor_si128(X2, ROTL32_X4(_mm_add_epi32(X3, X0), 9));
+        a = _mm_add_epi32(a, b); d = ROTL32_X4(_mm_xor_si128(d, a), 8);
+        X1 = _mm_xor_si128(X1, ROTL32_X4(_mm_add_epi32(X2, X3), 13));
+        c = _mm_add_epi32(c, d); b = ROTL32_X4(_mm_xor_si128(b, c), 7);
+        X0 = _mm_xor_si128(X0, ROTL32_X4(_mm_add_epi32(X1, X2), 18));
+
+        b = _mm_shuffle_epi32(b, 0x93);
+        c = _mm_shuffle_epi32(c, 0x4E);
+        d = _mm_shuffle_epi32(d, 0x39);
+        X1 = _mm_shuffle_epi32(X1, 0x39);
+        X2 = _mm_shuffle_epi32(X2, 0x4E);
+        X3 = _mm_shuffle_epi32(X3, 0x93);
+    }
+
+    Z[0] = _mm_add_epi32(Z[0], a);
+    Z[1] = _mm_add_epi32(Z[1], b);
+    Z[2] = _mm_add_epi32(Z[2], c);
+    Z[3] = _mm_add_epi32(Z[3], d);
+    X[0] = _mm_add_epi32(X[0], X0);
+    X[1] = _mm_add_epi32(X[1], X1);
+    X[2] = _mm_add_epi32(X[2], X2);
+    X[3] = _mm_add_epi32(X[3], X3);
+}
+
+static inline void block_xor_sse2(__m128i* D, const __m128i* S)
+{
+    D[0] = _mm_xor_si128(D[0], S[0]);
+    D[1] = _mm_xor_si128(D[1], S[1]);
+    D[2] = _mm_xor_si128(D[2], S[2]);
+    D[3] = _mm_xor_si128(D[3], S[3]);
+}
+
+/*
+ * Both SMix passes side by side, ChaCha over Z and Salsa over X, each with
+ * its own half of V.  Each X is four blocks of four rows; Xb and Xc trade
+ * places by renaming the pointers.
+ */
+static void neoscrypt_mix_sse2(uint32_t* Zw, uint32_t* Xw, void* Vw)
+{
+    __m128i* Z = (__m128i*) Zw;
+    __m128i* X = (__m128i*) Xw;
+    __m128i* VZ = (__m128i*) Vw;
+    __m128i* VX = VZ + NEOSCRYPT_N * 16;
+    __m128i *z0 = &Z[0], *z1 = &Z[4], *z2 = &Z[8], *z3 = &Z[12];
+    __m128i *x0 = &X[0], *x1 = &X[4], *x2 = &X[8], *x3 = &X[12];
+    __m128i *t;
+    uint32_t i, j, k;
+
+    for (i = 0; i < 2 * NEOSCRYPT_N; i++) {
+        if (i < NEOSCRYPT_N) {
+            __m128i* vz = &VZ[i * 16];
+            __m128i* vx = &VX[i * 16];
+            for (k = 0; k < 4; k++) {
+                vz[k] = z0[k]; vz[4 + k] = z1[k]; vz[8 + k] = z2[k]; vz[12 + k] = z3[k];
+                vx[k] = x0[k]; vx[4 + k] = x1[k]; vx[8 + k] = x2[k]; vx[12 + k] = x3[k];
+            }
+        } else {
+            j = ((uint32_t) _mm_cvtsi128_si32(z3[0]) & (NEOSCRYPT_N - 1)) * 16;
+            block_xor_sse2(z0, &VZ[j]);
+            block_xor_sse2(z1, &VZ[j + 4]);
+            block_xor_sse2(z2, &VZ[j + 8]);
+            block_xor_sse2(z3, &VZ[j + 12]);
+            j = ((uint32_t) _mm_cvtsi128_si32(x3[0]) & (NEOSCRYPT_N - 1)) * 16;
+            block_xor_sse2(x0, &VX[j]);
+            block_xor_sse2(x1, &VX[j + 4]);
+            block_xor_sse2(x2, &VX[j + 8]);
+            block_xor_sse2(x3, &VX[j + 12]);
+        }
+        block_xor_sse2(z0, z3); block_xor_sse2(x0, x3); chacha_salsa_sse2(z0, x0);
+        block_xor_sse2(z1, z0); block_xor_sse2(x1, x0); chacha_salsa_sse2(z1, x1);
+        block_xor_sse2(z2, z1); block_xor_sse2(x2, x1); chacha_salsa_sse2(z2, x2);
+        block_xor_sse2(z3, z2); block_xor_sse2(x3, x2); chacha_salsa_sse2(z3, x3);
+        t = z1; z1 = z2; z2 = t;
+        t = x1; x1 = x2; x2 = t;
+    }
+
+    /* 2N renames, so every block is back where it started */
+}
+
+#endif
+
+#ifdef NEOSCRYPT_AVX2
+/* neoscrypt-avx2.c, two hashes per pass in the halves of each register */
+extern void neoscrypt_mix_x2_avx2(uint32_t* Z0, uint32_t* X0, uint32_t* Z1, uint32_t* X1, void* V);
+#endif
+
+/* Backend selection */
+
+typedef void (*neoscrypt_mix_fn)(uint32_t* Z, uint32_t* X, void* V);
+typedef void (*neoscrypt_mix_x2_fn)(uint32_t* Z0, uint32_t* X0, uint32_t* Z1, uint32_t* X1, void* V);
+
+static neoscrypt_mix_fn s_mix = neoscrypt_mix_scalar;
+static neoscrypt_mix_x2_fn s_mix_x2;
+#ifdef NEOSCRYPT_SSE2
+static int s_diagonal;
+#endif
+
+static void select_backend(void)
+{
+#ifdef NEOSCRYPT_SSE2
+    s_mix = neoscrypt_mix_sse2;
+    s_diagonal = 1;
+#endif
+#ifdef NEOSCRYPT_AVX2
+    if (cpu_has(CPU_FEATURE_AVX2))
+        s_mix_x2 = neoscrypt_mix_x2_avx2;
+#endif
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    select_backend();
+    return TRUE;
+}
+#define BACKEND_INIT_ONCE()     InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()     pthread_once(&s_backend_once, select_backend)
+#endif
+
+/* V comes from a pool, so hashing does not allocate once the pool is warm. */
+static scratch_pool s_scratch = SCRATCH_POOL_INIT(NEOSCRYPT_SCRATCH_SIZE, 32);
+
+/* One hash's working set between the two FastKDF passes */
+typedef struct {
+    uint32_t _ALIGN(64) X[NEOSCRYPT_X_WORDS];
+    uint32_t _ALIGN(64) Z[NEOSCRYPT_X_WORDS];
+} neoscrypt_work;
+
+static void work_begin(neoscrypt_work* w)
+{
+    memcpy(w->Z, w->X, NEOSCRYPT_X_SIZE);
+#ifdef NEOSCRYPT_SSE2
+    if (s_diagonal)
+        salsa_tangle(w->X);
+#endif
+}
+
+static void work_end(neoscrypt_work* w)
+{
+#ifdef NEOSCRYPT_SSE2
+    if (s_diagonal)
+        salsa_untangle(w->X);
+#endif
+    block_xor(w->X, w->Z, NEOSCRYPT_X_WORDS);
+}
+
+int neoscrypt_hash(const char* input, char* output, uint32_t len)
+{
+    neoscrypt_work w;
+    void* V;
+
+    BACKEND_INIT_ONCE();
+    V = scratch_pool_acquire(&s_scratch);
+    if (!V)
+        return -1;
+
+    neoscrypt_fastkdf((const uint8_t*) input, len, (const uint8_t*) input, len, (uint8_t*) w.X, NEOSCRYPT_X_SIZE);
+    work_begin(&w);
+    s_mix(w.Z, w.X, V);
+    work_end(&w);
+    neoscrypt_fastkdf((const uint8_t*) input, len, (const uint8_t*) w.X, NEOSCRYPT_X_SIZE, (uint8_t*) output, 32);
+    scratch_pool_release(&s_scratch, V);
+    return 0;
+}
+
+int neoscrypt_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    neoscrypt_work w[FASTKDF_LANES];
+    const uint8_t* salt[FASTKDF_LANES];
+    uint32_t salt_len[FASTKDF_LANES];
+    uint8_t* out[FASTKDF_LANES];
+    uint32_t n, lanes, l;
+    void* V;
+
+    BACKEND_INIT_ONCE();
+    V = scratch_pool_acquire(&s_scratch);
+    if (!V)
+        return -1;
+
+    for (n = 0; n < count; n += lanes) {
+        const uint8_t* const* password = (const uint8_t* const*) &inputs[n];
+        lanes = count - n < FASTKDF_LANES ? count - n : FASTKDF_LANES;
+
+        for (l = 0; l < lanes; l++)
+            out[l] = (uint8_t*) w[l].X;
+        neoscrypt_fastkdf_x4(password, &input_lens[n], password, &input_lens[n], out, NEOSCRYPT_X_SIZE, lanes);
+
+        for (l = 0; l < lanes; l++)
+            work_begin(&w[l]);
+        for (l = 0; l < lanes; ) {
+            if (s_mix_x2 && l + 1 < lanes) {
+                s_mix_x2(w[l].Z, w[l].X, w[l + 1].Z, w[l + 1].X, V);
+                l += 2;
+            } else {
+                s_mix(w[l].Z, w[l].X, V);
+                l++;
+            }
+        }
+        for (l = 0; l < lanes; l++) {
+            work_end(&w[l]);
+            salt[l] = (const uint8_t*) w[l].X;
+            salt_len[l] = NEOSCRYPT_X_SIZE;
+            out[l] = (uint8_t*) outputs[n + l];
+        }
+        neoscrypt_fastkdf_x4(password, &input_lens[n], salt, salt_len, out, 32, lanes);
+    }
+    scratch_pool_release(&s_scratch, V);
+    return 0;
+}
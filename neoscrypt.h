@@ -0,0 +1,25 @@
+#ifndef NEOSCRYPT_H
+#define NEOSCRYPT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * NeoScrypt(128, 2, 1) with Salsa20/20, ChaCha20/20 and FastKDF-BLAKE2s,
+ * the default profile.  The scratch memory is taken from a scratch pool
+ * shared by every thread.  Both return 0, or -1 when a pool block could not
+ * be allocated.
+ */
+int neoscrypt_hash(const char* input, char* output, uint32_t len);
+
+/* Hashes count inputs, running the FastKDF passes four headers at a time. */
+int neoscrypt_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
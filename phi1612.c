@@ -0,0 +1,60 @@
+#include "phi1612.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "chain.h"
+
+/* The stages after Skein-512, as in algo/x11/phi1612.c */
+static const chain_stage* const phi1612_stages[] = {
+    &chain_jh512, &chain_cubehash512, &chain_fugue512, &chain_gost512, &chain_echo512
+};
+
+static const chain_seq phi1612_seq = {
+    chain_skein512_input, phi1612_stages, sizeof phi1612_stages / sizeof phi1612_stages[0]
+};
+
+void phi1612_hash(const char* input, char* output, uint32_t len)
+{
+    chain_seq_hash(&phi1612_seq, input, output, len);
+}
+
+/*
+ * Headers of one job share their first 64 bytes, so the Skein-512 chaining
+ * value after them is kept from one header to the next while they match and
+ * only the tail is hashed (the phi_skein_midstate of the miners).
+ */
+static void phi1612_skein_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count,
+    chain_hash* hashes)
+{
+    const char* prefix = NULL;
+    uint64_t mid[8];
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        if (input_lens[i] <= 64) {
+            chain_skein512_input(inputs[i], input_lens[i], hashes[i]);
+            continue;
+        }
+        if (!prefix || memcmp(prefix, inputs[i], 64) != 0) {
+            chain_skein512_midstate(inputs[i], mid);
+            prefix = inputs[i];
+        }
+        chain_skein512_resume(mid, inputs[i] + 64, input_lens[i] - 64, hashes[i]);
+    }
+}
+
+void phi1612_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    uint32_t i, n;
+
+    for (; count; count -= n, inputs += n, input_lens += n, outputs += n) {
+        n = count < CHAIN_BATCH_MAX ? count : CHAIN_BATCH_MAX;
+        phi1612_skein_batch(inputs, input_lens, n, hashes);
+        for (i = 0; i < phi1612_seq.count; i++)
+            chain_run(phi1612_stages[i], hashes, n);
+        for (i = 0; i < n; i++)
+            memcpy(outputs[i], hashes[i], 32);
+    }
+}
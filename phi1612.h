@@ -0,0 +1,24 @@
+#ifndef PHI1612_H
+#define PHI1612_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Skein, JH, CubeHash, Fugue, Streebog and ECHO, all 512 bit (LUXcoin's phi). */
+void phi1612_hash(const char* input, char* output, uint32_t len);
+
+/*
+ * Same as phi1612_hash() for count inputs, run through the chain stage by
+ * stage; consecutive inputs with the same first 64 bytes share the Skein-512
+ * work on them.
+ */
+void phi1612_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,342 @@
+#include "pluck.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "scratch_pool.h"
+#include "sha256_core.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define PLUCK_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* Supercoin's N = 128: 4096 chained 32 byte digests */
+#define PLUCK_N             128
+#define PLUCK_SIZE          (PLUCK_N * 1024)
+
+/* Hashes a batch walks through their buffers side by side */
+#define PLUCK_LANES         4
+
+static scratch_pool s_buffers = SCRATCH_POOL_INIT(PLUCK_SIZE, 32);
+
+/*
+ * The second block of a 64 byte message: the 0x80 terminator and a bit
+ * length of 512.  Compressing joint[0..32) as two blocks skips the tail
+ * padding sha256_core_final() would redo on every digest.
+ */
+static const uint8_t s_pad64[64] = {
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x00
+};
+
+static inline uint32_t load32(const uint8_t* p)
+{
+    uint32_t x;
+    memcpy(&x, p, 4);
+    return x;
+}
+
+static inline void store32(uint8_t* p, uint32_t x)
+{
+    memcpy(p, &x, 4);
+}
+
+/* SHA-256 of the 64 bytes in joint[0..16); joint[16..32) holds s_pad64. */
+static void sha256_64(const uint32_t joint[32], uint8_t* output)
+{
+    uint32_t state[8];
+    int i;
+
+    sha256_core_init(state);
+    sha256_core_blocks(state, joint, 2);
+    for (i = 0; i < 8; i++) {
+        output[4 * i + 0] = (uint8_t) (state[i] >> 24);
+        output[4 * i + 1] = (uint8_t) (state[i] >> 16);
+        output[4 * i + 2] = (uint8_t) (state[i] >> 8);
+        output[4 * i + 3] = (uint8_t) state[i];
+    }
+}
+
+/*
+ * The offsets are taken modulo i - 36 and i - 4, which only change once per
+ * digest, so the divisions become multiplications by a 64 bit reciprocal
+ * (Lemire, Kaser and Kurz), exact for every 32 bit dividend and divisor.
+ */
+typedef struct {
+    uint64_t m;
+    uint32_t d;
+} pluck_mod;
+
+static inline pluck_mod mod_init(uint32_t d)
+{
+    pluck_mod mod;
+    mod.m = UINT64_C(0xFFFFFFFFFFFFFFFF) / d + 1;
+    mod.d = d;
+    return mod;
+}
+
+static inline uint32_t mod_apply(pluck_mod mod, uint32_t x)
+{
+#ifdef __SIZEOF_INT128__
+    return (uint32_t) (((unsigned __int128) (mod.m * x) * mod.d) >> 64);
+#else
+    return x % mod.d;
+#endif
+}
+
+#define ROTL32(x, n)    (((x) << (n)) | ((x) >> (32 - (n))))
+
+/* scrypt's xor_salsa8: B ^= Bx, then B += salsa20/8(B) */
+static void xor_salsa8(uint32_t B[16], const uint8_t* Bx)
+{
+    uint32_t x[16];
+    int i;
+
+    for (i = 0; i < 16; i++)
+        x[i] = B[i] ^= load32(Bx + 4 * i);
+
+    for (i = 0; i < 8; i += 2) {
+        x[ 4] ^= ROTL32(x[ 0] + x[12],  7);  x[ 9] ^= ROTL32(x[ 5] + x[ 1],  7);
+        x[14] ^= ROTL32(x[10] + x[ 6],  7);  x[ 3] ^= ROTL32(x[15] + x[11],  7);
+        x[ 8] ^= ROTL32(x[ 4] + x[ 0],  9);  x[13] ^= ROTL32(x[ 9] + x[ 5],  9);
+        x[ 2] ^= ROTL32(x[14] + x[10],  9);  x[ 7] ^= ROTL32(x[ 3] + x[15],  9);
+        x[12] ^= ROTL32(x[ 8] + x[ 4], 13);  x[ 1] ^= ROTL32(x[13] + x[ 9], 13);
+        x[ 6] ^= ROTL32(x[ 2] + x[14], 13);  x[11] ^= ROTL32(x[ 7] + x[ 3], 13);
+        x[ 0] ^= ROTL32(x[12] + x[ 8], 18);  x[ 5] ^= ROTL32(x[ 1] + x[13], 18);
+        x[10] ^= ROTL32(x[ 6] + x[ 2], 18);  x[15] ^= ROTL32(x[11] + x[ 7], 18);
+
+        x[ 1] ^= ROTL32(x[ 0] + x[ 3],  7);  x[ 6] ^= ROTL32(x[ 5] + x[ 4],  7);
+        x[11] ^= ROTL32(x[10] + x[ 9],  7);  x[12] ^= ROTL32(x[15] + x[14],  7);
+        x[ 2] ^= ROTL32(x[ 1] + x[ 0],  9);  x[ 7] ^= ROTL32(x[ 6] + x[ 5],  9);
+        x[ 8] ^= ROTL32(x[11] + x[10],  9);  x[13] ^= ROTL32(x[12] + x[15],  9);
+        x[ 3] ^= ROTL32(x[ 2] + x[ 1], 13);  x[ 4] ^= ROTL32(x[ 7] + x[ 6], 13);
+        x[ 9] ^= ROTL32(x[ 8] + x[11], 13);  x[14] ^= ROTL32(x[13] + x[12], 13);
+        x[ 0] ^= ROTL32(x[ 3] + x[ 2], 18);  x[ 5] ^= ROTL32(x[ 4] + x[ 7], 18);
+        x[10] ^= ROTL32(x[ 9] + x[ 8], 18);  x[15] ^= ROTL32(x[14] + x[13], 18);
+    }
+
+    for (i = 0; i < 16; i++)
+        B[i] += x[i];
+}
+
+/*
+ * Offsets for the digest at i: salsa20/8 of the 64 bytes at seed, keyed with
+ * the two digests starting at i - 128 (zero until those exist).
+ */
+static void pluck_offsets(uint32_t R[16], const uint8_t* H, uint32_t i, const uint8_t* seed)
+{
+    int k;
+
+    for (k = 0; k < 16; k++)
+        R[k] = i > 128 ? load32(H + i - 128 + 4 * k) : 0;
+    xor_salsa8(R, seed);
+}
+
+#ifdef PLUCK_SSE2
+
+/* a b c d rows of four lanes each become four lanes of a b c d, in place */
+#define TRANSPOSE4(a, b, c, d) do { \
+    __m128i t0 = _mm_unpacklo_epi32(a, b); \
+    __m128i t1 = _mm_unpacklo_epi32(c, d); \
+    __m128i t2 = _mm_unpackhi_epi32(a, b); \
+    __m128i t3 = _mm_unpackhi_epi32(c, d); \
+    a = _mm_unpacklo_epi64(t0, t1); \
+    b = _mm_unpackhi_epi64(t0, t1); \
+    c = _mm_unpacklo_epi64(t2, t3); \
+    d = _mm_unpackhi_epi64(t2, t3); \
+} while (0)
+
+#define ROTL32_X4(x, n) _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+#define SALSA_X4(d, a, b, n) x[d] = _mm_xor_si128(x[d], ROTL32_X4(_mm_add_epi32(x[a], x[b]), n))
+
+/* pluck_offsets() for four buffers at the same i, one per 32-bit lane */
+static void pluck_offsets_x4(uint32_t R[4][16], uint8_t* const H[4], uint32_t i, uint32_t seed)
+{
+    __m128i b[16], x[16];
+    int k;
+
+    for (k = 0; k < 16; k += 4) {
+        x[k + 0] = _mm_loadu_si128((const __m128i*) (H[0] + seed + 4 * k));
+        x[k + 1] = _mm_loadu_si128((const __m128i*) (H[1] + seed + 4 * k));
+        x[k + 2] = _mm_loadu_si128((const __m128i*) (H[2] + seed + 4 * k));
+        x[k + 3] = _mm_loadu_si128((const __m128i*) (H[3] + seed + 4 * k));
+        if (i > 128) {
+            x[k + 0] = _mm_xor_si128(x[k + 0], _mm_loadu_si128((const __m128i*) (H[0] + i - 128 + 4 * k)));
+            x[k + 1] = _mm_xor_si128(x[k + 1], _mm_loadu_si128((const __m128i*) (H[1] + i - 128 + 4 * k)));
+            x[k + 2] = _mm_xor_si128(x[k + 2], _mm_loadu_si128((const __m128i*) (H[2] + i - 128 + 4 * k)));
+            x[k + 3] = _mm_xor_si128(x[k + 3], _mm_loadu_si128((const __m128i*) (H[3] + i - 128 + 4 * k)));
+        }
+        TRANSPOSE4(x[k + 0], x[k + 1], x[k + 2], x[k + 3]);
+    }
+    for (k = 0; k < 16; k++)
+        b[k] = x[k];
+
+    for (k = 0; k < 8; k += 2) {
+        SALSA_X4( 4,  0, 12,  7);  SALSA_X4( 9,  5,  1,  7);
+        SALSA_X4(14, 10,  6,  7);  SALSA_X4( 3, 15, 11,  7);
+        SALSA_X4( 8,  4,  0,  9);  SALSA_X4(13,  9,  5,  9);
+        SALSA_X4( 2, 14, 10,  9);  SALSA_X4( 7,  3, 15,  9);
+        SALSA_X4(12,  8,  4, 13);  SALSA_X4( 1, 13,  9, 13);
+        SALSA_X4( 6,  2, 14, 13);  SALSA_X4(11,  7,  3, 13);
+        SALSA_X4( 0, 12,  8, 18);  SALSA_X4( 5,  1, 13, 18);
+        SALSA_X4(10,  6,  2, 18);  SALSA_X4(15, 11,  7, 18);
+
+        SALSA_X4( 1,  0,  3,  7);  SALSA_X4( 6,  5,  4,  7);
+        SALSA_X4(11, 10,  9,  7);  SALSA_X4(12, 15, 14,  7);
+        SALSA_X4( 2,  1,  0,  9);  SALSA_X4( 7,  6,  5,  9);
+        SALSA_X4( 8, 11, 10,  9);  SALSA_X4(13, 12, 15,  9);
+        SALSA_X4( 3,  2,  1, 13);  SALSA_X4( 4,  7,  6, 13);
+        SALSA_X4( 9,  8, 11, 13);  SALSA_X4(14, 13, 12, 13);
+        SALSA_X4( 0,  3,  2, 18);  SALSA_X4( 5,  4,  7, 18);
+        SALSA_X4(10,  9,  8, 18);  SALSA_X4(15, 14, 13, 18);
+    }
+
+    for (k = 0; k < 16; k += 4) {
+        x[k + 0] = _mm_add_epi32(x[k + 0], b[k + 0]);
+        x[k + 1] = _mm_add_epi32(x[k + 1], b[k + 1]);
+        x[k + 2] = _mm_add_epi32(x[k + 2], b[k + 2]);
+        x[k + 3] = _mm_add_epi32(x[k + 3], b[k + 3]);
+        TRANSPOSE4(x[k + 0], x[k + 1], x[k + 2], x[k + 3]);
+        _mm_storeu_si128((__m128i*) (R[0] + k), x[k + 0]);
+        _mm_storeu_si128((__m128i*) (R[1] + k), x[k + 1]);
+        _mm_storeu_si128((__m128i*) (R[2] + k), x[k + 2]);
+        _mm_storeu_si128((__m128i*) (R[3] + k), x[k + 3]);
+    }
+}
+
+#else
+
+static void pluck_offsets_x4(uint32_t R[4][16], uint8_t* const H[4], uint32_t i, uint32_t seed)
+{
+    int l;
+
+    for (l = 0; l < 4; l++)
+        pluck_offsets(R[l], H[l], i, H[l] + seed);
+}
+
+#endif
+
+/*
+ * Each digest hashes the previous one with eight words read from earlier
+ * in the buffer, then sixteen words around it are scattered back into the
+ * buffer; both sets of offsets come from salsa20/8.
+ */
+static void pluck_fill(uint8_t* H, const char* input)
+{
+    uint32_t _ALIGN(64) R[16];
+    uint32_t _ALIGN(64) joint[32];
+    pluck_mod gather, scatter;
+    uint32_t i;
+    int k;
+
+    memcpy(joint + 16, s_pad64, 64);
+    sha256_core_hash(input, PLUCK_HEADER_SIZE, H);
+    memset(H + 32, 0, 32);
+
+    for (i = 64; i < PLUCK_SIZE - 32; i += 32) {
+        gather = mod_init(i - 36);
+        scatter = mod_init(i - 4);
+
+        pluck_offsets(R, H, i, H + i - 64);
+        memcpy(joint, H + i - 32, 32);
+        for (k = 0; k < 8; k++)
+            joint[8 + k] = load32(H + mod_apply(gather, R[k]));
+        sha256_64(joint, H + i);
+
+        pluck_offsets(R, H, i, H + i - 32);
+        for (k = 0; k < 16; k++)
+            store32(H + mod_apply(scatter, R[k]), load32(H + i - 4 + 2 * k));
+    }
+}
+
+/*
+ * pluck_fill() on up to four buffers at the same i.  The salsa20/8 runs
+ * once for all of them, and the gathers and scatters of different buffers
+ * are independent, so their cache misses overlap instead of queueing behind
+ * each other.  Unused lanes alias lane 0 for the salsa and are skipped
+ * everywhere else.
+ */
+static void pluck_fill_x4(uint8_t* const H[PLUCK_LANES], const char* const* inputs, int lanes)
+{
+    uint32_t _ALIGN(64) R[PLUCK_LANES][16];
+    uint32_t _ALIGN(64) joint[PLUCK_LANES][32];
+    uint8_t* src[PLUCK_LANES];
+    pluck_mod gather, scatter;
+    uint32_t i;
+    int k, l;
+
+    for (l = 0; l < PLUCK_LANES; l++)
+        src[l] = H[l < lanes ? l : 0];
+    for (l = 0; l < lanes; l++) {
+        memcpy(joint[l] + 16, s_pad64, 64);
+        sha256_core_hash(inputs[l], PLUCK_HEADER_SIZE, H[l]);
+        memset(H[l] + 32, 0, 32);
+    }
+
+    for (i = 64; i < PLUCK_SIZE - 32; i += 32) {
+        gather = mod_init(i - 36);
+        scatter = mod_init(i - 4);
+
+        pluck_offsets_x4(R, src, i, i - 64);
+        for (l = 0; l < lanes; l++)
+            memcpy(joint[l], H[l] + i - 32, 32);
+        for (k = 0; k < 8; k++)
+            for (l = 0; l < lanes; l++)
+                joint[l][8 + k] = load32(H[l] + mod_apply(gather, R[l][k]));
+        for (l = 0; l < lanes; l++)
+            sha256_64(joint[l], H[l] + i);
+
+        pluck_offsets_x4(R, src, i, i - 32);
+        for (k = 0; k < 16; k++)
+            for (l = 0; l < lanes; l++)
+                store32(H[l] + mod_apply(scatter, R[l][k]), load32(H[l] + i - 4 + 2 * k));
+    }
+}
+
+int pluck_hash(const char* input, char* output)
+{
+    uint8_t* H = (uint8_t*) scratch_pool_acquire(&s_buffers);
+
+    if (!H)
+        return -1;
+
+    pluck_fill(H, input);
+    memcpy(output, H, 32);
+    scratch_pool_release(&s_buffers, H);
+    return 0;
+}
+
+int pluck_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint8_t* H[PLUCK_LANES] = { NULL };
+    uint32_t i;
+    int lanes, l, rc = 0;
+
+    (void) input_lens;
+    for (l = 0; l < PLUCK_LANES && (uint32_t) l < count; l++) {
+        H[l] = (uint8_t*) scratch_pool_acquire(&s_buffers);
+        if (!H[l]) {
+            rc = -1;
+            goto out;
+        }
+    }
+
+    for (i = 0; i < count; i += lanes) {
+        lanes = count - i < PLUCK_LANES ? (int) (count - i) : PLUCK_LANES;
+        if (lanes == 1)
+            pluck_fill(H[0], inputs[i]);
+        else
+            pluck_fill_x4(H, inputs + i, lanes);
+        for (l = 0; l < lanes; l++)
+            memcpy(outputs[i + l], H[l], 32);
+    }
+
+out:
+    for (l = 0; l < PLUCK_LANES; l++)
+        scratch_pool_release(&s_buffers, H[l]);
+    return rc;
+}
@@ -0,0 +1,26 @@
+#ifndef PLUCK_H
+#define PLUCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define PLUCK_HEADER_SIZE 80
+
+/*
+ * Pluck with N = 128 (Supercoin): a 128 KiB buffer of chained SHA-256
+ * digests mixed at salsa20/8-chosen offsets.  Both return 0, or -1 when no
+ * hash buffer could be allocated.
+ */
+int pluck_hash(const char* input, char* output);
+
+/* Hashes count 80 byte headers, four at a time in lockstep; input_lens is unused. */
+int pluck_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
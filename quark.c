@@ -38,6 +38,8 @@
 #include "sha3/sph_jh.h"
 #include "sha3/sph_keccak.h"
 #include "sha3/sph_skein.h"
+#include "compat.h"
+#include "chain.h"
 
 
 static __inline uint32_t
@@ -207,4 +209,37 @@ void quark_hash(const char* input, char* output, uint32_t len)
 
 }
 
+static void quark_chunk(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    sph_blake512_context ctx_blake;
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        sph_blake512_init(&ctx_blake);
+        sph_blake512(&ctx_blake, inputs[i], input_lens[i]);
+        sph_blake512_close(&ctx_blake, hashes[i]);
+    }
+
+    chain_run(&chain_bmw512, hashes, count);
+    chain_branch(8, &chain_groestl512, &chain_skein512, hashes, count);
+    chain_run(&chain_groestl512, hashes, count);
+    chain_run(&chain_jh512, hashes, count);
+    chain_branch(8, &chain_blake512, &chain_bmw512, hashes, count);
+    chain_run(&chain_keccak512, hashes, count);
+    chain_run(&chain_skein512, hashes, count);
+    chain_branch(8, &chain_keccak512, &chain_jh512, hashes, count);
+
+    for (i = 0; i < count; i++)
+        memcpy(outputs[i], hashes[i], 32);
+}
+
+void quark_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint32_t i, n;
 
+    for (i = 0; i < count; i += n) {
+        n = count - i < CHAIN_BATCH_MAX ? count - i : CHAIN_BATCH_MAX;
+        quark_chunk(inputs + i, input_lens + i, n, outputs + i);
+    }
+}
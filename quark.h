@@ -9,6 +9,12 @@ extern "C" {
 
 void quark_hash(const char* input, char* output, uint32_t len);
 
+/*
+ * Same as quark_hash() for count inputs, run stage by stage with the hashes
+ * regrouped by the branch they take at each data dependent step.
+ */
+void quark_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,69 @@
+#include "scratch_pool.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#define POOL_LOCK(p)        AcquireSRWLockExclusive(&(p)->lock)
+#define POOL_UNLOCK(p)      ReleaseSRWLockExclusive(&(p)->lock)
+#else
+#define POOL_LOCK(p)        pthread_mutex_lock(&(p)->lock)
+#define POOL_UNLOCK(p)      pthread_mutex_unlock(&(p)->lock)
+#endif
+
+static void* aligned_alloc_buf(size_t size)
+{
+#ifdef _WIN32
+	return _aligned_malloc(size, SCRATCH_POOL_ALIGN);
+#else
+	void *buf;
+	if (posix_memalign(&buf, SCRATCH_POOL_ALIGN, size) != 0)
+		return NULL;
+	return buf;
+#endif
+}
+
+static void aligned_free_buf(void *buf)
+{
+#ifdef _WIN32
+	_aligned_free(buf);
+#else
+	free(buf);
+#endif
+}
+
+/* Idle buffers are chained through their first word. */
+void* scratch_pool_acquire(scratch_pool *pool)
+{
+	void *buf;
+
+	POOL_LOCK(pool);
+	buf = pool->head;
+	if (buf) {
+		pool->head = *(void**)buf;
+		pool->idle--;
+	}
+	POOL_UNLOCK(pool);
+
+	if (!buf)
+		buf = aligned_alloc_buf(pool->size < sizeof(void*) ? sizeof(void*) : pool->size);
+	return buf;
+}
+
+void scratch_pool_release(scratch_pool *pool, void *buf)
+{
+	if (!buf)
+		return;
+
+	POOL_LOCK(pool);
+	if (pool->idle < pool->max_idle) {
+		*(void**)buf = pool->head;
+		pool->head = buf;
+		pool->idle++;
+		buf = NULL;
+	}
+	POOL_UNLOCK(pool);
+
+	if (buf)
+		aligned_free_buf(buf);
+}
@@ -0,0 +1,56 @@
+#ifndef SCRATCH_POOL_H
+#define SCRATCH_POOL_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bounded pool of cache-line aligned scratch buffers of one size, shared by
+ * every thread that hashes with a given algorithm.
+ *
+ * acquire() hands out an idle buffer or allocates a new one, so it never
+ * blocks on other hashes; release() keeps at most max_idle buffers for reuse
+ * and frees the rest.  The retained memory therefore stays bounded no matter
+ * how many threads ever hashed at once, and buffers are not tied to threads
+ * that may never hash again.  Buffers are not cleared between users.
+ *
+ * Pools are meant to be static and are set up with SCRATCH_POOL_INIT.
+ */
+typedef struct scratch_pool {
+	size_t size;
+	unsigned max_idle;
+	unsigned idle;
+	void *head;
+#ifdef _WIN32
+	SRWLOCK lock;
+#else
+	pthread_mutex_t lock;
+#endif
+} scratch_pool;
+
+#ifdef _WIN32
+#define SCRATCH_POOL_INIT(size, max_idle) { (size), (max_idle), 0, NULL, SRWLOCK_INIT }
+#else
+#define SCRATCH_POOL_INIT(size, max_idle) { (size), (max_idle), 0, NULL, PTHREAD_MUTEX_INITIALIZER }
+#endif
+
+#define SCRATCH_POOL_ALIGN 64
+
+/* NULL if the allocation fails */
+void* scratch_pool_acquire(scratch_pool *pool);
+void scratch_pool_release(scratch_pool *pool, void *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
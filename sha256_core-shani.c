@@ -0,0 +1,100 @@
+/*
+ * SHA-256 block function on the x86 SHA extensions, selected at run time by
+ * sha256_core.c.  The state is carried as ABEF/CDGH pairs, the layout
+ * sha256rnds2 works on, and only converted on entry and exit.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sha,sse4.1,ssse3"))), apply_to = function)
+#else
+#pragma GCC target("sha,sse4.1,ssse3")
+#endif
+
+static const uint32_t __attribute__((aligned(16))) sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/*
+ * Four rounds on message words cur.  Groups 3 to 14 finish the schedule of
+ * next, groups 1 to 12 start the one of prev; the flags are constants, so
+ * each expansion keeps only its own half.
+ */
+#define QROUND(g, cur, prev, next, msg2, msg1) do { \
+        msg = _mm_add_epi32(cur, _mm_load_si128((const __m128i*) &sha256_k[4 * (g)])); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+        if (msg2) { \
+            tmp = _mm_alignr_epi8(cur, prev, 4); \
+            next = _mm_add_epi32(next, tmp); \
+            next = _mm_sha256msg2_epu32(next, cur); \
+        } \
+        msg = _mm_shuffle_epi32(msg, 0x0E); \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg); \
+        if (msg1) \
+            prev = _mm_sha256msg1_epu32(prev, cur); \
+    } while (0)
+
+void sha256_core_blocks_shani(uint32_t state[8], const void* data, size_t blocks)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const uint8_t* in = (const uint8_t*) data;
+    __m128i state0, state1, save0, save1, msg, tmp, m0, m1, m2, m3;
+
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &state[0]), 0xB1);     /* CDAB */
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &state[4]), 0x1B);  /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);                                       /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                    /* CDGH */
+
+    for (; blocks; blocks--, in += 64) {
+        save0 = state0;
+        save1 = state1;
+
+        m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (in + 0)), bswap);
+        m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (in + 16)), bswap);
+        m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (in + 32)), bswap);
+        m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (in + 48)), bswap);
+
+        QROUND( 0, m0, m3, m1, 0, 0);
+        QROUND( 1, m1, m0, m2, 0, 1);
+        QROUND( 2, m2, m1, m3, 0, 1);
+        QROUND( 3, m3, m2, m0, 1, 1);
+        QROUND( 4, m0, m3, m1, 1, 1);
+        QROUND( 5, m1, m0, m2, 1, 1);
+        QROUND( 6, m2, m1, m3, 1, 1);
+        QROUND( 7, m3, m2, m0, 1, 1);
+        QROUND( 8, m0, m3, m1, 1, 1);
+        QROUND( 9, m1, m0, m2, 1, 1);
+        QROUND(10, m2, m1, m3, 1, 1);
+        QROUND(11, m3, m2, m0, 1, 1);
+        QROUND(12, m0, m3, m1, 1, 1);
+        QROUND(13, m1, m0, m2, 1, 0);
+        QROUND(14, m2, m1, m3, 1, 0);
+        QROUND(15, m3, m2, m0, 0, 0);
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                                          /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);                                       /* DCHG */
+    _mm_storeu_si128((__m128i*) &state[0], _mm_blend_epi16(tmp, state1, 0xF0));     /* DCBA */
+    _mm_storeu_si128((__m128i*) &state[4], _mm_alignr_epi8(state1, tmp, 8));        /* HGFE */
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+#include "sha256_core.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "cpu_features.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_CORE_SHANI 1
+/* sha256_core-shani.c */
+extern void sha256_core_blocks_shani(uint32_t state[8], const void* data, size_t blocks);
+#endif
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR32(x, n)    (((x) >> (n)) | ((x) << (32 - (n))))
+#define CH(x, y, z)     (((x) & ((y) ^ (z))) ^ (z))
+#define MAJ(x, y, z)    (((x) & ((y) | (z))) | ((y) & (z)))
+#define BSG0(x)         (ROTR32(x, 2) ^ ROTR32(x, 13) ^ ROTR32(x, 22))
+#define BSG1(x)         (ROTR32(x, 6) ^ ROTR32(x, 11) ^ ROTR32(x, 25))
+#define SSG0(x)         (ROTR32(x, 7) ^ ROTR32(x, 18) ^ ((x) >> 3))
+#define SSG1(x)         (ROTR32(x, 17) ^ ROTR32(x, 19) ^ ((x) >> 10))
+
+static uint32_t be32dec(const uint8_t* p)
+{
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+static void be32enc(uint8_t* p, uint32_t x)
+{
+    p[0] = (uint8_t) (x >> 24);
+    p[1] = (uint8_t) (x >> 16);
+    p[2] = (uint8_t) (x >> 8);
+    p[3] = (uint8_t) x;
+}
+
+static void sha256_core_blocks_scalar(uint32_t state[8], const void* data, size_t blocks)
+{
+    const uint8_t* in = (const uint8_t*) data;
+    uint32_t W[64];
+    uint32_t a, b, c, d, e, f, g, h, t1, t2;
+    int i;
+
+    for (; blocks; blocks--, in += 64) {
+        for (i = 0; i < 16; i++)
+            W[i] = be32dec(in + 4 * i);
+        for (; i < 64; i++)
+            W[i] = SSG1(W[i - 2]) + W[i - 7] + SSG0(W[i - 15]) + W[i - 16];
+
+        a = state[0]; b = state[1]; c = state[2]; d = state[3];
+        e = state[4]; f = state[5]; g = state[6]; h = state[7];
+        for (i = 0; i < 64; i++) {
+            t1 = h + BSG1(e) + CH(e, f, g) + sha256_k[i] + W[i];
+            t2 = BSG0(a) + MAJ(a, b, c);
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+/* Backend selection */
+
+typedef void (*sha256_blocks_fn)(uint32_t state[8], const void* data, size_t blocks);
+
+static sha256_blocks_fn s_blocks = sha256_core_blocks_scalar;
+
+static void select_backend(void)
+{
+#ifdef SHA256_CORE_SHANI
+    if (cpu_has(CPU_FEATURE_SHA | CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE41))
+        s_blocks = sha256_core_blocks_shani;
+#endif
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    select_backend();
+    return TRUE;
+}
+#define BACKEND_INIT_ONCE()     InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()     pthread_once(&s_backend_once, select_backend)
+#endif
+
+void sha256_core_init(uint32_t state[8])
+{
+    memcpy(state, sha256_iv, sizeof sha256_iv);
+}
+
+void sha256_core_blocks(uint32_t state[8], const void* data, size_t blocks)
+{
+    BACKEND_INIT_ONCE();
+    s_blocks(state, data, blocks);
+}
+
+void sha256_core_final(const uint32_t state[8], uint64_t done, const void* data, size_t len, void* output)
+{
+    const uint8_t* in = (const uint8_t*) data;
+    uint64_t bits = (done + len) << 3;
+    uint8_t tail[128];
+    uint32_t st[8];
+    size_t full = len & ~(size_t) 63, rest = len - full, padded;
+    int i;
+
+    BACKEND_INIT_ONCE();
+    memcpy(st, state, sizeof st);
+    if (full)
+        s_blocks(st, in, full >> 6);
+
+    /* The 0x80 marker and the 64 bit length take one block or spill into a second */
+    padded = rest < 56 ? 64 : 128;
+    memcpy(tail, in + full, rest);
+    tail[rest] = 0x80;
+    memset(tail + rest + 1, 0, padded - rest - 9);
+    be32enc(tail + padded - 8, (uint32_t) (bits >> 32));
+    be32enc(tail + padded - 4, (uint32_t) bits);
+    s_blocks(st, tail, padded >> 6);
+
+    for (i = 0; i < 8; i++)
+        be32enc((uint8_t*) output + 4 * i, st[i]);
+}
+
+void sha256_core_hash(const void* data, size_t len, void* output)
+{
+    sha256_core_final(sha256_iv, 0, data, len, output);
+}
@@ -0,0 +1,38 @@
+#ifndef SHA256_CORE_H
+#define SHA256_CORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * SHA-256 on the compression function alone, for hashes that keep a
+ * midstate of their own.  The block function is picked once per process:
+ * the SHA extensions where the CPU has them, portable C otherwise.
+ *
+ * States are the eight working words in host order; sha256_core_init()
+ * loads the standard IV.
+ */
+void sha256_core_init(uint32_t state[8]);
+
+/* Compresses blocks 64 byte blocks of data into state. */
+void sha256_core_blocks(uint32_t state[8], const void* data, size_t blocks);
+
+/*
+ * Hashes the last len bytes of a message whose first done bytes (a multiple
+ * of 64) are already compressed into state, writing the 32 byte digest.
+ * state itself is left untouched.
+ */
+void sha256_core_final(const uint32_t state[8], uint64_t done, const void* data, size_t len, void* output);
+
+/* One-shot SHA-256 of len bytes. */
+void sha256_core_hash(const void* data, size_t len, void* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
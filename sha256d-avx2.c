@@ -0,0 +1,180 @@
+/*
+ * Chained SHA-256 of eight 80 byte block headers on AVX2, one header per
+ * 32 bit lane, selected at run time by sha256d.c.  The state stays
+ * word-sliced from the first compression to the last, so the digests of
+ * one round are fed to the next without leaving the registers.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+static const uint32_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ADD(a, b)       _mm256_add_epi32(a, b)
+#define XOR(a, b)       _mm256_xor_si256(a, b)
+#define ROTR(x, n)      _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+#define BSG0(x)         XOR(ROTR(x, 2), XOR(ROTR(x, 13), ROTR(x, 22)))
+#define BSG1(x)         XOR(ROTR(x, 6), XOR(ROTR(x, 11), ROTR(x, 25)))
+#define SSG0(x)         XOR(ROTR(x, 7), XOR(ROTR(x, 18), _mm256_srli_epi32(x, 3)))
+#define SSG1(x)         XOR(ROTR(x, 17), XOR(ROTR(x, 19), _mm256_srli_epi32(x, 10)))
+#define CH(x, y, z)     XOR(_mm256_and_si256(x, XOR(y, z)), z)
+#define MAJ(x, y, z)    _mm256_or_si256(_mm256_and_si256(x, _mm256_or_si256(y, z)), _mm256_and_si256(y, z))
+
+#define EXPAND(W, n) \
+    (W[(n) & 15] = ADD(ADD(SSG1(W[((n) - 2) & 15]), W[((n) - 7) & 15]), \
+        ADD(SSG0(W[((n) - 15) & 15]), W[(n) & 15])))
+
+#define ROUND(a, b, c, d, e, f, g, h, j)   do { \
+    __m256i t1 = ADD(ADD(h, BSG1(e)), ADD(CH(e, f, g), \
+        ADD(_mm256_set1_epi32((int) sha256_k[j]), W[(j) & 15]))); \
+    d = ADD(d, t1); \
+    h = ADD(t1, ADD(BSG0(a), MAJ(a, b, c))); \
+} while (0)
+
+#define ROUND8(j)   do { \
+    ROUND(A, B, C, D, E, F, G, H, (j) + 0); \
+    ROUND(H, A, B, C, D, E, F, G, (j) + 1); \
+    ROUND(G, H, A, B, C, D, E, F, (j) + 2); \
+    ROUND(F, G, H, A, B, C, D, E, (j) + 3); \
+    ROUND(E, F, G, H, A, B, C, D, (j) + 4); \
+    ROUND(D, E, F, G, H, A, B, C, (j) + 5); \
+    ROUND(C, D, E, F, G, H, A, B, (j) + 6); \
+    ROUND(B, C, D, E, F, G, H, A, (j) + 7); \
+} while (0)
+
+/* Eight rows of eight words each into eight vectors of one word from each row, and back */
+#define TRANSPOSE8(r)   do { \
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]); \
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]); \
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]); \
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]); \
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2); \
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3); \
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6); \
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7); \
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20); \
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20); \
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20); \
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20); \
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31); \
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31); \
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31); \
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31); \
+} while (0)
+
+static void compress8(__m256i S[8], __m256i W[16])
+{
+    __m256i A = S[0], B = S[1], C = S[2], D = S[3];
+    __m256i E = S[4], F = S[5], G = S[6], H = S[7];
+    int j;
+
+    ROUND8(0);
+    ROUND8(8);
+    for (j = 16; j < 64; j += 8) {
+        EXPAND(W, j + 0); EXPAND(W, j + 1); EXPAND(W, j + 2); EXPAND(W, j + 3);
+        EXPAND(W, j + 4); EXPAND(W, j + 5); EXPAND(W, j + 6); EXPAND(W, j + 7);
+        ROUND8(j);
+    }
+
+    S[0] = ADD(S[0], A); S[1] = ADD(S[1], B); S[2] = ADD(S[2], C); S[3] = ADD(S[3], D);
+    S[4] = ADD(S[4], E); S[5] = ADD(S[5], F); S[6] = ADD(S[6], G); S[7] = ADD(S[7], H);
+}
+
+static void set_iv(__m256i S[8], const uint32_t* state)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+        S[i] = _mm256_set1_epi32((int) state[i]);
+}
+
+/*
+ * rounds chained SHA-256 of eight 80 byte inputs.  mid, when not NULL, is
+ * the state after their common first 64 bytes.
+ */
+void sha256n_80_x8_avx2(const uint32_t* mid, const unsigned char* const input[8], int rounds,
+    unsigned char* const output[8])
+{
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i S[8], W[16];
+    int i, r;
+
+    if (mid) {
+        set_iv(S, mid);
+    } else {
+        set_iv(S, sha256_iv);
+        for (i = 0; i < 8; i++) {
+            W[i] = _mm256_loadu_si256((const __m256i*) input[i]);
+            W[i + 8] = _mm256_loadu_si256((const __m256i*) (input[i] + 32));
+        }
+        TRANSPOSE8(W);
+        TRANSPOSE8((W + 8));
+        for (i = 0; i < 16; i++)
+            W[i] = _mm256_shuffle_epi8(W[i], bswap);
+        compress8(S, W);
+    }
+
+    /* Bytes 64..79 of lanes i and i + 4 share a vector, then a 4x4 transpose per half */
+    for (i = 0; i < 4; i++)
+        W[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) (input[i] + 64))),
+            _mm_loadu_si128((const __m128i*) (input[i + 4] + 64)), 1);
+    {
+        __m256i t0 = _mm256_unpacklo_epi32(W[0], W[1]), t1 = _mm256_unpackhi_epi32(W[0], W[1]);
+        __m256i t2 = _mm256_unpacklo_epi32(W[2], W[3]), t3 = _mm256_unpackhi_epi32(W[2], W[3]);
+        W[0] = _mm256_shuffle_epi8(_mm256_unpacklo_epi64(t0, t2), bswap);
+        W[1] = _mm256_shuffle_epi8(_mm256_unpackhi_epi64(t0, t2), bswap);
+        W[2] = _mm256_shuffle_epi8(_mm256_unpacklo_epi64(t1, t3), bswap);
+        W[3] = _mm256_shuffle_epi8(_mm256_unpackhi_epi64(t1, t3), bswap);
+    }
+    W[4] = _mm256_set1_epi32((int) 0x80000000);
+    for (i = 5; i < 15; i++)
+        W[i] = _mm256_setzero_si256();
+    W[15] = _mm256_set1_epi32(80 * 8);
+    compress8(S, W);
+
+    /* Every further round hashes the 32 byte digest: one block of fixed padding */
+    for (r = 1; r < rounds; r++) {
+        for (i = 0; i < 8; i++)
+            W[i] = S[i];
+        W[8] = _mm256_set1_epi32((int) 0x80000000);
+        for (i = 9; i < 15; i++)
+            W[i] = _mm256_setzero_si256();
+        W[15] = _mm256_set1_epi32(32 * 8);
+        set_iv(S, sha256_iv);
+        compress8(S, W);
+    }
+
+    TRANSPOSE8(S);
+    for (i = 0; i < 8; i++)
+        _mm256_storeu_si256((__m256i*) output[i], _mm256_shuffle_epi8(S[i], bswap));
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
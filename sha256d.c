@@ -0,0 +1,176 @@
+#include "sha256d.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "cpu_features.h"
+#include "sha256_core.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256D_AVX2 1
+/* sha256d-avx2.c */
+extern void sha256n_80_x8_avx2(const uint32_t* mid, const unsigned char* const input[8], int rounds,
+    unsigned char* const output[8]);
+#endif
+
+#define SHA256D_LANES       8
+
+/* The padding block of a 32 byte message: the 0x80 terminator and a bit length of 256 */
+static const unsigned char s_pad32[32] = {
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00
+};
+
+/* Backend selection */
+
+static int s_avx2;
+static int s_shani;
+
+static void select_backend(void)
+{
+#ifdef SHA256D_AVX2
+    s_avx2 = cpu_has(CPU_FEATURE_AVX2);
+#endif
+    s_shani = cpu_has(CPU_FEATURE_SHA | CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE41);
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    select_backend();
+    return TRUE;
+}
+#define BACKEND_INIT_ONCE()     InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()     pthread_once(&s_backend_once, select_backend)
+#endif
+
+/* SHA-256 of a 32 byte digest, in place: one block, with the padding known up front */
+static void sha256_32(unsigned char hash[32])
+{
+    unsigned char block[64];
+    uint32_t state[8];
+    int i;
+
+    memcpy(block, hash, 32);
+    memcpy(block + 32, s_pad32, 32);
+    sha256_core_init(state);
+    sha256_core_blocks(state, block, 1);
+    for (i = 0; i < 8; i++) {
+        hash[4 * i + 0] = (unsigned char) (state[i] >> 24);
+        hash[4 * i + 1] = (unsigned char) (state[i] >> 16);
+        hash[4 * i + 2] = (unsigned char) (state[i] >> 8);
+        hash[4 * i + 3] = (unsigned char) state[i];
+    }
+}
+
+static int has_prefix(const sha256_midstate* mid, const char* input, uint32_t len)
+{
+    return mid && len >= 64 && memcmp(mid->prefix, input, 64) == 0;
+}
+
+void sha256_midstate_init(sha256_midstate* mid, const char* input)
+{
+    sha256_core_init(mid->state);
+    sha256_core_blocks(mid->state, input, 1);
+    memcpy(mid->prefix, input, 64);
+}
+
+void sha256n_hash(const sha256_midstate* mid, int rounds, const char* input, char* output, uint32_t len)
+{
+    unsigned char hash[32];
+    int r;
+
+    if (has_prefix(mid, input, len))
+        sha256_core_final(mid->state, 64, input + 64, len - 64, hash);
+    else
+        sha256_core_hash(input, len, hash);
+    for (r = 1; r < rounds; r++)
+        sha256_32(hash);
+    memcpy(output, hash, 32);
+}
+
+void sha256d_hash(const char* input, char* output, uint32_t len)
+{
+    sha256n_hash(NULL, 2, input, output, len);
+}
+
+void sha256t_hash(const char* input, char* output, uint32_t len)
+{
+    sha256n_hash(NULL, 3, input, output, len);
+}
+
+#ifdef SHA256D_AVX2
+
+/*
+ * Headers whose first 64 bytes match mid go through the AVX2 kernel eight
+ * at a time from the midstate, the other headers from the IV.  A short
+ * last group is padded with copies of its first header as long as that
+ * still beats hashing it one by one: from two hashes without the SHA
+ * extensions, from six with them.
+ */
+static void sha256n_batch_avx2(const sha256_midstate* mid, int rounds, const char* const* inputs,
+    const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    const unsigned char* in[SHA256D_LANES];
+    unsigned char* out[SHA256D_LANES];
+    unsigned char spare[SHA256D_LANES][32];
+    int min_lanes = s_shani ? 6 : 2;
+    int pass, n, l;
+    uint32_t i;
+
+    for (pass = mid ? 0 : 1; pass < 2; pass++) {
+        const uint32_t* state = pass == 0 ? mid->state : NULL;
+
+        n = 0;
+        for (i = 0; i < count; i++) {
+            if (input_lens[i] != SHA256D_HEADER_SIZE || has_prefix(mid, inputs[i], input_lens[i]) != (pass == 0))
+                continue;
+            in[n] = (const unsigned char*) inputs[i];
+            out[n] = (unsigned char*) outputs[i];
+            if (++n == SHA256D_LANES) {
+                sha256n_80_x8_avx2(state, in, rounds, out);
+                n = 0;
+            }
+        }
+
+        if (n >= min_lanes) {
+            for (l = n; l < SHA256D_LANES; l++) {
+                in[l] = in[0];
+                out[l] = spare[l];
+            }
+            sha256n_80_x8_avx2(state, in, rounds, out);
+        } else {
+            for (l = 0; l < n; l++)
+                sha256n_hash(pass == 0 ? mid : NULL, rounds, (const char*) in[l], (char*) out[l], SHA256D_HEADER_SIZE);
+        }
+    }
+
+    for (i = 0; i < count; i++)
+        if (input_lens[i] != SHA256D_HEADER_SIZE)
+            sha256n_hash(mid, rounds, inputs[i], outputs[i], input_lens[i]);
+}
+
+#endif
+
+void sha256n_hash_batch(const sha256_midstate* mid, int rounds, const char* const* inputs,
+    const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint32_t i;
+
+    BACKEND_INIT_ONCE();
+#ifdef SHA256D_AVX2
+    if (s_avx2) {
+        sha256n_batch_avx2(mid, rounds, inputs, input_lens, count, outputs);
+        return;
+    }
+#endif
+    for (i = 0; i < count; i++)
+        sha256n_hash(mid, rounds, inputs[i], outputs[i], input_lens[i]);
+}
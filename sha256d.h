@@ -0,0 +1,39 @@
+#ifndef SHA256D_H
+#define SHA256D_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define SHA256D_HEADER_SIZE 80
+
+/*
+ * The SHA-256 state after the first 64 bytes of a block header, which stay
+ * the same for every nonce of a job.  The prefix is kept so inputs that do
+ * not start with it are still hashed correctly, just without the shortcut.
+ */
+typedef struct {
+    uint32_t state[8];
+    unsigned char prefix[64];
+} sha256_midstate;
+
+void sha256_midstate_init(sha256_midstate* mid, const char* input);
+
+/* SHA-256 applied twice (Bitcoin) and three times (sha256t). */
+void sha256d_hash(const char* input, char* output, uint32_t len);
+void sha256t_hash(const char* input, char* output, uint32_t len);
+
+/* SHA-256 applied rounds times; mid may be NULL. */
+void sha256n_hash(const sha256_midstate* mid, int rounds, const char* input, char* output, uint32_t len);
+
+/* Batches run 80 byte headers eight at a time on AVX2, anything else one by one. */
+void sha256n_hash_batch(const sha256_midstate* mid, int rounds, const char* const* inputs,
+    const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Streebog g_N on AVX2, selected at run time by gost_streebog.c.  The state
+ * stays in two registers of four words; LPS broadcasts each input word, moves
+ * its eight bytes into the index lanes with a shuffle and gathers the words
+ * of its table for all eight outputs.  Where the key schedule is computed
+ * the round's state and key go through LPS together, so two chains of
+ * gathers overlap.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <immintrin.h>
+
+#include "sph_types.h"
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+/* gost_streebog.c */
+extern const sph_u64 streebog_lps[8][256];
+extern const unsigned char streebog_rc[12][64];
+
+/* Shuffle control moving byte j of a broadcast word into the low byte of a qword */
+#define SEL(j)	(0x8080808080808000ULL | (j))
+
+static inline void lps_avx2(__m256i *lo, __m256i *hi)
+{
+	const __m256i sel_lo = _mm256_set_epi64x(SEL(3), SEL(2), SEL(1), SEL(0));
+	const __m256i sel_hi = _mm256_set_epi64x(SEL(7), SEL(6), SEL(5), SEL(4));
+	sph_u64 s[8] __attribute__((aligned(32)));
+	__m256i rlo, rhi, b;
+	int k;
+
+	_mm256_store_si256((__m256i *) s, *lo);
+	_mm256_store_si256((__m256i *) (s + 4), *hi);
+	rlo = _mm256_setzero_si256();
+	rhi = _mm256_setzero_si256();
+	for (k = 0; k < 8; k++) {
+		const long long *T = (const long long *) streebog_lps[7 - k];
+
+		b = _mm256_set1_epi64x((long long) s[k]);
+		rlo = _mm256_xor_si256(rlo, _mm256_i64gather_epi64(T, _mm256_shuffle_epi8(b, sel_lo), 8));
+		rhi = _mm256_xor_si256(rhi, _mm256_i64gather_epi64(T, _mm256_shuffle_epi8(b, sel_hi), 8));
+	}
+	*lo = rlo;
+	*hi = rhi;
+}
+
+/* LPS of the round's state and key together: two independent chains of gathers in flight */
+static inline void lps2_avx2(__m256i *tlo, __m256i *thi, __m256i *klo, __m256i *khi)
+{
+	const __m256i sel_lo = _mm256_set_epi64x(SEL(3), SEL(2), SEL(1), SEL(0));
+	const __m256i sel_hi = _mm256_set_epi64x(SEL(7), SEL(6), SEL(5), SEL(4));
+	sph_u64 s[8] __attribute__((aligned(32))), u[8] __attribute__((aligned(32)));
+	__m256i rlo, rhi, qlo, qhi, b, c;
+	int k;
+
+	_mm256_store_si256((__m256i *) s, *tlo);
+	_mm256_store_si256((__m256i *) (s + 4), *thi);
+	_mm256_store_si256((__m256i *) u, *klo);
+	_mm256_store_si256((__m256i *) (u + 4), *khi);
+	rlo = rhi = qlo = qhi = _mm256_setzero_si256();
+	for (k = 0; k < 8; k++) {
+		const long long *T = (const long long *) streebog_lps[7 - k];
+
+		b = _mm256_set1_epi64x((long long) s[k]);
+		c = _mm256_set1_epi64x((long long) u[k]);
+		rlo = _mm256_xor_si256(rlo, _mm256_i64gather_epi64(T, _mm256_shuffle_epi8(b, sel_lo), 8));
+		qlo = _mm256_xor_si256(qlo, _mm256_i64gather_epi64(T, _mm256_shuffle_epi8(c, sel_lo), 8));
+		rhi = _mm256_xor_si256(rhi, _mm256_i64gather_epi64(T, _mm256_shuffle_epi8(b, sel_hi), 8));
+		qhi = _mm256_xor_si256(qhi, _mm256_i64gather_epi64(T, _mm256_shuffle_epi8(c, sel_hi), 8));
+	}
+	*tlo = rlo;
+	*thi = rhi;
+	*klo = qlo;
+	*khi = qhi;
+}
+
+void streebog_g_N_avx2(sph_u64 *h, const sph_u64 *N, const sph_u64 *m, const sph_u64 (*keys)[8])
+{
+	__m256i mlo = _mm256_loadu_si256((const __m256i *) m);
+	__m256i mhi = _mm256_loadu_si256((const __m256i *) (m + 4));
+	__m256i hlo = _mm256_loadu_si256((const __m256i *) h);
+	__m256i hhi = _mm256_loadu_si256((const __m256i *) (h + 4));
+	__m256i tlo, thi, klo, khi;
+	int i;
+
+	if (keys) {
+		tlo = _mm256_xor_si256(mlo, _mm256_loadu_si256((const __m256i *) keys[0]));
+		thi = _mm256_xor_si256(mhi, _mm256_loadu_si256((const __m256i *) (keys[0] + 4)));
+		for (i = 1; i <= 12; i++) {
+			lps_avx2(&tlo, &thi);
+			tlo = _mm256_xor_si256(tlo, _mm256_loadu_si256((const __m256i *) keys[i]));
+			thi = _mm256_xor_si256(thi, _mm256_loadu_si256((const __m256i *) (keys[i] + 4)));
+		}
+	} else {
+		klo = _mm256_xor_si256(hlo, _mm256_loadu_si256((const __m256i *) N));
+		khi = _mm256_xor_si256(hhi, _mm256_loadu_si256((const __m256i *) (N + 4)));
+		lps_avx2(&klo, &khi);
+		tlo = _mm256_xor_si256(mlo, klo);
+		thi = _mm256_xor_si256(mhi, khi);
+		for (i = 0; i < 12; i++) {
+			klo = _mm256_xor_si256(klo, _mm256_loadu_si256((const __m256i *) streebog_rc[i]));
+			khi = _mm256_xor_si256(khi, _mm256_loadu_si256((const __m256i *) (streebog_rc[i] + 32)));
+			lps2_avx2(&tlo, &thi, &klo, &khi);
+			tlo = _mm256_xor_si256(tlo, klo);
+			thi = _mm256_xor_si256(thi, khi);
+		}
+	}
+
+	hlo = _mm256_xor_si256(hlo, _mm256_xor_si256(tlo, mlo));
+	hhi = _mm256_xor_si256(hhi, _mm256_xor_si256(thi, mhi));
+	_mm256_storeu_si256((__m256i *) h, hlo);
+	_mm256_storeu_si256((__m256i *) (h + 4), hhi);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
@@ -6,6 +6,13 @@
 #include <math.h>
 
 #include "gost_streebog.h"
+#include "../cpu_features.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 
 #ifdef __cplusplus
 extern "C"{
@@ -24,7 +31,7 @@ extern "C"{
 
 
 // Tables for function F
-static const sph_u64 TG[8][256] = {{
+const sph_u64 streebog_lps[8][256] = {{
 	0xE6F87E5C5B711FD0,0x258377800924FA16,0xC849E07E852EA4A8,0x5B4686A18F06C16A,
 	0x0B32E9A2D77B416E,0xABDA37A467815C66,0xF61796A81A686676,0xF5DC0B706391954B,
 	0x4862F38DB7E64BF1,0xFF5C629A68BD85C5,0xCB827DA6FCD75795,0x66D36DAF69B9F089,
@@ -547,7 +554,7 @@ static const sph_u64 TG[8][256] = {{
 }};
 
 // Constant values for KeySchedule function
-const unsigned char C[12][64] = {{
+const unsigned char streebog_rc[12][64] = {{
 	0xB1,0x08,0x5B,0xDA,0x1E,0xCA,0xDA,0xE9,0xEB,0xCB,0x2F,0x81,0xC0,0x65,0x7C,0x1F,
 	0x2F,0x6A,0x76,0x43,0x2E,0x45,0xD0,0x16,0x71,0x4E,0xB8,0x8D,0x75,0x85,0xC4,0xFC,
 	0x4B,0x7C,0xE0,0x91,0x92,0x67,0x69,0x01,0xA2,0x42,0x2A,0x08,0xA4,0x60,0xD3,0x15,
@@ -694,287 +701,201 @@ static void AddModulo512(const void *a,const void *b,void *c)
 #endif
 }
 
-static void AddXor512(const void *a,const void *b,void *c)
+/*
+ * LPS on 64 bit words: byte i of a block is byte i % 8 of word i / 8 (the
+ * tables already assume a little endian host), so each output word is one
+ * lookup per input word, byte j of every word feeding output word j.
+ */
+#define LPS_WORD(s, j) ( \
+	streebog_lps[0][(unsigned char) ((s)[7] >> (8 * (j)))] ^ \
+	streebog_lps[1][(unsigned char) ((s)[6] >> (8 * (j)))] ^ \
+	streebog_lps[2][(unsigned char) ((s)[5] >> (8 * (j)))] ^ \
+	streebog_lps[3][(unsigned char) ((s)[4] >> (8 * (j)))] ^ \
+	streebog_lps[4][(unsigned char) ((s)[3] >> (8 * (j)))] ^ \
+	streebog_lps[5][(unsigned char) ((s)[2] >> (8 * (j)))] ^ \
+	streebog_lps[6][(unsigned char) ((s)[1] >> (8 * (j)))] ^ \
+	streebog_lps[7][(unsigned char) ((s)[0] >> (8 * (j)))])
+
+static void LPS(sph_u64 *s)
 {
-	const unsigned long long *A=a, *B=b;
-	unsigned long long *C=c;
-#ifdef FULL_UNROLL
-	C[0] = A[0] ^ B[0];
-	C[1] = A[1] ^ B[1];
-	C[2] = A[2] ^ B[2];
-	C[3] = A[3] ^ B[3];
-	C[4] = A[4] ^ B[4];
-	C[5] = A[5] ^ B[5];
-	C[6] = A[6] ^ B[6];
-	C[7] = A[7] ^ B[7];
-#else
-	int i = 0;
-
-	for(i=0; i<8; i++) {
-		C[i] = A[i] ^ B[i];
-	}
-#endif
+	sph_u64 r[8];
+
+	r[0] = LPS_WORD(s, 0);
+	r[1] = LPS_WORD(s, 1);
+	r[2] = LPS_WORD(s, 2);
+	r[3] = LPS_WORD(s, 3);
+	r[4] = LPS_WORD(s, 4);
+	r[5] = LPS_WORD(s, 5);
+	r[6] = LPS_WORD(s, 6);
+	r[7] = LPS_WORD(s, 7);
+	memcpy(s, r, 64);
 }
 
-static void F(unsigned char *state)
+static void XorRC(sph_u64 *K, int i)
 {
-	unsigned long long return_state[8];
-	register unsigned long long r = 0;
-	r ^= TG[0][state[56]];
-	r ^= TG[1][state[48]];
-	r ^= TG[2][state[40]];
-	r ^= TG[3][state[32]];
-	r ^= TG[4][state[24]];
-	r ^= TG[5][state[16]];
-	r ^= TG[6][state[8]];
-	r ^= TG[7][state[0]];
-	return_state[0] = r;
-	r = 0;
-
-	r ^= TG[0][state[57]];
-	r ^= TG[1][state[49]];
-	r ^= TG[2][state[41]];
-	r ^= TG[3][state[33]];
-	r ^= TG[4][state[25]];
-	r ^= TG[5][state[17]];
-	r ^= TG[6][state[9]];
-	r ^= TG[7][state[1]];
-	return_state[1] = r;
-	r = 0;
-
-	r ^= TG[0][state[58]];
-	r ^= TG[1][state[50]];
-	r ^= TG[2][state[42]];
-	r ^= TG[3][state[34]];
-	r ^= TG[4][state[26]];
-	r ^= TG[5][state[18]];
-	r ^= TG[6][state[10]];
-	r ^= TG[7][state[2]];
-	return_state[2] = r;
-	r = 0;
-
-	r ^= TG[0][state[59]];
-	r ^= TG[1][state[51]];
-	r ^= TG[2][state[43]];
-	r ^= TG[3][state[35]];
-	r ^= TG[4][state[27]];
-	r ^= TG[5][state[19]];
-	r ^= TG[6][state[11]];
-	r ^= TG[7][state[3]];
-	return_state[3] = r;
-	r = 0;
-
-	r ^= TG[0][state[60]];
-	r ^= TG[1][state[52]];
-	r ^= TG[2][state[44]];
-	r ^= TG[3][state[36]];
-	r ^= TG[4][state[28]];
-	r ^= TG[5][state[20]];
-	r ^= TG[6][state[12]];
-	r ^= TG[7][state[4]];
-	return_state[4] = r;
-	r = 0;
-
-	r ^= TG[0][state[61]];
-	r ^= TG[1][state[53]];
-	r ^= TG[2][state[45]];
-	r ^= TG[3][state[37]];
-	r ^= TG[4][state[29]];
-	r ^= TG[5][state[21]];
-	r ^= TG[6][state[13]];
-	r ^= TG[7][state[5]];
-	return_state[5] = r;
-	r = 0;
-
-	r ^= TG[0][state[62]];
-	r ^= TG[1][state[54]];
-	r ^= TG[2][state[46]];
-	r ^= TG[3][state[38]];
-	r ^= TG[4][state[30]];
-	r ^= TG[5][state[22]];
-	r ^= TG[6][state[14]];
-	r ^= TG[7][state[6]];
-	return_state[6] = r;
-	r = 0;
-
-	r ^= TG[0][state[63]];
-	r ^= TG[1][state[55]];
-	r ^= TG[2][state[47]];
-	r ^= TG[3][state[39]];
-	r ^= TG[4][state[31]];
-	r ^= TG[5][state[23]];
-	r ^= TG[6][state[15]];
-	r ^= TG[7][state[7]];
-	return_state[7] = r;
-
-	memcpy(state,(unsigned char*)return_state,64);
-}
+	sph_u64 c[8];
+	int j;
 
-#define KeySchedule(K,i) AddXor512(K,C[i],K); F(K);
+	memcpy(c, streebog_rc[i], 64);
+	for (j = 0; j < 8; j++)
+		K[j] ^= c[j];
+}
 
-static void E(unsigned char *K,const unsigned char *m, unsigned char *state)
+/*
+ * g_N(h, m): keys, when not NULL, is the whole key schedule K1..K13 of this
+ * call, which only depends on h ^ N and so is fixed for the first block of
+ * each IV.
+ */
+static void g_N_scalar(sph_u64 *h, const sph_u64 *N, const sph_u64 *m, const sph_u64 (*keys)[8])
 {
-#ifdef FULL_UNROLL
-	AddXor512(m,K,state);
-
-	F(state);
-	KeySchedule(K,0);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,1);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,2);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,3);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,4);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,5);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,6);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,7);
-	AddXor512(state,K,state);
-
-	F(state);
-	KeySchedule(K,8);
-	AddXor512(state,K,state);
+	sph_u64 K[8], t[8];
+	int i, j;
+
+	if (keys) {
+		for (j = 0; j < 8; j++)
+			t[j] = m[j] ^ keys[0][j];
+		for (i = 1; i <= 12; i++) {
+			LPS(t);
+			for (j = 0; j < 8; j++)
+				t[j] ^= keys[i][j];
+		}
+	} else {
+		for (j = 0; j < 8; j++)
+			K[j] = h[j] ^ N[j];
+		LPS(K);
+		for (j = 0; j < 8; j++)
+			t[j] = m[j] ^ K[j];
+		for (i = 0; i < 12; i++) {
+			LPS(t);
+			XorRC(K, i);
+			LPS(K);
+			for (j = 0; j < 8; j++)
+				t[j] ^= K[j];
+		}
+	}
 
-	F(state);
-	KeySchedule(K,9);
-	AddXor512(state,K,state);
+	for (j = 0; j < 8; j++)
+		h[j] ^= t[j] ^ m[j];
+}
 
-	F(state);
-	KeySchedule(K,10);
-	AddXor512(state,K,state);
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define STREEBOG_AVX2 1
+/* gost_streebog-avx2.c */
+extern void streebog_g_N_avx2(sph_u64 *h, const sph_u64 *N, const sph_u64 *m, const sph_u64 (*keys)[8]);
+#endif
 
-	F(state);
-	KeySchedule(K,11);
-	AddXor512(state,K,state);
-#else
-	int i = 0;
+typedef void (*streebog_g_fn)(sph_u64 *h, const sph_u64 *N, const sph_u64 *m, const sph_u64 (*keys)[8]);
 
-	AddXor512(m,K,state);
+static streebog_g_fn s_g_N = g_N_scalar;
+static sph_u64 s_keys512[13][8];
+static sph_u64 s_keys256[13][8];
 
-	for(i=0;i<12;i++) {
-		F(state);
-		KeySchedule(K,i);
-		AddXor512(state,K,state);
+static void KeysForIV(sph_u64 (*keys)[8], unsigned char iv)
+{
+	int i;
+
+	memset(keys[0], iv, 64);
+	LPS(keys[0]);
+	for (i = 0; i < 12; i++) {
+		memcpy(keys[i + 1], keys[i], 64);
+		XorRC(keys[i + 1], i);
+		LPS(keys[i + 1]);
 	}
-#endif
 }
 
-static void g_N(const unsigned char *N,unsigned char *h,const unsigned char *m)
+/*
+ * The AVX2 backend gathers each table column for four output words at once;
+ * SSE4.1 has no gather, and building the indexes with pextr/pinsr was slower
+ * than the scalar lookups.  Four messages in lockstep, one per lane, gather
+ * the same number of words plus a shift and a mask for every index, and were
+ * slower than this one message at a time.
+ */
+static void select_backend(void)
 {
-	unsigned char t[64], K[64];
-
-	AddXor512(N,h,K);
-
-	F(K);
-
-	E(K,m,t);
+	KeysForIV(s_keys512, 0x00);
+	KeysForIV(s_keys256, 0x01);
+#ifdef STREEBOG_AVX2
+	if (cpu_has(CPU_FEATURE_AVX2))
+		s_g_N = streebog_g_N_avx2;
+#endif
+}
 
-	AddXor512(t,h,t);
-	AddXor512(t,m,h);
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID *ctx)
+{
+	select_backend();
+	return TRUE;
 }
+#define BACKEND_INIT_ONCE()	InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()	pthread_once(&s_backend_once, select_backend)
+#endif
 
-static void hash_X(unsigned char *IV,const unsigned char *message,unsigned long long length,unsigned char *out)
+/*
+ * Blocks are taken from the end of the message backwards; N and Sigma are
+ * kept as the big endian byte strings AddModulo512() works on.
+ */
+static void hash_X(sph_u64 *h, const sph_u64 (*keys)[8], const unsigned char *message, size_t len)
 {
-	unsigned char v512[64] = {
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x02,0x00
-	};
-	unsigned char v0[64] = {
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-	};
-	unsigned char Sigma[64] = {
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-	};
-	unsigned char N[64] = {
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-	};
-	unsigned char m[64], *hash = IV;
-	unsigned long long len = length;
+	static const sph_u64 v0[8];
+	unsigned char v512[64];
+	sph_u64 N[8], Sigma[8], m[8];
+
+	BACKEND_INIT_ONCE();
+	memset(N, 0, sizeof N);
+	memset(Sigma, 0, sizeof Sigma);
+	memset(v512, 0, sizeof v512);
+	v512[62] = 0x02;
 
 	// Stage 2
-	while (len >= 512)
+	while (len >= 64)
 	{
-		memcpy(m, message + len/8 - 63 - ( (len & 0x7) == 0 ), 64);
+		memcpy(m, message + len - 64, 64);
 
-		g_N(N,hash,m);
-		AddModulo512(N,v512,N);
-		AddModulo512(Sigma,m,Sigma);
-		len -= 512;
+		s_g_N(h, N, m, keys);
+		keys = NULL;
+		AddModulo512(N, v512, N);
+		AddModulo512(Sigma, m, Sigma);
+		len -= 64;
 	}
 
-	memset(m,0,64);
-	memcpy(m + 63 - len/8 + ( (len & 0x7) == 0 ), message, len/8 + 1 - ( (len & 0x7) == 0 ));
+	memset(m, 0, 64);
+	memcpy((unsigned char *) m + 64 - len, message, len);
 
 	// Stage 3
-	m[ 63 - len/8 ] |= (1 << (len & 0x7));
-
-	g_N(N,hash,m);
-	v512[63] = len & 0xFF;
-	v512[62] = (unsigned char) (len >> 8);
-	AddModulo512(N,v512,N);
+	((unsigned char *) m)[63 - len] |= 1;
 
-	AddModulo512(Sigma,m,Sigma);
+	s_g_N(h, N, m, keys);
+	v512[63] = (unsigned char) (len << 3);
+	v512[62] = (unsigned char) (len >> 5);
+	AddModulo512(N, v512, N);
 
-	g_N(v0,hash,N);
-	g_N(v0,hash,Sigma);
+	AddModulo512(Sigma, m, Sigma);
 
-	memcpy(out, hash, 64);
+	s_g_N(h, v0, N, NULL);
+	s_g_N(h, v0, Sigma, NULL);
 }
 
-static void hash_512(const unsigned char *message, unsigned long long length, unsigned char *out)
+static void hash_512(const unsigned char *message, size_t len, unsigned char *out)
 {
-	unsigned char IV[64] = {
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-		0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-	};
-
-	hash_X(IV,message,length,out);
+	sph_u64 h[8];
+
+	memset(h, 0x00, sizeof h);
+	hash_X(h, (const sph_u64 (*)[8]) s_keys512, message, len);
+
+	memcpy(out, h, 64);
 }
 
-static void hash_256(const unsigned char *message, unsigned long long length, unsigned char *out)
+static void hash_256(const unsigned char *message, size_t len, unsigned char *out)
 {
-	unsigned char IV[64] = {
-		0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
-		0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
-		0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
-		0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01
-	};
-	unsigned char hash[64];
+	sph_u64 h[8];
 
-	hash_X(IV,message,length,hash);
+	memset(h, 0x01, sizeof h);
+	hash_X(h, (const sph_u64 (*)[8]) s_keys256, message, len);
 
-	memcpy(out,hash,32);
+	memcpy(out, h, 32);
 }
 
 
@@ -987,7 +908,7 @@ void sph_gost256_init(void *cc)
 
 void sph_gost256(void *cc, const void *data, size_t len)
 {
-	hash_256(data, 8*len, cc);
+	hash_256(data, len, cc);
 }
 
 void sph_gost256_close(void *cc, void *dst)
@@ -1005,7 +926,7 @@ void sph_gost512_init(void *cc)
 
 void sph_gost512(void *cc, const void *data, size_t len)
 {
-	hash_512(data, 8*len, cc);
+	hash_512(data, len, cc);
 }
 
 void sph_gost512_close(void *cc, void *dst)
@@ -0,0 +1,174 @@
+/*
+ * Hamsi-384/512 compression on AVX2, selected at run time by hamsi.c.
+ *
+ * The 32 state words are held as four rows of eight, A = s00..s07 through
+ * D = s18..s1F: the S-box works on columns and the first L layer on the
+ * diagonals (A[i], B[i+1], C[i+2], D[i+3]), so both run on whole rows
+ * with the three lower rows rotated into place.  The second L layer takes
+ * four words from each row; those are transposed into four lanes.
+ *
+ * The message expansion is linear, so instead of the 128 KB of byte-wise
+ * tables it XORs together the rows of the 64 x 16 word generator matrix
+ * selected by the message bits.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stddef.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "sph_types.h"
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+#define XOR(a, b)       _mm256_xor_si256(a, b)
+#define ROTL(x, n)      _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define SBOX(a, b, c, d)   do { \
+        __m256i t = (a); \
+        (a) = _mm256_and_si256(a, c); \
+        (a) = XOR(a, d); \
+        (c) = XOR(c, b); \
+        (c) = XOR(c, a); \
+        (d) = _mm256_or_si256(d, t); \
+        (d) = XOR(d, b); \
+        t = XOR(t, c); \
+        (b) = (d); \
+        (d) = _mm256_or_si256(d, t); \
+        (d) = XOR(d, a); \
+        (a) = _mm256_and_si256(a, b); \
+        t = XOR(t, a); \
+        (b) = XOR(b, d); \
+        (b) = XOR(b, t); \
+        (a) = (c); \
+        (c) = (b); \
+        (b) = (d); \
+        (d) = XOR(t, ones); \
+    } while (0)
+
+#define L(a, b, c, d)   do { \
+        (a) = ROTL(a, 13); \
+        (c) = ROTL(c, 3); \
+        (b) = XOR(b, XOR(a, c)); \
+        (d) = XOR(d, XOR(c, _mm256_slli_epi32(a, 3))); \
+        (b) = ROTL(b, 1); \
+        (d) = ROTL(d, 7); \
+        (a) = XOR(a, XOR(b, d)); \
+        (c) = XOR(c, XOR(d, _mm256_slli_epi32(b, 7))); \
+        (a) = ROTL(a, 5); \
+        (c) = ROTL(c, 22); \
+    } while (0)
+
+/* Four rows of four words each into four vectors of one word from each row, and back */
+#define TRANSPOSE4(r0, r1, r2, r3)   do { \
+        __m256i t0 = _mm256_unpacklo_epi32(r0, r1); \
+        __m256i t1 = _mm256_unpacklo_epi32(r2, r3); \
+        __m256i t2 = _mm256_unpackhi_epi32(r0, r1); \
+        __m256i t3 = _mm256_unpackhi_epi32(r2, r3); \
+        (r0) = _mm256_unpacklo_epi64(t0, t1); \
+        (r1) = _mm256_unpackhi_epi64(t0, t1); \
+        (r2) = _mm256_unpacklo_epi64(t2, t3); \
+        (r3) = _mm256_unpackhi_epi64(t2, t3); \
+    } while (0)
+
+#define IDX(i0, i1, i2, i3, i4, i5, i6, i7)   _mm256_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7)
+
+/* Message bit k set: rows[k] goes into the expanded message */
+#define EXPAND_BIT(x, k)   do { \
+        __m256i mask = _mm256_srai_epi32(x, 31); \
+        m0 = XOR(m0, _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i*) rows[k]))); \
+        m1 = XOR(m1, _mm256_and_si256(mask, _mm256_loadu_si256((const __m256i*) (rows[k] + 8)))); \
+        x = _mm256_add_epi32(x, x); \
+    } while (0)
+
+void hamsi_big_avx2(sph_u32 h[16], const unsigned char* buf, size_t num,
+    const sph_u32* alpha, unsigned rounds, const sph_u32 (*rows)[16])
+{
+    const __m256i ones = _mm256_set1_epi32(-1);
+    const __m256i rot1 = IDX(1, 2, 3, 4, 5, 6, 7, 0), rot2 = IDX(2, 3, 4, 5, 6, 7, 0, 1);
+    const __m256i rot3 = IDX(3, 4, 5, 6, 7, 0, 1, 2), rot5 = IDX(5, 6, 7, 0, 1, 2, 3, 4);
+    const __m256i rot6 = IDX(6, 7, 0, 1, 2, 3, 4, 5), rot7 = IDX(7, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i alpha_a = _mm256_loadu_si256((const __m256i*) alpha);
+    const __m256i alpha_b = _mm256_loadu_si256((const __m256i*) (alpha + 8));
+    const __m256i alpha_c = _mm256_loadu_si256((const __m256i*) (alpha + 16));
+    const __m256i alpha_d = _mm256_loadu_si256((const __m256i*) (alpha + 24));
+    const __m256i rc_step = _mm256_setr_epi32(0, 1, 0, 0, 0, 0, 0, 0);
+    __m256i h0 = _mm256_loadu_si256((const __m256i*) h);
+    __m256i h1 = _mm256_loadu_si256((const __m256i*) (h + 8));
+
+    for (; num; num--, buf += 8) {
+        __m256i m0 = _mm256_setzero_si256(), m1 = m0, rc = m0, x, lo, hi, a, b, c, d;
+        sph_u32 w[2];
+        unsigned r;
+        int k;
+
+        memcpy(w, buf, 8);
+        x = _mm256_set1_epi32((int) w[0]);
+        for (k = 31; k >= 0; k--)
+            EXPAND_BIT(x, k);
+        x = _mm256_set1_epi32((int) w[1]);
+        for (k = 63; k >= 32; k--)
+            EXPAND_BIT(x, k);
+
+        /* a = m0 m1 c0 c1 m2 m3 c2 c3, b = c4 c5 m4 m5 c6 c7 m6 m7, c and d likewise */
+        lo = _mm256_unpacklo_epi64(m0, h0);
+        hi = _mm256_unpackhi_epi64(m0, h0);
+        a = _mm256_permute2x128_si256(lo, hi, 0x20);
+        b = _mm256_shuffle_epi32(_mm256_permute2x128_si256(lo, hi, 0x31), 0x4E);
+        lo = _mm256_unpacklo_epi64(m1, h1);
+        hi = _mm256_unpackhi_epi64(m1, h1);
+        c = _mm256_permute2x128_si256(lo, hi, 0x20);
+        d = _mm256_shuffle_epi32(_mm256_permute2x128_si256(lo, hi, 0x31), 0x4E);
+
+        for (r = 0; r < rounds; r++) {
+            __m256i p, q, s, t;
+
+            /* The round number goes into s01 */
+            a = XOR(a, XOR(alpha_a, rc));
+            rc = _mm256_add_epi32(rc, rc_step);
+            b = XOR(b, alpha_b);
+            c = XOR(c, alpha_c);
+            d = XOR(d, alpha_d);
+            SBOX(a, b, c, d);
+
+            b = _mm256_permutevar8x32_epi32(b, rot1);
+            c = _mm256_permutevar8x32_epi32(c, rot2);
+            d = _mm256_permutevar8x32_epi32(d, rot3);
+            L(a, b, c, d);
+            b = _mm256_permutevar8x32_epi32(b, rot7);
+            c = _mm256_permutevar8x32_epi32(c, rot6);
+            d = _mm256_permutevar8x32_epi32(d, rot5);
+
+            /* L(s00, s02, s05, s07), L(s10, s13, s15, s16), L(s09, s0B, s0C, s0E), L(s19, s1A, s1C, s1F) */
+            p = _mm256_permutevar8x32_epi32(a, IDX(0, 2, 5, 7, 0, 0, 0, 0));
+            q = _mm256_permutevar8x32_epi32(c, IDX(0, 3, 5, 6, 0, 0, 0, 0));
+            s = _mm256_permutevar8x32_epi32(b, IDX(1, 3, 4, 6, 0, 0, 0, 0));
+            t = _mm256_permutevar8x32_epi32(d, IDX(1, 2, 4, 7, 0, 0, 0, 0));
+            TRANSPOSE4(p, q, s, t);
+            L(p, q, s, t);
+            TRANSPOSE4(p, q, s, t);
+            a = _mm256_blend_epi32(a, _mm256_permutevar8x32_epi32(p, IDX(0, 0, 1, 0, 0, 2, 0, 3)), 0xA5);
+            c = _mm256_blend_epi32(c, _mm256_permutevar8x32_epi32(q, IDX(0, 0, 0, 1, 0, 2, 3, 0)), 0x69);
+            b = _mm256_blend_epi32(b, _mm256_permutevar8x32_epi32(s, IDX(0, 0, 0, 1, 2, 0, 3, 0)), 0x5A);
+            d = _mm256_blend_epi32(d, _mm256_permutevar8x32_epi32(t, IDX(0, 0, 1, 0, 2, 0, 0, 3)), 0x96);
+        }
+
+        /* T_BIG: the chaining words sit where s00..s07 and s10..s17 were */
+        h0 = XOR(h0, a);
+        h1 = XOR(h1, c);
+    }
+
+    _mm256_storeu_si256((__m256i*) h, h0);
+    _mm256_storeu_si256((__m256i*) (h + 8), h1);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
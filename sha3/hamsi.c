@@ -34,6 +34,13 @@
 #include <string.h>
 
 #include "sph_hamsi.h"
+#include "../cpu_features.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 
 #ifdef __cplusplus
 extern "C"{
@@ -617,6 +624,73 @@ hamsi_small_close(sph_hamsi_small_context *sc,
         c0 = (sc->h[0x0] ^= s00); \
     } while (0)
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HAMSI_AVX2 1
+/* hamsi-avx2.c */
+extern void hamsi_big_avx2(sph_u32 h[16], const unsigned char *buf, size_t num,
+    const sph_u32 *alpha, unsigned rounds, const sph_u32 (*rows)[16]);
+#endif
+
+#ifdef HAMSI_AVX2
+
+/*
+ * Rows of the Hamsi-384/512 expansion's generator matrix, row k being the
+ * expansion of message bit k alone.  The AVX2 backend builds each expanded
+ * message from these 4 KB instead of the lookup tables above.
+ */
+static sph_u32 s_expand_rows[64][16];
+static int s_avx2;
+
+static void
+select_backend(void)
+{
+    unsigned k;
+
+    if (!cpu_has(CPU_FEATURE_AVX2))
+        return;
+    for (k = 0; k < 64; k ++) {
+        unsigned char buf[8];
+        sph_u32 m0, m1, m2, m3, m4, m5, m6, m7;
+        sph_u32 m8, m9, mA, mB, mC, mD, mE, mF;
+
+        memset(buf, 0, sizeof buf);
+        buf[k >> 3] = 1 << (k & 7);
+        INPUT_BIG;
+        s_expand_rows[k][0x0] = m0;
+        s_expand_rows[k][0x1] = m1;
+        s_expand_rows[k][0x2] = m2;
+        s_expand_rows[k][0x3] = m3;
+        s_expand_rows[k][0x4] = m4;
+        s_expand_rows[k][0x5] = m5;
+        s_expand_rows[k][0x6] = m6;
+        s_expand_rows[k][0x7] = m7;
+        s_expand_rows[k][0x8] = m8;
+        s_expand_rows[k][0x9] = m9;
+        s_expand_rows[k][0xA] = mA;
+        s_expand_rows[k][0xB] = mB;
+        s_expand_rows[k][0xC] = mC;
+        s_expand_rows[k][0xD] = mD;
+        s_expand_rows[k][0xE] = mE;
+        s_expand_rows[k][0xF] = mF;
+    }
+    s_avx2 = 1;
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID *ctx)
+{
+    select_backend();
+    return TRUE;
+}
+#define BACKEND_INIT_ONCE()     InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()     pthread_once(&s_backend_once, select_backend)
+#endif
+
+#endif
+
 static void
 hamsi_big(sph_hamsi_big_context *sc, const unsigned char *buf, size_t num)
 {
@@ -633,6 +707,13 @@ hamsi_big(sph_hamsi_big_context *sc, const unsigned char *buf, size_t num)
     sc->count_high += (sph_u32)((num >> 13) >> 13);
     if (sc->count_low < tmp)
         sc->count_high ++;
+#endif
+#ifdef HAMSI_AVX2
+    BACKEND_INIT_ONCE();
+    if (s_avx2) {
+        hamsi_big_avx2(sc->h, buf, num, alpha_n, 6, (const sph_u32 (*)[16]) s_expand_rows);
+        return;
+    }
 #endif
     READ_STATE_BIG(sc);
     while (num -- > 0) {
@@ -654,6 +735,13 @@ hamsi_big_final(sph_hamsi_big_context *sc, const unsigned char *buf)
     sph_u32 m8, m9, mA, mB, mC, mD, mE, mF;
     DECL_STATE_BIG
 
+#ifdef HAMSI_AVX2
+    BACKEND_INIT_ONCE();
+    if (s_avx2) {
+        hamsi_big_avx2(sc->h, buf, 1, alpha_f, 12, (const sph_u32 (*)[16]) s_expand_rows);
+        return;
+    }
+#endif
     READ_STATE_BIG(sc);
     INPUT_BIG;
     PF_BIG;
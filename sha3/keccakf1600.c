@@ -0,0 +1,326 @@
+/*
+ * Keccak-f[1600], fully unrolled.
+ *
+ * Rounds alternate between two sets of 25 lane variables (A -> E -> A) so no
+ * copies are needed between rounds.  Lane names follow the Keccak team's
+ * reference code: rows b, g, k, m, s (y = 0..4), columns a, e, i, o, u
+ * (x = 0..4).
+ */
+
+#include <string.h>
+
+#include "keccakf1600.h"
+#include "../cpu_features.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define KECCAKF_X86_DISPATCH 1
+#endif
+
+static const uint64_t RC[24] = {
+	0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+	0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+	0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+	0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+	0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+	0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+	0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+	0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/* Lane type; the AVX2 instantiation below swaps in a 4-lane vector. */
+#define KF_T   uint64_t
+
+#define ROL64(a, n)   (((a) << (n)) | ((a) >> (64 - (n))))
+
+/* Column parity: standard, and Boolberry's multiplying variant. */
+#define THETA_XOR(b, g, k, m, s)   ((b) ^ (g) ^ (k) ^ (m) ^ (s))
+#define THETA_MUL(b, g, k, m, s)   ((b) ^ (g) ^ (k) * (m) * (s))
+
+/* Chi on one row, plain form: compiles to ANDN with BMI1. */
+#define CHI_PLAIN_ROW(E, r)   do { \
+		E##r##a = Ba ^ (~Be & Bi); \
+		E##r##e = Be ^ (~Bi & Bo); \
+		E##r##i = Bi ^ (~Bo & Bu); \
+		E##r##o = Bo ^ (~Bu & Ba); \
+		E##r##u = Bu ^ (~Ba & Be); \
+	} while (0)
+
+#define CHI_PLAIN_b(E)   CHI_PLAIN_ROW(E, b)
+#define CHI_PLAIN_g(E)   CHI_PLAIN_ROW(E, g)
+#define CHI_PLAIN_k(E)   CHI_PLAIN_ROW(E, k)
+#define CHI_PLAIN_m(E)   CHI_PLAIN_ROW(E, m)
+#define CHI_PLAIN_s(E)   CHI_PLAIN_ROW(E, s)
+
+/*
+ * Chi with lane complementing: lanes be, bi, go, ki, mi and sa are stored
+ * inverted, which turns all but one NOT per row into OR/AND.
+ */
+#define CHI_LC_b(E)   do { \
+		E##ba = Ba ^ (Be | Bi); \
+		E##be = Be ^ (~Bi | Bo); \
+		E##bi = Bi ^ (Bo & Bu); \
+		E##bo = Bo ^ (Bu | Ba); \
+		E##bu = Bu ^ (Ba & Be); \
+	} while (0)
+
+#define CHI_LC_g(E)   do { \
+		E##ga = Ba ^ (Be | Bi); \
+		E##ge = Be ^ (Bi & Bo); \
+		E##gi = Bi ^ (Bo | ~Bu); \
+		E##go = Bo ^ (Bu | Ba); \
+		E##gu = Bu ^ (Ba & Be); \
+	} while (0)
+
+#define CHI_LC_k(E)   do { \
+		E##ka = Ba ^ (Be | Bi); \
+		E##ke = Be ^ (Bi & Bo); \
+		E##ki = Bi ^ (~Bo & Bu); \
+		E##ko = ~Bo ^ (Bu | Ba); \
+		E##ku = Bu ^ (Ba & Be); \
+	} while (0)
+
+#define CHI_LC_m(E)   do { \
+		E##ma = Ba ^ (Be & Bi); \
+		E##me = Be ^ (Bi | Bo); \
+		E##mi = Bi ^ (~Bo | Bu); \
+		E##mo = ~Bo ^ (Bu & Ba); \
+		E##mu = Bu ^ (Ba | Be); \
+	} while (0)
+
+#define CHI_LC_s(E)   do { \
+		E##sa = Ba ^ (~Be & Bi); \
+		E##se = ~Be ^ (Bi | Bo); \
+		E##si = Bi ^ (Bo & Bu); \
+		E##so = Bo ^ (Bu | Ba); \
+		E##su = Bu ^ (Ba & Be); \
+	} while (0)
+
+/* One round, reading lanes A.. and writing lanes E.. */
+#define KF_ROUND(A, E, rc, THETA, CHI)   do { \
+		KF_T Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du; \
+		KF_T Ba, Be, Bi, Bo, Bu; \
+		Ca = THETA(A##ba, A##ga, A##ka, A##ma, A##sa); \
+		Ce = THETA(A##be, A##ge, A##ke, A##me, A##se); \
+		Ci = THETA(A##bi, A##gi, A##ki, A##mi, A##si); \
+		Co = THETA(A##bo, A##go, A##ko, A##mo, A##so); \
+		Cu = THETA(A##bu, A##gu, A##ku, A##mu, A##su); \
+		Da = Cu ^ ROL64(Ce, 1); \
+		De = Ca ^ ROL64(Ci, 1); \
+		Di = Ce ^ ROL64(Co, 1); \
+		Do = Ci ^ ROL64(Cu, 1); \
+		Du = Co ^ ROL64(Ca, 1); \
+		Ba = A##ba ^ Da; \
+		Be = ROL64(A##ge ^ De, 44); \
+		Bi = ROL64(A##ki ^ Di, 43); \
+		Bo = ROL64(A##mo ^ Do, 21); \
+		Bu = ROL64(A##su ^ Du, 14); \
+		CHI##_b(E); \
+		E##ba ^= (rc); \
+		Ba = ROL64(A##bo ^ Do, 28); \
+		Be = ROL64(A##gu ^ Du, 20); \
+		Bi = ROL64(A##ka ^ Da, 3); \
+		Bo = ROL64(A##me ^ De, 45); \
+		Bu = ROL64(A##si ^ Di, 61); \
+		CHI##_g(E); \
+		Ba = ROL64(A##be ^ De, 1); \
+		Be = ROL64(A##gi ^ Di, 6); \
+		Bi = ROL64(A##ko ^ Do, 25); \
+		Bo = ROL64(A##mu ^ Du, 8); \
+		Bu = ROL64(A##sa ^ Da, 18); \
+		CHI##_k(E); \
+		Ba = ROL64(A##bu ^ Du, 27); \
+		Be = ROL64(A##ga ^ Da, 36); \
+		Bi = ROL64(A##ke ^ De, 10); \
+		Bo = ROL64(A##mi ^ Di, 15); \
+		Bu = ROL64(A##so ^ Do, 56); \
+		CHI##_m(E); \
+		Ba = ROL64(A##bi ^ Di, 62); \
+		Be = ROL64(A##go ^ Do, 55); \
+		Bi = ROL64(A##ku ^ Du, 39); \
+		Bo = ROL64(A##ma ^ Da, 41); \
+		Bu = ROL64(A##se ^ De, 2); \
+		CHI##_s(E); \
+	} while (0)
+
+#define KF_DECL(X) \
+	KF_T X##ba, X##be, X##bi, X##bo, X##bu; \
+	KF_T X##ga, X##ge, X##gi, X##go, X##gu; \
+	KF_T X##ka, X##ke, X##ki, X##ko, X##ku; \
+	KF_T X##ma, X##me, X##mi, X##mo, X##mu; \
+	KF_T X##sa, X##se, X##si, X##so, X##su
+
+#define KF_LOAD(X, st)   do { \
+		X##ba = st[ 0]; X##be = st[ 1]; X##bi = st[ 2]; X##bo = st[ 3]; X##bu = st[ 4]; \
+		X##ga = st[ 5]; X##ge = st[ 6]; X##gi = st[ 7]; X##go = st[ 8]; X##gu = st[ 9]; \
+		X##ka = st[10]; X##ke = st[11]; X##ki = st[12]; X##ko = st[13]; X##ku = st[14]; \
+		X##ma = st[15]; X##me = st[16]; X##mi = st[17]; X##mo = st[18]; X##mu = st[19]; \
+		X##sa = st[20]; X##se = st[21]; X##si = st[22]; X##so = st[23]; X##su = st[24]; \
+	} while (0)
+
+#define KF_STORE(X, st)   do { \
+		st[ 0] = X##ba; st[ 1] = X##be; st[ 2] = X##bi; st[ 3] = X##bo; st[ 4] = X##bu; \
+		st[ 5] = X##ga; st[ 6] = X##ge; st[ 7] = X##gi; st[ 8] = X##go; st[ 9] = X##gu; \
+		st[10] = X##ka; st[11] = X##ke; st[12] = X##ki; st[13] = X##ko; st[14] = X##ku; \
+		st[15] = X##ma; st[16] = X##me; st[17] = X##mi; st[18] = X##mo; st[19] = X##mu; \
+		st[20] = X##sa; st[21] = X##se; st[22] = X##si; st[23] = X##so; st[24] = X##su; \
+	} while (0)
+
+#define KF_ROUND_PAIR(i, THETA, CHI)   do { \
+		KF_ROUND(A, E, RC[i], THETA, CHI); \
+		KF_ROUND(E, A, RC[(i) + 1], THETA, CHI); \
+	} while (0)
+
+/* name##_24: all rounds, fully unrolled */
+#define DEFINE_KECCAKF_24(ATTR, name, THETA, CHI) \
+	ATTR static void name##_24(KF_T *st) \
+	{ \
+		KF_DECL(A); \
+		KF_DECL(E); \
+		KF_LOAD(A, st); \
+		KF_ROUND_PAIR( 0, THETA, CHI); \
+		KF_ROUND_PAIR( 2, THETA, CHI); \
+		KF_ROUND_PAIR( 4, THETA, CHI); \
+		KF_ROUND_PAIR( 6, THETA, CHI); \
+		KF_ROUND_PAIR( 8, THETA, CHI); \
+		KF_ROUND_PAIR(10, THETA, CHI); \
+		KF_ROUND_PAIR(12, THETA, CHI); \
+		KF_ROUND_PAIR(14, THETA, CHI); \
+		KF_ROUND_PAIR(16, THETA, CHI); \
+		KF_ROUND_PAIR(18, THETA, CHI); \
+		KF_ROUND_PAIR(20, THETA, CHI); \
+		KF_ROUND_PAIR(22, THETA, CHI); \
+		KF_STORE(A, st); \
+	}
+
+/* name##_n: a prefix of the rounds, as wild keccak runs them one at a time */
+#define DEFINE_KECCAKF_N(ATTR, name, THETA, CHI) \
+	ATTR static void name##_n(KF_T *st, int rounds) \
+	{ \
+		int i; \
+		KF_DECL(A); \
+		KF_DECL(E); \
+		KF_LOAD(A, st); \
+		for (i = 0; i + 1 < rounds; i += 2) \
+			KF_ROUND_PAIR(i, THETA, CHI); \
+		if (i < rounds) { \
+			KF_ROUND(A, E, RC[i], THETA, CHI); \
+			KF_STORE(E, st); \
+		} else { \
+			KF_STORE(A, st); \
+		} \
+	}
+
+DEFINE_KECCAKF_24(, keccakf_lc, THETA_XOR, CHI_LC)
+DEFINE_KECCAKF_N(, keccakf_lc, THETA_XOR, CHI_LC)
+DEFINE_KECCAKF_N(, keccakf_mul, THETA_MUL, CHI_PLAIN)
+
+#ifdef KECCAKF_X86_DISPATCH
+#define ATTR_BMI2   __attribute__((target("bmi,bmi2")))
+DEFINE_KECCAKF_24(ATTR_BMI2, keccakf_bmi2, THETA_XOR, CHI_PLAIN)
+DEFINE_KECCAKF_N(ATTR_BMI2, keccakf_bmi2, THETA_XOR, CHI_PLAIN)
+DEFINE_KECCAKF_N(ATTR_BMI2, keccakf_mul_bmi2, THETA_MUL, CHI_PLAIN)
+
+static int use_bmi2(void)
+{
+	return cpu_has(CPU_FEATURE_BMI1 | CPU_FEATURE_BMI2);
+}
+#endif
+
+static void complement_lanes(uint64_t *st)
+{
+	st[ 1] = ~st[ 1];
+	st[ 2] = ~st[ 2];
+	st[ 8] = ~st[ 8];
+	st[12] = ~st[12];
+	st[17] = ~st[17];
+	st[20] = ~st[20];
+}
+
+void keccakf1600(uint64_t st[25])
+{
+#ifdef KECCAKF_X86_DISPATCH
+	if (use_bmi2()) {
+		keccakf_bmi2_24(st);
+		return;
+	}
+#endif
+	complement_lanes(st);
+	keccakf_lc_24(st);
+	complement_lanes(st);
+}
+
+void keccakf1600_lc(uint64_t st[25])
+{
+#ifdef KECCAKF_X86_DISPATCH
+	if (use_bmi2()) {
+		complement_lanes(st);
+		keccakf_bmi2_24(st);
+		complement_lanes(st);
+		return;
+	}
+#endif
+	keccakf_lc_24(st);
+}
+
+void keccakf1600_rounds(uint64_t st[25], int rounds)
+{
+	if (rounds == 24) {
+		keccakf1600(st);
+		return;
+	}
+#ifdef KECCAKF_X86_DISPATCH
+	if (use_bmi2()) {
+		keccakf_bmi2_n(st, rounds);
+		return;
+	}
+#endif
+	complement_lanes(st);
+	keccakf_lc_n(st, rounds);
+	complement_lanes(st);
+}
+
+void keccakf1600_mul_rounds(uint64_t st[25], int rounds)
+{
+#ifdef KECCAKF_X86_DISPATCH
+	if (use_bmi2()) {
+		keccakf_mul_bmi2_n(st, rounds);
+		return;
+	}
+#endif
+	keccakf_mul_n(st, rounds);
+}
+
+#ifdef KECCAKF_X86_DISPATCH
+
+/*
+ * AVX2: the same unrolled rounds over GCC vectors holding one lane of each of
+ * four states.  AVX2 has no 64-bit rotate, so ROL64 stays a shift pair.
+ */
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+
+#undef KF_T
+#define KF_T   v4u64
+#define ATTR_AVX2   __attribute__((target("avx2")))
+DEFINE_KECCAKF_24(ATTR_AVX2, keccakf_avx2_x4, THETA_XOR, CHI_PLAIN)
+
+#endif
+
+void keccakf1600_x4(uint64_t st[100])
+{
+	uint64_t one[25];
+	int i, j;
+
+#ifdef KECCAKF_X86_DISPATCH
+	if (cpu_has(CPU_FEATURE_AVX2)) {
+		keccakf_avx2_x4_24((v4u64 *) st);
+		return;
+	}
+#endif
+	for (j = 0; j < 4; j++) {
+		for (i = 0; i < 25; i++)
+			one[i] = st[4 * i + j];
+		keccakf1600(one);
+		for (i = 0; i < 25; i++)
+			st[4 * i + j] = one[i];
+	}
+}
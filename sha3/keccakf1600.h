@@ -0,0 +1,48 @@
+#ifndef KECCAKF1600_H
+#define KECCAKF1600_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Shared Keccak-f[1600] permutation.
+ *
+ * The state is 25 little-endian lanes, lane (x, y) at index x + 5 * y.  The
+ * rounds are fully unrolled; CPUs with BMI1/BMI2 run the plain form (ANDN and
+ * RORX), everything else runs the lane-complemented form, which needs one NOT
+ * per row instead of five.  The choice is made once at runtime.
+ */
+
+/* Full 24-round permutation of a plain state. */
+void keccakf1600(uint64_t st[25]);
+
+/*
+ * Same, on a state kept in lane-complemented form (lanes 1, 2, 8, 12, 17 and
+ * 20 inverted), as sph_keccak does between blocks.
+ */
+void keccakf1600_lc(uint64_t st[25]);
+
+/* The first `rounds` rounds only (round constants 0 .. rounds-1). */
+void keccakf1600_rounds(uint64_t st[25], int rounds);
+
+/*
+ * Boolberry's wild keccak variant, whose theta combines the lower three rows
+ * of each column with multiplications instead of XOR.
+ */
+void keccakf1600_mul_rounds(uint64_t st[25], int rounds);
+
+/*
+ * Four independent permutations at once, lane i of state j at st[4 * i + j];
+ * st must be 32-byte aligned.  Uses AVX2 when available, otherwise permutes
+ * the states one at a time.
+ */
+void keccakf1600_x4(uint64_t st[100]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
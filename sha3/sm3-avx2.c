@@ -0,0 +1,122 @@
+/*
+ * SM3 compression of eight independent blocks on AVX2, one message per
+ * 32 bit lane, selected at run time by sm3.c.  The rounds are those of the
+ * scalar sm3_compress() with every word widened to a vector.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+static const uint32_t TJ[64] = {
+	0x79CC4519, 0xF3988A32, 0xE7311465, 0xCE6228CB,
+	0x9CC45197, 0x3988A32F, 0x7311465E, 0xE6228CBC,
+	0xCC451979, 0x988A32F3, 0x311465E7, 0x6228CBCE,
+	0xC451979C, 0x88A32F39, 0x11465E73, 0x228CBCE6,
+	0x9D8A7A87, 0x3B14F50F, 0x7629EA1E, 0xEC53D43C,
+	0xD8A7A879, 0xB14F50F3, 0x629EA1E7, 0xC53D43CE,
+	0x8A7A879D, 0x14F50F3B, 0x29EA1E76, 0x53D43CEC,
+	0xA7A879D8, 0x4F50F3B1, 0x9EA1E762, 0x3D43CEC5,
+	0x7A879D8A, 0xF50F3B14, 0xEA1E7629, 0xD43CEC53,
+	0xA879D8A7, 0x50F3B14F, 0xA1E7629E, 0x43CEC53D,
+	0x879D8A7A, 0x0F3B14F5, 0x1E7629EA, 0x3CEC53D4,
+	0x79D8A7A8, 0xF3B14F50, 0xE7629EA1, 0xCEC53D43,
+	0x9D8A7A87, 0x3B14F50F, 0x7629EA1E, 0xEC53D43C,
+	0xD8A7A879, 0xB14F50F3, 0x629EA1E7, 0xC53D43CE,
+	0x8A7A879D, 0x14F50F3B, 0x29EA1E76, 0x53D43CEC,
+	0xA7A879D8, 0x4F50F3B1, 0x9EA1E762, 0x3D43CEC5,
+};
+
+#define XOR(a, b)       _mm256_xor_si256(a, b)
+#define ADD(a, b)       _mm256_add_epi32(a, b)
+#define ROTL(x, n)      _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define P0(x)           XOR(x, XOR(ROTL(x, 9), ROTL(x, 17)))
+#define P1(x)           XOR(x, XOR(ROTL(x, 15), ROTL(x, 23)))
+
+#define FF0(x, y, z)    XOR(x, XOR(y, z))
+#define FF1(x, y, z)    _mm256_or_si256(_mm256_and_si256(x, _mm256_or_si256(y, z)), _mm256_and_si256(y, z))
+#define GG0(x, y, z)    XOR(x, XOR(y, z))
+#define GG1(x, y, z)    XOR(z, _mm256_and_si256(x, XOR(y, z)))
+
+#define EXPAND(W, n) \
+	(W[(n) & 15] = XOR(XOR(P1(XOR(XOR(W[(n) & 15], W[((n) - 9) & 15]), ROTL(W[((n) - 3) & 15], 15))), \
+		ROTL(W[((n) - 13) & 15], 7)), W[((n) - 6) & 15]))
+
+#define ROUND(A, B, C, D, E, F, G, H, FF, GG, j, expand)   do { \
+	__m256i a12 = ROTL(A, 12); \
+	__m256i ss1 = ROTL(ADD(ADD(a12, E), _mm256_set1_epi32((int)TJ[j])), 7); \
+	__m256i w = W[(j) & 15]; \
+	if (expand) \
+		EXPAND(W, (j) + 4); \
+	D = ADD(ADD(D, FF(A, B, C)), ADD(XOR(ss1, a12), XOR(w, W[((j) + 4) & 15]))); \
+	H = ADD(ADD(H, GG(E, F, G)), ADD(ss1, w)); \
+	H = P0(H); \
+	B = ROTL(B, 9); \
+	F = ROTL(F, 19); \
+} while (0)
+
+#define ROUND4(FF, GG, j, expand)   do { \
+	ROUND(A, B, C, D, E, F, G, H, FF, GG, (j), expand); \
+	ROUND(D, A, B, C, H, E, F, G, FF, GG, (j) + 1, expand); \
+	ROUND(C, D, A, B, G, H, E, F, FF, GG, (j) + 2, expand); \
+	ROUND(B, C, D, A, F, G, H, E, FF, GG, (j) + 3, expand); \
+} while (0)
+
+static uint32_t be32(const unsigned char *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+void sm3_compress_x8_avx2(uint32_t digest[8][8], const unsigned char *const block[8])
+{
+	uint32_t lanes[8][8] __attribute__((aligned(32)));
+	__m256i W[16], V[8];
+	__m256i A, B, C, D, E, F, G, H;
+	int i, j;
+
+	for (j = 0; j < 16; j++) {
+		W[j] = _mm256_setr_epi32((int)be32(block[0] + 4 * j), (int)be32(block[1] + 4 * j),
+			(int)be32(block[2] + 4 * j), (int)be32(block[3] + 4 * j),
+			(int)be32(block[4] + 4 * j), (int)be32(block[5] + 4 * j),
+			(int)be32(block[6] + 4 * j), (int)be32(block[7] + 4 * j));
+	}
+	for (i = 0; i < 8; i++) {
+		V[i] = _mm256_setr_epi32((int)digest[0][i], (int)digest[1][i], (int)digest[2][i], (int)digest[3][i],
+			(int)digest[4][i], (int)digest[5][i], (int)digest[6][i], (int)digest[7][i]);
+	}
+	A = V[0]; B = V[1]; C = V[2]; D = V[3];
+	E = V[4]; F = V[5]; G = V[6]; H = V[7];
+
+	ROUND4(FF0, GG0, 0, 0);
+	ROUND4(FF0, GG0, 4, 0);
+	ROUND4(FF0, GG0, 8, 0);
+	ROUND4(FF0, GG0, 12, 1);
+	for (j = 16; j < 64; j += 4)
+		ROUND4(FF1, GG1, j, 1);
+
+	_mm256_store_si256((__m256i *)lanes[0], XOR(V[0], A));
+	_mm256_store_si256((__m256i *)lanes[1], XOR(V[1], B));
+	_mm256_store_si256((__m256i *)lanes[2], XOR(V[2], C));
+	_mm256_store_si256((__m256i *)lanes[3], XOR(V[3], D));
+	_mm256_store_si256((__m256i *)lanes[4], XOR(V[4], E));
+	_mm256_store_si256((__m256i *)lanes[5], XOR(V[5], F));
+	_mm256_store_si256((__m256i *)lanes[6], XOR(V[6], G));
+	_mm256_store_si256((__m256i *)lanes[7], XOR(V[7], H));
+	for (j = 0; j < 8; j++)
+		for (i = 0; i < 8; i++)
+			digest[j][i] = lanes[i][j];
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
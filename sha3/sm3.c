@@ -49,6 +49,13 @@
 
 #include <string.h>
 #include "sph_sm3.h"
+#include "../cpu_features.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 
 void sm3_init(sm3_ctx_t *ctx)
 {
@@ -143,12 +150,61 @@ void sm3_final(sm3_ctx_t *ctx, unsigned char *digest)
 #define GG1(x,y,z) (((x) & (y)) | ( (~(x)) & (z)) )
 
 
+/* T_j rotated left by j mod 32, as the rounds use it */
+static const uint32_t TJ[64] = {
+	0x79CC4519, 0xF3988A32, 0xE7311465, 0xCE6228CB,
+	0x9CC45197, 0x3988A32F, 0x7311465E, 0xE6228CBC,
+	0xCC451979, 0x988A32F3, 0x311465E7, 0x6228CBCE,
+	0xC451979C, 0x88A32F39, 0x11465E73, 0x228CBCE6,
+	0x9D8A7A87, 0x3B14F50F, 0x7629EA1E, 0xEC53D43C,
+	0xD8A7A879, 0xB14F50F3, 0x629EA1E7, 0xC53D43CE,
+	0x8A7A879D, 0x14F50F3B, 0x29EA1E76, 0x53D43CEC,
+	0xA7A879D8, 0x4F50F3B1, 0x9EA1E762, 0x3D43CEC5,
+	0x7A879D8A, 0xF50F3B14, 0xEA1E7629, 0xD43CEC53,
+	0xA879D8A7, 0x50F3B14F, 0xA1E7629E, 0x43CEC53D,
+	0x879D8A7A, 0x0F3B14F5, 0x1E7629EA, 0x3CEC53D4,
+	0x79D8A7A8, 0xF3B14F50, 0xE7629EA1, 0xCEC53D43,
+	0x9D8A7A87, 0x3B14F50F, 0x7629EA1E, 0xEC53D43C,
+	0xD8A7A879, 0xB14F50F3, 0x629EA1E7, 0xC53D43CE,
+	0x8A7A879D, 0x14F50F3B, 0x29EA1E76, 0x53D43CEC,
+	0xA7A879D8, 0x4F50F3B1, 0x9EA1E762, 0x3D43CEC5,
+};
+
+/*
+ * The message schedule is kept in a 16 word ring, W[j + 4] being expanded
+ * in round j, the way SHA-256 implementations do it, instead of the 68 + 64
+ * word arrays.
+ */
+#define EXPAND(W, n) \
+	(W[(n) & 15] = P1(W[(n) & 15] ^ W[((n) - 9) & 15] ^ ROTATELEFT(W[((n) - 3) & 15], 15)) \
+		^ ROTATELEFT(W[((n) - 13) & 15], 7) ^ W[((n) - 6) & 15])
+
+/*
+ * One round.  The registers rotate by renaming: the new A lands in D and
+ * the new E in H, the next round taking (D, A, B, C, H, E, F, G).
+ */
+#define ROUND(A, B, C, D, E, F, G, H, FF, GG, j, expand)   do { \
+	uint32_t a12 = ROTATELEFT(A, 12); \
+	uint32_t ss1 = ROTATELEFT(a12 + E + TJ[j], 7); \
+	uint32_t w = W[(j) & 15]; \
+	if (expand) \
+		EXPAND(W, (j) + 4); \
+	D += FF(A, B, C) + (ss1 ^ a12) + (w ^ W[((j) + 4) & 15]); \
+	H = P0(H + GG(E, F, G) + ss1 + w); \
+	B = ROTATELEFT(B, 9); \
+	F = ROTATELEFT(F, 19); \
+} while (0)
+
+#define ROUND4(FF, GG, j, expand)   do { \
+	ROUND(A, B, C, D, E, F, G, H, FF, GG, (j), expand); \
+	ROUND(D, A, B, C, H, E, F, G, FF, GG, (j) + 1, expand); \
+	ROUND(C, D, A, B, G, H, E, F, FF, GG, (j) + 2, expand); \
+	ROUND(B, C, D, A, F, G, H, E, FF, GG, (j) + 3, expand); \
+} while (0)
+
 void sm3_compress(uint32_t digest[8], const unsigned char block[64])
 {
-	int j;
-	uint32_t W[68], W1[64];
-	const uint32_t *pblock = (const uint32_t *)block;
-
+	uint32_t W[16];
 	uint32_t A = digest[0];
 	uint32_t B = digest[1];
 	uint32_t C = digest[2];
@@ -157,51 +213,19 @@ void sm3_compress(uint32_t digest[8], const unsigned char block[64])
 	uint32_t F = digest[5];
 	uint32_t G = digest[6];
 	uint32_t H = digest[7];
-	uint32_t SS1,SS2,TT1,TT2,T[64];
+	int j;
 
 	for (j = 0; j < 16; j++) {
-		W[j] = cpu_to_be32(pblock[j]);
-	}
-	for (j = 16; j < 68; j++) {
-		W[j] = P1( W[j-16] ^ W[j-9] ^ ROTATELEFT(W[j-3],15)) ^ ROTATELEFT(W[j - 13],7 ) ^ W[j-6];;
-	}
-	for( j = 0; j < 64; j++) {
-		W1[j] = W[j] ^ W[j+4];
+		W[j] = ((uint32_t)block[4 * j] << 24) | ((uint32_t)block[4 * j + 1] << 16)
+			| ((uint32_t)block[4 * j + 2] << 8) | (uint32_t)block[4 * j + 3];
 	}
 
-	for(j =0; j < 16; j++) {
-
-		T[j] = 0x79CC4519;
-		SS1 = ROTATELEFT((ROTATELEFT(A,12) + E + ROTATELEFT(T[j],j)), 7);
-		SS2 = SS1 ^ ROTATELEFT(A,12);
-		TT1 = FF0(A,B,C) + D + SS2 + W1[j];
-		TT2 = GG0(E,F,G) + H + SS1 + W[j];
-		D = C;
-		C = ROTATELEFT(B,9);
-		B = A;
-		A = TT1;
-		H = G;
-		G = ROTATELEFT(F,19);
-		F = E;
-		E = P0(TT2);
-	}
-
-	for(j =16; j < 64; j++) {
-
-		T[j] = 0x7A879D8A;
-		SS1 = ROTATELEFT((ROTATELEFT(A,12) + E + ROTATELEFT(T[j],j)), 7);
-		SS2 = SS1 ^ ROTATELEFT(A,12);
-		TT1 = FF1(A,B,C) + D + SS2 + W1[j];
-		TT2 = GG1(E,F,G) + H + SS1 + W[j];
-		D = C;
-		C = ROTATELEFT(B,9);
-		B = A;
-		A = TT1;
-		H = G;
-		G = ROTATELEFT(F,19);
-		F = E;
-		E = P0(TT2);
-	}
+	ROUND4(FF0, GG0, 0, 0);
+	ROUND4(FF0, GG0, 4, 0);
+	ROUND4(FF0, GG0, 8, 0);
+	ROUND4(FF0, GG0, 12, 1);
+	for (j = 16; j < 64; j += 4)
+		ROUND4(FF1, GG1, j, 1);
 
 	digest[0] ^= A;
 	digest[1] ^= B;
@@ -213,6 +237,49 @@ void sm3_compress(uint32_t digest[8], const unsigned char block[64])
 	digest[7] ^= H;
 }
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SM3_AVX2 1
+/* sm3-avx2.c */
+extern void sm3_compress_x8_avx2(uint32_t digest[8][8], const unsigned char *const block[8]);
+#endif
+
+static void sm3_compress_x8_scalar(uint32_t digest[8][8], const unsigned char *const block[8])
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		sm3_compress(digest[i], block[i]);
+}
+
+static void (*s_compress_x8)(uint32_t digest[8][8], const unsigned char *const block[8]) = sm3_compress_x8_scalar;
+
+static void select_backend(void)
+{
+#ifdef SM3_AVX2
+	if (cpu_has(CPU_FEATURE_AVX2))
+		s_compress_x8 = sm3_compress_x8_avx2;
+#endif
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID *ctx)
+{
+	select_backend();
+	return TRUE;
+}
+#define BACKEND_INIT_ONCE()	InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()	pthread_once(&s_backend_once, select_backend)
+#endif
+
+void sm3_compress_x8(uint32_t digest[8][8], const unsigned char *const block[8])
+{
+	BACKEND_INIT_ONCE();
+	s_compress_x8(digest, block);
+}
+
 void sm3(const unsigned char *msg, size_t msglen,
 	unsigned char dgst[SM3_DIGEST_LENGTH])
 {
@@ -63,6 +63,15 @@ extern "C"{
 #pragma warning (disable: 4146)
 #endif
 
+/*
+ * Groestl-256 and Groestl-512 hand their blocks to the SIMD backend picked
+ * at runtime, when there is one for this CPU.
+ */
+#if SPH_64
+#include "../algo/groestl/aes_ni/groestl-backend.h"
+#define SPH_GROESTL_NI   1
+#endif
+
 /*
  * The internal representation may use either big-endian or
  * little-endian. Using the platform default representation speeds up
@@ -3002,6 +3011,92 @@ groestl_big_close(sph_groestl_big_context *sc,
 	groestl_big_init(sc, (unsigned)out_len << 3);
 }
 
+#if SPH_GROESTL_NI
+
+/*
+ * Same buffering and padding as above, but with the chaining value in
+ * state.wide kept in the backend's layout and compressed by the backend.
+ */
+#define GROESTL_NI_ARGS(sc) \
+	(sc)->buf, sizeof (sc)->buf, &(sc)->ptr, (sc)->state.wide, &(sc)->count
+
+static void
+groestl_ni_init(const groestl_backend *gb, unsigned char *buf, size_t blen,
+	size_t *pptr, sph_u64 *h, sph_u64 *count)
+{
+	(void)buf;
+	*pptr = 0;
+	memcpy(h, gb->iv, blen);
+	*count = 0;
+}
+
+static void
+groestl_ni_core(const groestl_backend *gb, unsigned char *buf, size_t blen,
+	size_t *pptr, sph_u64 *h, sph_u64 *count, const void *data, size_t len)
+{
+	const unsigned char *in;
+	size_t ptr, blocks;
+
+	in = data;
+	ptr = *pptr;
+	if (ptr > 0) {
+		size_t clen;
+
+		clen = blen - ptr;
+		if (clen > len)
+			clen = len;
+		memcpy(buf + ptr, in, clen);
+		ptr += clen;
+		in += clen;
+		len -= clen;
+		if (ptr < blen) {
+			*pptr = ptr;
+			return;
+		}
+		gb->compress(h, buf, 1);
+		(*count) ++;
+	}
+	blocks = len / blen;
+	if (blocks > 0) {
+		gb->compress(h, in, blocks);
+		*count += blocks;
+		in += blocks * blen;
+		len -= blocks * blen;
+	}
+	memcpy(buf, in, len);
+	*pptr = len;
+}
+
+static void
+groestl_ni_close(const groestl_backend *gb, unsigned char *buf, size_t blen,
+	size_t *pptr, sph_u64 *h, sph_u64 *count,
+	unsigned ub, unsigned n, void *dst, size_t out_len)
+{
+	unsigned char pad[136];
+	size_t ptr, pad_len;
+	sph_u64 blocks;
+	unsigned z;
+
+	ptr = *pptr;
+	z = 0x80 >> n;
+	pad[0] = ((ub & -z) | z) & 0xFF;
+	if (ptr < blen - 8) {
+		pad_len = blen - ptr;
+		blocks = SPH_T64(*count + 1);
+	} else {
+		pad_len = (blen << 1) - ptr;
+		blocks = SPH_T64(*count + 2);
+	}
+	memset(pad + 1, 0, pad_len - 9);
+	sph_enc64be(pad + pad_len - 8, blocks);
+	groestl_ni_core(gb, buf, blen, pptr, h, count, pad, pad_len);
+	gb->output(h, pad);
+	memcpy(dst, pad + (blen >> 1) - out_len, out_len);
+	groestl_ni_init(gb, buf, blen, pptr, h, count);
+}
+
+#endif
+
 /* see sph_groestl.h */
 void
 sph_groestl224_init(void *cc)
@@ -3034,6 +3129,14 @@ sph_groestl224_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 void
 sph_groestl256_init(void *cc)
 {
+#if SPH_GROESTL_NI
+	const groestl_backend *gb = groestl256_backend();
+
+	if (gb != NULL) {
+		groestl_ni_init(gb, GROESTL_NI_ARGS((sph_groestl_small_context *)cc));
+		return;
+	}
+#endif
 	groestl_small_init(cc, 256);
 }
 
@@ -3041,6 +3144,14 @@ sph_groestl256_init(void *cc)
 void
 sph_groestl256(void *cc, const void *data, size_t len)
 {
+#if SPH_GROESTL_NI
+	const groestl_backend *gb = groestl256_backend();
+
+	if (gb != NULL) {
+		groestl_ni_core(gb, GROESTL_NI_ARGS((sph_groestl_small_context *)cc), data, len);
+		return;
+	}
+#endif
 	groestl_small_core(cc, data, len);
 }
 
@@ -3048,13 +3159,22 @@ sph_groestl256(void *cc, const void *data, size_t len)
 void
 sph_groestl256_close(void *cc, void *dst)
 {
-	groestl_small_close(cc, 0, 0, dst, 32);
+	sph_groestl256_addbits_and_close(cc, 0, 0, dst);
 }
 
 /* see sph_groestl.h */
 void
 sph_groestl256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
+#if SPH_GROESTL_NI
+	const groestl_backend *gb = groestl256_backend();
+
+	if (gb != NULL) {
+		groestl_ni_close(gb, GROESTL_NI_ARGS((sph_groestl_small_context *)cc),
+			ub, n, dst, 32);
+		return;
+	}
+#endif
 	groestl_small_close(cc, ub, n, dst, 32);
 }
 
@@ -3090,6 +3210,14 @@ sph_groestl384_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 void
 sph_groestl512_init(void *cc)
 {
+#if SPH_GROESTL_NI
+	const groestl_backend *gb = groestl512_backend();
+
+	if (gb != NULL) {
+		groestl_ni_init(gb, GROESTL_NI_ARGS((sph_groestl_big_context *)cc));
+		return;
+	}
+#endif
 	groestl_big_init(cc, 512);
 }
 
@@ -3097,6 +3225,14 @@ sph_groestl512_init(void *cc)
 void
 sph_groestl512(void *cc, const void *data, size_t len)
 {
+#if SPH_GROESTL_NI
+	const groestl_backend *gb = groestl512_backend();
+
+	if (gb != NULL) {
+		groestl_ni_core(gb, GROESTL_NI_ARGS((sph_groestl_big_context *)cc), data, len);
+		return;
+	}
+#endif
 	groestl_big_core(cc, data, len);
 }
 
@@ -3104,13 +3240,22 @@ sph_groestl512(void *cc, const void *data, size_t len)
 void
 sph_groestl512_close(void *cc, void *dst)
 {
-	groestl_big_close(cc, 0, 0, dst, 64);
+	sph_groestl512_addbits_and_close(cc, 0, 0, dst);
 }
 
 /* see sph_groestl.h */
 void
 sph_groestl512_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 {
+#if SPH_GROESTL_NI
+	const groestl_backend *gb = groestl512_backend();
+
+	if (gb != NULL) {
+		groestl_ni_close(gb, GROESTL_NI_ARGS((sph_groestl_big_context *)cc),
+			ub, n, dst, 64);
+		return;
+	}
+#endif
 	groestl_big_close(cc, ub, n, dst, 64);
 }
 
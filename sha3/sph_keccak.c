@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "sph_keccak.h"
+#include "keccakf1600.h"
 
 #ifdef __cplusplus
 extern "C"{
@@ -133,20 +134,11 @@ extern "C"{
 
 #if SPH_KECCAK_64
 
-static const sph_u64 RC[] = {
-	SPH_C64(0x0000000000000001), SPH_C64(0x0000000000008082),
-	SPH_C64(0x800000000000808A), SPH_C64(0x8000000080008000),
-	SPH_C64(0x000000000000808B), SPH_C64(0x0000000080000001),
-	SPH_C64(0x8000000080008081), SPH_C64(0x8000000000008009),
-	SPH_C64(0x000000000000008A), SPH_C64(0x0000000000000088),
-	SPH_C64(0x0000000080008009), SPH_C64(0x000000008000000A),
-	SPH_C64(0x000000008000808B), SPH_C64(0x800000000000008B),
-	SPH_C64(0x8000000000008089), SPH_C64(0x8000000000008003),
-	SPH_C64(0x8000000000008002), SPH_C64(0x8000000000000080),
-	SPH_C64(0x000000000000800A), SPH_C64(0x800000008000000A),
-	SPH_C64(0x8000000080008081), SPH_C64(0x8000000000008080),
-	SPH_C64(0x0000000080000001), SPH_C64(0x8000000080008008)
-};
+/*
+ * The 64-bit permutation is the shared one from keccakf1600.c, which keeps
+ * the same lane-complemented state layout as this file; the permutation
+ * macros below only build the 32-bit one.
+ */
 
 #if SPH_KECCAK_NOCOPY
 
@@ -355,15 +347,6 @@ static const sph_u64 RC[] = {
 
 #endif
 
-#define DECL64(x)        sph_u64 x
-#define MOV64(d, s)      (d = s)
-#define XOR64(d, a, b)   (d = a ^ b)
-#define AND64(d, a, b)   (d = a & b)
-#define OR64(d, a, b)    (d = a | b)
-#define NOT64(d, s)      (d = SPH_T64(~s))
-#define ROL64(d, v, n)   (d = SPH_ROTL64(v, n))
-#define XOR64_IOTA       XOR64
-
 #else
 
 static const struct {
@@ -953,8 +936,6 @@ static const struct {
 #define XOR64_IOTA(d, s, k) \
 	(d ## l = s ## l ^ k.low, d ## h = s ## h ^ k.high)
 
-#endif
-
 #define TH_ELT(t, c0, c1, c2, c3, c4, d0, d1, d2, d3, d4)   do { \
 		DECL64(tt0); \
 		DECL64(tt1); \
@@ -1522,6 +1503,9 @@ static const struct {
 
 #endif
 
+#endif
+
+
 static void
 keccak_init(sph_keccak_context *kc, unsigned out_size)
 {
@@ -1594,7 +1578,13 @@ keccak_core(sph_keccak_context *kc, const void *data, size_t len, size_t lim)
 		len -= clen;
 		if (ptr == lim) {
 			INPUT_BUF(lim);
+#if SPH_KECCAK_64
+			WRITE_STATE(kc);
+			keccakf1600_lc(kc->u.wide);
+			READ_STATE(kc);
+#else
 			KECCAK_F_1600;
+#endif
 			ptr = 0;
 		}
 	}
@@ -746,6 +746,66 @@ sph_shabal256_addbits_and_close(void *cc, unsigned ub, unsigned n, void *dst)
 	shabal_close(cc, ub, n, dst, 8);
 }
 
+/*
+ * The Shabal-256 initial state, in the shape READ_STATE expects.
+ */
+static const struct {
+	const sph_u32 *A, *B, *C;
+	sph_u32 Wlow, Whigh;
+} shabal256_iv = { A_init_256, B_init_256, C_init_256, 1, 0 };
+
+/* see sph_shabal.h */
+void
+sph_shabal256_full(const void *data, size_t len, void *dst)
+{
+	const unsigned char *src;
+	const unsigned char *buf;
+	union {
+		unsigned char tmp[64];
+		sph_u32 dummy;
+	} u;
+	unsigned char *out;
+	int i;
+	DECL_STATE
+
+	src = data;
+	buf = u.tmp;
+	READ_STATE(&shabal256_iv);
+	while (len >= sizeof u.tmp) {
+		memcpy(u.tmp, src, sizeof u.tmp);
+		DECODE_BLOCK;
+		INPUT_BLOCK_ADD;
+		XOR_W;
+		APPLY_P;
+		INPUT_BLOCK_SUB;
+		SWAP_BC;
+		INCR_W;
+		src += sizeof u.tmp;
+		len -= sizeof u.tmp;
+	}
+	memcpy(u.tmp, src, len);
+	u.tmp[len] = 0x80;
+	memset(u.tmp + len + 1, 0, (sizeof u.tmp) - (len + 1));
+	DECODE_BLOCK;
+	INPUT_BLOCK_ADD;
+	XOR_W;
+	APPLY_P;
+	for (i = 0; i < 3; i ++) {
+		SWAP_BC;
+		XOR_W;
+		APPLY_P;
+	}
+	out = dst;
+	sph_enc32le(out +  0, B8);
+	sph_enc32le(out +  4, B9);
+	sph_enc32le(out +  8, BA);
+	sph_enc32le(out + 12, BB);
+	sph_enc32le(out + 16, BC);
+	sph_enc32le(out + 20, BD);
+	sph_enc32le(out + 24, BE);
+	sph_enc32le(out + 28, BF);
+}
+
 /* see sph_shabal.h */
 void
 sph_shabal384_init(void *cc)
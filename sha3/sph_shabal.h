@@ -247,6 +247,18 @@ void sph_shabal256_close(void *cc, void *dst);
 void sph_shabal256_addbits_and_close(
 	void *cc, unsigned ub, unsigned n, void *dst);
 
+/**
+ * Compute Shabal-256 over a whole message at once, without a context.
+ * This is the same as init, update and close, but the state stays in
+ * local variables throughout, which pays off for the many short messages
+ * of chained constructions.
+ *
+ * @param data   the input data
+ * @param len    the input data length (in bytes)
+ * @param dst    the destination buffer (32 bytes)
+ */
+void sph_shabal256_full(const void *data, size_t len, void *dst);
+
 /**
  * Initialize a Shabal-384 context. This process performs no memory allocation.
  *
@@ -76,6 +76,11 @@ void sm3_init(sm3_ctx_t *ctx);
 void sm3_update(sm3_ctx_t *ctx, const unsigned char* data, size_t data_len);
 void sm3_final(sm3_ctx_t *ctx, unsigned char digest[SM3_DIGEST_LENGTH]);
 void sm3_compress(uint32_t digest[8], const unsigned char block[SM3_BLOCK_SIZE]);
+/*
+ * Compresses block[i] into digest[i] for eight independent messages, in the
+ * eight lanes of AVX2 where the CPU has it.
+ */
+void sm3_compress_x8(uint32_t digest[8][8], const unsigned char *const block[8]);
 void sm3(const unsigned char *data, size_t datalen,
 	unsigned char digest[SM3_DIGEST_LENGTH]);
 
@@ -0,0 +1,155 @@
+#include "veltor.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "compat.h"
+#include "cpu_features.h"
+#include "chain.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VELTOR_AVX2 1
+/* chain-avx2.c */
+extern void chain_skein512_80_x4_avx2(const uint64_t* mid, const unsigned char* const input[4],
+    uint32_t* const hash[4]);
+#endif
+
+#define VELTOR_LANES    4
+
+/* The stages after Skein-512, as in algo/veltor.c */
+static const chain_stage* const veltor_stages[] = {
+    &chain_shavite512, &chain_shabal512, &chain_gost512
+};
+
+#define VELTOR_STAGES   (sizeof veltor_stages / sizeof veltor_stages[0])
+
+/* Backend selection */
+
+static int s_avx2;
+
+static void select_backend(void)
+{
+#ifdef VELTOR_AVX2
+    s_avx2 = cpu_has(CPU_FEATURE_AVX2);
+#endif
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_backend_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    select_backend();
+    return TRUE;
+}
+#define BACKEND_INIT_ONCE()     InitOnceExecuteOnce(&s_backend_once, select_backend_once, NULL, NULL)
+#else
+static pthread_once_t s_backend_once = PTHREAD_ONCE_INIT;
+#define BACKEND_INIT_ONCE()     pthread_once(&s_backend_once, select_backend)
+#endif
+
+/* A 64 byte input is its own final block, so the midstate only applies past it */
+static int has_prefix(const veltor_midstate* mid, const char* input, uint32_t len)
+{
+    return mid && len > 64 && memcmp(mid->prefix, input, 64) == 0;
+}
+
+void veltor_midstate_init(veltor_midstate* mid, const char* input)
+{
+    chain_skein512_midstate(input, mid->state);
+    memcpy(mid->prefix, input, 64);
+}
+
+/* Skein-512 of the input, from the midstate when it starts with its prefix */
+static void veltor_skein(const veltor_midstate* mid, const char* input, uint32_t len, uint32_t* hash)
+{
+    if (has_prefix(mid, input, len))
+        chain_skein512_resume(mid->state, input + 64, len - 64, hash);
+    else
+        chain_skein512_input(input, len, hash);
+}
+
+void veltor_hash(const veltor_midstate* mid, const char* input, char* output, uint32_t len)
+{
+    chain_hash _ALIGN(64) hash;
+    uint32_t i;
+
+    veltor_skein(mid, input, len, hash);
+    for (i = 0; i < VELTOR_STAGES; i++)
+        veltor_stages[i]->one(hash);
+    memcpy(output, hash, 32);
+}
+
+#ifdef VELTOR_AVX2
+
+/*
+ * 80 byte headers four at a time, those that match mid from the midstate
+ * and the others from the IV; what does not fill a group goes one by one.
+ */
+static void veltor_skein_avx2(const veltor_midstate* mid, const char* const* inputs, const uint32_t* input_lens,
+    uint32_t count, chain_hash* hashes)
+{
+    const unsigned char* in[VELTOR_LANES];
+    uint32_t* out[VELTOR_LANES];
+    uint32_t lane[VELTOR_LANES];
+    int pass, n, l;
+    uint32_t i;
+
+    for (pass = mid ? 0 : 1; pass < 2; pass++) {
+        n = 0;
+        for (i = 0; i < count; i++) {
+            if (input_lens[i] != VELTOR_HEADER_SIZE || has_prefix(mid, inputs[i], input_lens[i]) != (pass == 0))
+                continue;
+            in[n] = (const unsigned char*) inputs[i];
+            out[n] = hashes[i];
+            lane[n] = i;
+            if (++n == VELTOR_LANES) {
+                chain_skein512_80_x4_avx2(pass == 0 ? mid->state : NULL, in, out);
+                n = 0;
+            }
+        }
+        for (l = 0; l < n; l++)
+            veltor_skein(mid, inputs[lane[l]], VELTOR_HEADER_SIZE, out[l]);
+    }
+
+    for (i = 0; i < count; i++)
+        if (input_lens[i] != VELTOR_HEADER_SIZE)
+            veltor_skein(mid, inputs[i], input_lens[i], hashes[i]);
+}
+
+#endif
+
+static void veltor_skein_batch(const veltor_midstate* mid, const char* const* inputs, const uint32_t* input_lens,
+    uint32_t count, chain_hash* hashes)
+{
+    uint32_t i;
+
+#ifdef VELTOR_AVX2
+    if (s_avx2) {
+        veltor_skein_avx2(mid, inputs, input_lens, count, hashes);
+        return;
+    }
+#endif
+    for (i = 0; i < count; i++)
+        veltor_skein(mid, inputs[i], input_lens[i], hashes[i]);
+}
+
+void veltor_hash_batch(const veltor_midstate* mid, const char* const* inputs, const uint32_t* input_lens,
+    uint32_t count, char* const* outputs)
+{
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    uint32_t i, n;
+
+    BACKEND_INIT_ONCE();
+    for (; count; count -= n, inputs += n, input_lens += n, outputs += n) {
+        n = count < CHAIN_BATCH_MAX ? count : CHAIN_BATCH_MAX;
+        veltor_skein_batch(mid, inputs, input_lens, n, hashes);
+        for (i = 0; i < VELTOR_STAGES; i++)
+            chain_run(veltor_stages[i], hashes, n);
+        for (i = 0; i < n; i++)
+            memcpy(outputs[i], hashes[i], 32);
+    }
+}
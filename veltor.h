@@ -0,0 +1,38 @@
+#ifndef VELTOR_H
+#define VELTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define VELTOR_HEADER_SIZE 80
+
+/*
+ * The Skein-512 chaining value after the first 64 bytes of a job's header.
+ * As with sha256_midstate, inputs that do not start with the prefix are
+ * hashed in full.
+ */
+typedef struct {
+    uint64_t state[8];
+    unsigned char prefix[64];
+} veltor_midstate;
+
+void veltor_midstate_init(veltor_midstate* mid, const char* input);
+
+/* Skein-512, SHAvite-512, Shabal-512 then Streebog-512 (Veltor); mid may be NULL. */
+void veltor_hash(const veltor_midstate* mid, const char* input, char* output, uint32_t len);
+
+/*
+ * Batches run the Skein of 80 byte headers four at a time on AVX2, then each
+ * later stage over the whole batch, Shabal eight at a time.
+ */
+void veltor_hash_batch(const veltor_midstate* mid, const char* const* inputs, const uint32_t* input_lens,
+    uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+#include "x11evo.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "chain.h"
+
+/* The first order took effect at this ntime (2016-05-01) */
+#define X11EVO_EPOCH        1462060800
+#define X11EVO_DAY          (60 * 60 * 24)
+
+/* (10 - i)! for the digits of the factorial number system */
+static const uint32_t x11evo_radix[CHAIN_X11_STAGES] = {
+    3628800, 362880, 40320, 5040, 720, 120, 24, 6, 2, 1, 1
+};
+
+/*
+ * The order of day n is the n-th permutation of the X11 stages in
+ * lexicographic order, which algo/x11/x11evo.c reaches by calling nextPerm()
+ * n times and caches in process globals.  Unranking it digit by digit takes
+ * eleven steps whatever the day and shares nothing between threads.
+ *
+ * ntime is 32 bits, so n stays below 10! and every order starts with BLAKE;
+ * headers dated before the epoch take the first order.
+ */
+static void x11evo_order(const char* header, uint8_t order[CHAIN_X11_STAGES])
+{
+    const uint8_t* p = (const uint8_t*) header + 68;
+    uint32_t ntime = p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+    int32_t day = (int32_t) (ntime - X11EVO_EPOCH) / X11EVO_DAY;
+    uint32_t rank = day > 0 ? (uint32_t) day : 0;
+    uint8_t left[CHAIN_X11_STAGES];
+    uint32_t digit;
+    int i;
+
+    for (i = 0; i < CHAIN_X11_STAGES; i++)
+        left[i] = (uint8_t) i;
+    for (i = 0; i < CHAIN_X11_STAGES; i++) {
+        digit = rank / x11evo_radix[i];
+        rank %= x11evo_radix[i];
+        order[i] = left[digit];
+        memmove(left + digit, left + digit + 1, CHAIN_X11_STAGES - 1 - i - digit);
+    }
+}
+
+void x11evo_hash(const char* input, char* output)
+{
+    uint8_t order[CHAIN_X11_STAGES];
+    chain_hash _ALIGN(64) hash;
+    int i;
+
+    x11evo_order(input, order);
+    chain_blake512_input(input, X11EVO_HEADER_SIZE, hash);
+    for (i = 1; i < CHAIN_X11_STAGES; i++)
+        chain_x11_stages[order[i]]->one(hash);
+    memcpy(output, hash, 32);
+}
+
+void x11evo_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint8_t order[CHAIN_BATCH_MAX][CHAIN_X11_STAGES], ways[CHAIN_BATCH_MAX];
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    uint32_t i, n;
+    int step;
+
+    for (; count; count -= n, inputs += n, outputs += n) {
+        n = count < CHAIN_BATCH_MAX ? count : CHAIN_BATCH_MAX;
+        for (i = 0; i < n; i++) {
+            x11evo_order(inputs[i], order[i]);
+            chain_blake512_input(inputs[i], X11EVO_HEADER_SIZE, hashes[i]);
+        }
+        for (step = 1; step < CHAIN_X11_STAGES; step++) {
+            for (i = 0; i < n; i++)
+                ways[i] = order[i][step];
+            chain_switch(chain_x11_stages, CHAIN_X11_STAGES, ways, hashes, n);
+        }
+        for (i = 0; i < n; i++)
+            memcpy(outputs[i], hashes[i], 32);
+    }
+}
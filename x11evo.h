@@ -0,0 +1,25 @@
+#ifndef X11EVO_H
+#define X11EVO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define X11EVO_HEADER_SIZE  80
+
+/*
+ * X11evo (Revolvercoin) over an 80 byte block header: the x11 stages in an
+ * order that changes once a day, picked by the header's ntime.
+ */
+void x11evo_hash(const char* input, char* output);
+
+/* Same as x11evo_hash() for count headers, which run step by step, grouped by the algorithm of each step. */
+void x11evo_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,20 @@
+#include "x11gost.h"
+#include <stdint.h>
+
+#include "chain.h"
+
+/* The stages after BLAKE-512, as in algo/x11/x11gost.c */
+static const chain_stage* const x11gost_stages[] = {
+    &chain_bmw512, &chain_groestl512, &chain_skein512, &chain_jh512, &chain_keccak512,
+    &chain_gost512, &chain_luffa512, &chain_cubehash512, &chain_shavite512, &chain_simd512,
+    &chain_echo512
+};
+
+static const chain_seq x11gost_seq = {
+    chain_blake512_input, x11gost_stages, sizeof x11gost_stages / sizeof x11gost_stages[0]
+};
+
+void x11gost_hash(const char* input, char* output, uint32_t len)
+{
+    chain_seq_hash(&x11gost_seq, input, output, len);
+}
@@ -1,98 +1,31 @@
 #include "x13sm3.h"
-#include <stdlib.h>
 #include <stdint.h>
-#include <string.h>
-#include <stdio.h>
 
-#include "sha3/sph_blake.h"
-#include "sha3/sph_bmw.h"
-#include "sha3/sph_groestl.h"
-#include "sha3/sph_jh.h"
-#include "sha3/sph_keccak.h"
-#include "sha3/sph_skein.h"
-#include "sha3/sph_luffa.h"
-#include "sha3/sph_cubehash.h"
-#include "sha3/sph_shavite.h"
-#include "sha3/sph_simd.h"
-#include "sha3/sph_echo.h"
-#include "sha3/sph_hamsi.h"
-#include "sha3/sph_fugue.h"
-#include "sha3/sph_sm3.h"
+#include "chain.h"
 
-
-void x13sm3_hash(const char* input, char* output, uint32_t len)
+/* BLAKE-512 always reads the 80 byte header, whatever len says. */
+static void x13sm3_first(const char* input, uint32_t len, uint32_t* hash)
 {
-	unsigned char hash[128];
-
-	memset(hash, 0, 128);
-
-	sph_blake512_context     ctx_blake;
-	sph_bmw512_context       ctx_bmw;
-	sph_groestl512_context   ctx_groestl;
-	sph_jh512_context        ctx_jh;
-	sph_keccak512_context    ctx_keccak;
-	sph_skein512_context     ctx_skein;
-	sm3_ctx_t				ctx_sm3;
-	sph_cubehash512_context  ctx_cubehash;
-	sph_shavite512_context   ctx_shavite;
-	sph_simd512_context      ctx_simd;
-	sph_echo512_context      ctx_echo;
-	sph_hamsi512_context     ctx_hamsi;
-	sph_fugue512_context     ctx_fugue;
-
-	sph_blake512_init(&ctx_blake);
-	sph_blake512(&ctx_blake, input, 80);
-	sph_blake512_close(&ctx_blake, hash);
-
-	sph_bmw512_init(&ctx_bmw);
-	sph_bmw512(&ctx_bmw, hash, 64);
-	sph_bmw512_close(&ctx_bmw, hash + 64);
-
-	sph_groestl512_init(&ctx_groestl);
-	sph_groestl512(&ctx_groestl, hash + 64, 64);
-	sph_groestl512_close(&ctx_groestl, hash);
-
-	sph_skein512_init(&ctx_skein);
-	sph_skein512(&ctx_skein, hash, 64);
-	sph_skein512_close(&ctx_skein, hash + 64);
-
-	sph_jh512_init(&ctx_jh);
-	sph_jh512(&ctx_jh, hash + 64, 64);
-	sph_jh512_close(&ctx_jh, hash);
-
-	sph_keccak512_init(&ctx_keccak);
-	sph_keccak512(&ctx_keccak, hash, 64);
-	sph_keccak512_close(&ctx_keccak, hash + 64);
-
-	memset(hash, 0, 64);	//sm3 is 256bit hash
-	sm3_init(&ctx_sm3);
-	sph_sm3(&ctx_sm3, hash + 64, 64);
-	sph_sm3_close(&ctx_sm3, hash);
-
-	sph_cubehash512_init(&ctx_cubehash);
-	sph_cubehash512(&ctx_cubehash, hash, 64);
-	sph_cubehash512_close(&ctx_cubehash, hash + 64);
-
-	sph_shavite512_init(&ctx_shavite);
-	sph_shavite512(&ctx_shavite, hash + 64, 64);
-	sph_shavite512_close(&ctx_shavite, hash);
-
-	sph_simd512_init(&ctx_simd);
-	sph_simd512(&ctx_simd, hash, 64);
-	sph_simd512_close(&ctx_simd, hash + 64);
-
-	sph_echo512_init(&ctx_echo);
-	sph_echo512(&ctx_echo, hash + 64, 64);
-	sph_echo512_close(&ctx_echo, hash);
+    chain_blake512_input(input, 80, hash);
+}
 
-	sph_hamsi512_init(&ctx_hamsi);
-	sph_hamsi512(&ctx_hamsi, hash, 64);
-	sph_hamsi512_close(&ctx_hamsi, hash + 64);
+/* X13 with SM3 after Keccak; SM3's 32 bytes go on zero padded to 64 */
+static const chain_stage* const x13sm3_stages[] = {
+    &chain_bmw512, &chain_groestl512, &chain_skein512, &chain_jh512, &chain_keccak512,
+    &chain_sm3, &chain_cubehash512, &chain_shavite512, &chain_simd512, &chain_echo512,
+    &chain_hamsi512, &chain_fugue512
+};
 
-	sph_fugue512_init(&ctx_fugue);
-	sph_fugue512(&ctx_fugue, hash + 64, 64);
-	sph_fugue512_close(&ctx_fugue, hash);
+static const chain_seq x13sm3_seq = {
+    x13sm3_first, x13sm3_stages, sizeof x13sm3_stages / sizeof x13sm3_stages[0]
+};
 
-	memcpy(output, hash, 32);
+void x13sm3_hash(const char* input, char* output, uint32_t len)
+{
+    chain_seq_hash(&x13sm3_seq, input, output, len);
+}
 
+void x13sm3_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    chain_seq_hash_batch(&x13sm3_seq, inputs, input_lens, count, outputs);
 }
@@ -2,4 +2,10 @@
 
 #include <stdint.h>
 
+/* The block header the first stage reads, whatever the input length */
+#define X13SM3_HEADER_SIZE 80
+
 void x13sm3_hash(const char* input, char* output, uint32_t len);
+
+/* Same as x13sm3_hash() for count inputs, run through the chain stage by stage. */
+void x13sm3_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
@@ -0,0 +1,25 @@
+#include "x14.h"
+#include <stdint.h>
+
+#include "chain.h"
+
+/* The stages after BLAKE-512, as in algo/x14/x14.c */
+static const chain_stage* const x14_stages[] = {
+    &chain_bmw512, &chain_groestl512, &chain_skein512, &chain_jh512, &chain_keccak512,
+    &chain_luffa512, &chain_cubehash512, &chain_shavite512, &chain_simd512, &chain_echo512,
+    &chain_hamsi512, &chain_fugue512, &chain_shabal512
+};
+
+static const chain_seq x14_seq = {
+    chain_blake512_input, x14_stages, sizeof x14_stages / sizeof x14_stages[0]
+};
+
+void x14_hash(const char* input, char* output, uint32_t len)
+{
+    chain_seq_hash(&x14_seq, input, output, len);
+}
+
+void x14_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    chain_seq_hash_batch(&x14_seq, inputs, input_lens, count, outputs);
+}
@@ -0,0 +1,26 @@
+#include "x17.h"
+#include <stdint.h>
+
+#include "chain.h"
+
+/* The stages after BLAKE-512, as in algo/x17/x17.c; HAVAL's 32 bytes are the digest */
+static const chain_stage* const x17_stages[] = {
+    &chain_bmw512, &chain_groestl512, &chain_skein512, &chain_jh512, &chain_keccak512,
+    &chain_luffa512, &chain_cubehash512, &chain_shavite512, &chain_simd512, &chain_echo512,
+    &chain_hamsi512, &chain_fugue512, &chain_shabal512, &chain_whirlpool, &chain_sha512,
+    &chain_haval256_5
+};
+
+static const chain_seq x17_seq = {
+    chain_blake512_input, x17_stages, sizeof x17_stages / sizeof x17_stages[0]
+};
+
+void x17_hash(const char* input, char* output, uint32_t len)
+{
+    chain_seq_hash(&x17_seq, input, output, len);
+}
+
+void x17_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    chain_seq_hash_batch(&x17_seq, inputs, input_lens, count, outputs);
+}
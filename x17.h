@@ -0,0 +1,19 @@
+#ifndef X17_H
+#define X17_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+void x17_hash(const char* input, char* output, uint32_t len);
+
+/* Same as x17_hash() for count inputs, run through the chain stage by stage. */
+void x17_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+#include "xevan.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/sha.h>
+
+#include "compat.h"
+#include "cpu_features.h"
+#include "sha3/sph_blake.h"
+#include "sha3/sph_bmw.h"
+#include "sha3/sph_groestl.h"
+#include "sha3/sph_jh.h"
+#include "sha3/sph_keccak.h"
+#include "sha3/sph_skein.h"
+#include "sha3/sph_shavite.h"
+#include "sha3/sph_echo.h"
+#include "sha3/sph_hamsi.h"
+#include "sha3/sph_fugue.h"
+#include "sha3/sph_shabal.h"
+#include "sha3/sph_whirlpool.h"
+#include "algo/haval/sph-haval.h"
+#include "algo/luffa/sse2/luffa_for_sse2.h"
+#include "algo/cubehash/sse2/cubehash_sse2.h"
+#include "algo/simd/sse2/nist.h"
+#include "algo/echo/aes_ni/echo-aes.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/* Every stage hashes the 128 byte, zero padded output of the one before. */
+#define XEVAN_DATA_LEN  128
+
+/*
+ * Initial state of every stage, set up once: CubeHash alone runs 160
+ * rounds in its init.  Groestl picks its AES-NI backend by itself, ECHO
+ * is chosen here.
+ */
+typedef struct {
+    sph_blake512_context     blake;
+    sph_bmw512_context       bmw;
+    sph_groestl512_context   groestl;
+    sph_skein512_context     skein;
+    sph_jh512_context        jh;
+    sph_keccak512_context    keccak;
+    hashState_luffa          luffa;
+    cubehashParam            cubehash;
+    sph_shavite512_context   shavite;
+    hashState_sd             simd;
+    sph_echo512_context      echo;
+#ifdef ECHO_AES
+    hashState_echo           echo_aes;
+#endif
+    sph_hamsi512_context     hamsi;
+    sph_fugue512_context     fugue;
+    sph_shabal512_context    shabal;
+    sph_whirlpool_context    whirlpool;
+    SHA512_CTX               sha512;
+    sph_haval256_5_context   haval;
+} xevan_ctx_holder;
+
+static xevan_ctx_holder _ALIGN(64) s_ctx_init;
+static int s_echo_aes;
+
+static void init_ctx(void)
+{
+    sph_blake512_init(&s_ctx_init.blake);
+    sph_bmw512_init(&s_ctx_init.bmw);
+    sph_groestl512_init(&s_ctx_init.groestl);
+    sph_skein512_init(&s_ctx_init.skein);
+    sph_jh512_init(&s_ctx_init.jh);
+    sph_keccak512_init(&s_ctx_init.keccak);
+    init_luffa(&s_ctx_init.luffa, 512);
+    cubehashInit(&s_ctx_init.cubehash, 512, 16, 32);
+    sph_shavite512_init(&s_ctx_init.shavite);
+    init_sd(&s_ctx_init.simd, 512);
+    sph_echo512_init(&s_ctx_init.echo);
+#ifdef ECHO_AES
+    s_echo_aes = cpu_has(CPU_FEATURE_AES | CPU_FEATURE_SSSE3);
+    if (s_echo_aes)
+        echo_aes_init(&s_ctx_init.echo_aes, 512);
+#endif
+    sph_hamsi512_init(&s_ctx_init.hamsi);
+    sph_fugue512_init(&s_ctx_init.fugue);
+    sph_shabal512_init(&s_ctx_init.shabal);
+    sph_whirlpool_init(&s_ctx_init.whirlpool);
+    SHA512_Init(&s_ctx_init.sha512);
+    sph_haval256_5_init(&s_ctx_init.haval);
+}
+
+#ifdef _WIN32
+static INIT_ONCE s_ctx_once = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK init_ctx_once(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    init_ctx();
+    return TRUE;
+}
+#define CTX_INIT_ONCE()     InitOnceExecuteOnce(&s_ctx_once, init_ctx_once, NULL, NULL)
+#else
+static pthread_once_t s_ctx_once = PTHREAD_ONCE_INIT;
+#define CTX_INIT_ONCE()     pthread_once(&s_ctx_once, init_ctx)
+#endif
+
+/* Stages 2 to 17 of one pass, in place on hash. */
+static void xevan_pass(xevan_ctx_holder* ctx, uint32_t* hash)
+{
+    sph_bmw512(&ctx->bmw, hash, XEVAN_DATA_LEN);
+    sph_bmw512_close(&ctx->bmw, hash);
+
+    sph_groestl512(&ctx->groestl, hash, XEVAN_DATA_LEN);
+    sph_groestl512_close(&ctx->groestl, hash);
+
+    sph_skein512(&ctx->skein, hash, XEVAN_DATA_LEN);
+    sph_skein512_close(&ctx->skein, hash);
+
+    sph_jh512(&ctx->jh, hash, XEVAN_DATA_LEN);
+    sph_jh512_close(&ctx->jh, hash);
+
+    sph_keccak512(&ctx->keccak, hash, XEVAN_DATA_LEN);
+    sph_keccak512_close(&ctx->keccak, hash);
+
+    update_and_final_luffa(&ctx->luffa, (BitSequence*) hash, (const BitSequence*) hash, XEVAN_DATA_LEN);
+
+    cubehashUpdateDigest(&ctx->cubehash, (byte*) hash, (const byte*) hash, XEVAN_DATA_LEN);
+
+    sph_shavite512(&ctx->shavite, hash, XEVAN_DATA_LEN);
+    sph_shavite512_close(&ctx->shavite, hash);
+
+    update_final_sd(&ctx->simd, (BitSequence*) hash, (const BitSequence*) hash, XEVAN_DATA_LEN * 8);
+
+#ifdef ECHO_AES
+    if (s_echo_aes)
+        echo_aes_update_final(&ctx->echo_aes, (BitSequence*) hash, (const BitSequence*) hash, XEVAN_DATA_LEN * 8);
+    else
+#endif
+    {
+        sph_echo512(&ctx->echo, hash, XEVAN_DATA_LEN);
+        sph_echo512_close(&ctx->echo, hash);
+    }
+
+    sph_hamsi512(&ctx->hamsi, hash, XEVAN_DATA_LEN);
+    sph_hamsi512_close(&ctx->hamsi, hash);
+
+    sph_fugue512(&ctx->fugue, hash, XEVAN_DATA_LEN);
+    sph_fugue512_close(&ctx->fugue, hash);
+
+    sph_shabal512(&ctx->shabal, hash, XEVAN_DATA_LEN);
+    sph_shabal512_close(&ctx->shabal, hash);
+
+    sph_whirlpool(&ctx->whirlpool, hash, XEVAN_DATA_LEN);
+    sph_whirlpool_close(&ctx->whirlpool, hash);
+
+    SHA512_Update(&ctx->sha512, hash, XEVAN_DATA_LEN);
+    SHA512_Final((unsigned char*) hash, &ctx->sha512);
+
+    sph_haval256_5(&ctx->haval, hash, XEVAN_DATA_LEN);
+    sph_haval256_5_close(&ctx->haval, hash);
+}
+
+void xevan_hash(const char* input, char* output, uint32_t len)
+{
+    xevan_ctx_holder _ALIGN(64) ctx;
+    uint32_t _ALIGN(64) hash[XEVAN_DATA_LEN / 4];
+
+    CTX_INIT_ONCE();
+
+    memcpy(&ctx, &s_ctx_init, sizeof ctx);
+    sph_blake512(&ctx.blake, input, len);
+    sph_blake512_close(&ctx.blake, hash);
+    memset(&hash[16], 0, XEVAN_DATA_LEN - 64);
+    xevan_pass(&ctx, hash);
+    memset(&hash[8], 0, XEVAN_DATA_LEN - 32);
+
+    memcpy(&ctx, &s_ctx_init, sizeof ctx);
+    sph_blake512(&ctx.blake, hash, XEVAN_DATA_LEN);
+    sph_blake512_close(&ctx.blake, hash);
+    xevan_pass(&ctx, hash);
+
+    memcpy(output, hash, 32);
+}
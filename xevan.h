@@ -0,0 +1,17 @@
+#ifndef XEVAN_H
+#define XEVAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* The x17 chain run twice, each stage over a 128 byte zero padded hash. */
+void xevan_hash(const char* input, char* output, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
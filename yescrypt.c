@@ -0,0 +1,80 @@
+#include "yescrypt.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "compat.h"
+#include "scratch_pool.h"
+#include "algo/yescrypt/yescrypt.h"
+
+#define YESCRYPT_N      2048
+#define YESCRYPT_R      8
+#define YESCRYPT_P      1
+#define YESCRYPT_FLAGS  (YESCRYPT_RW | YESCRYPT_PWXFORM)
+
+/* B, V and XY at r = 8, p = 1, then the pwxform S-boxes */
+#define YESCRYPT_SCRATCH_SIZE   (128 * YESCRYPT_R * YESCRYPT_P + 128 * YESCRYPT_R * YESCRYPT_N + \
+                                 256 * YESCRYPT_R + 8192)
+
+/* GlobalBoost-Y keys the ClientKey HMAC with the salt instead of "Client Key". */
+bool client_key_hack = true;
+
+/*
+ * The local region is lent a pool buffer for the length of a hash, so no
+ * hash reallocates a few MB and no thread keeps one after it is done.  The
+ * shared region is the empty dummy, there is no ROM.
+ */
+static scratch_pool s_scratch = SCRATCH_POOL_INIT(YESCRYPT_SCRATCH_SIZE, 32);
+static const yescrypt_shared_t s_shared = { { NULL, NULL, 0, 0 }, 1 };
+
+static int hash_one(yescrypt_local_t* local, const char* input, char* output, uint32_t len)
+{
+    return yescrypt_kdf(&s_shared, local, (const uint8_t*) input, len, (const uint8_t*) input, len,
+                        YESCRYPT_N, YESCRYPT_R, YESCRYPT_P, 0, YESCRYPT_FLAGS, (uint8_t*) output, 32);
+}
+
+static void* local_begin(yescrypt_local_t* local)
+{
+    void* buf = scratch_pool_acquire(&s_scratch);
+
+    yescrypt_init_local(local);
+    local->aligned = buf;
+    local->aligned_size = buf ? YESCRYPT_SCRATCH_SIZE : 0;
+    return buf;
+}
+
+/* yescrypt_kdf() only allocates a region of its own if the buffer was too small */
+static void local_end(yescrypt_local_t* local, void* buf)
+{
+    if (local->aligned != buf)
+        yescrypt_free_local(local);
+    scratch_pool_release(&s_scratch, buf);
+}
+
+int yescrypt_hash(const char* input, char* output, uint32_t len)
+{
+    yescrypt_local_t local;
+    void* buf = local_begin(&local);
+    int ret;
+
+    if (!buf)
+        return -1;
+    ret = hash_one(&local, input, output, len) ? -1 : 0;
+    local_end(&local, buf);
+    return ret;
+}
+
+int yescrypt_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    yescrypt_local_t local;
+    void* buf = local_begin(&local);
+    uint32_t i;
+    int ret = 0;
+
+    if (!buf)
+        return -1;
+    for (i = 0; i < count && !ret; i++)
+        ret = hash_one(&local, inputs[i], outputs[i], input_lens[i]) ? -1 : 0;
+    local_end(&local, buf);
+    return ret;
+}
@@ -0,0 +1,24 @@
+#ifndef YESCRYPT_HASH_H
+#define YESCRYPT_HASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * yescrypt with N = 2048, r = 8, p = 1 (GlobalBoost-Y flavour).  The
+ * memory for V and the S-boxes is taken from a scratch pool shared by every
+ * thread.  Both return 0, or -1 when a pool block could not be allocated.
+ */
+int yescrypt_hash(const char* input, char* output, uint32_t len);
+
+/* Hashes count inputs back to back on one block from the scratch pool. */
+int yescrypt_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
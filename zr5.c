@@ -0,0 +1,114 @@
+#include "zr5.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "sha3/sph_keccak.h"
+#include "compat.h"
+#include "chain.h"
+
+#define POK_BOOL_MASK   0x00008000
+#define POK_DATA_MASK   0xFFFF0000
+
+#define ZR5_ORDERS      24
+
+/* The jump table the orders index: 0 BLAKE, 1 Groestl, 2 JH, 3 Skein */
+static const chain_stage* const zr5_stages[4] = {
+    &chain_blake512, &chain_groestl512, &chain_jh512, &chain_skein512
+};
+
+/* Every permutation of the four, in lexicographic order */
+static const uint8_t zr5_orders[ZR5_ORDERS][4] = {
+    { 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 1, 3 }, { 0, 2, 3, 1 },
+    { 0, 3, 1, 2 }, { 0, 3, 2, 1 }, { 1, 0, 2, 3 }, { 1, 0, 3, 2 },
+    { 1, 2, 0, 3 }, { 1, 2, 3, 0 }, { 1, 3, 0, 2 }, { 1, 3, 2, 0 },
+    { 2, 0, 1, 3 }, { 2, 0, 3, 1 }, { 2, 1, 0, 3 }, { 2, 1, 3, 0 },
+    { 2, 3, 0, 1 }, { 2, 3, 1, 0 }, { 3, 0, 1, 2 }, { 3, 0, 2, 1 },
+    { 3, 1, 0, 2 }, { 3, 1, 2, 0 }, { 3, 2, 0, 1 }, { 3, 2, 1, 0 }
+};
+
+static void zr5_keccak(const uint32_t* header, uint32_t* hash)
+{
+    sph_keccak512_context ctx;
+
+    sph_keccak512_init(&ctx);
+    sph_keccak512(&ctx, header, ZR5_HEADER_SIZE);
+    sph_keccak512_close(&ctx, hash);
+}
+
+static void zr5_one(const uint32_t* header, uint32_t* hash)
+{
+    const uint8_t* order;
+    int i;
+
+    zr5_keccak(header, hash);
+    order = zr5_orders[hash[0] % ZR5_ORDERS];
+    for (i = 0; i < 4; i++)
+        zr5_stages[order[i]]->one(hash);
+}
+
+void zr5_hash(const char* input, char* output)
+{
+    uint32_t header[20];
+    chain_hash _ALIGN(64) hash;
+
+    memcpy(header, input, ZR5_HEADER_SIZE);
+    if (header[0] & POK_BOOL_MASK) {
+        header[0] &= ~POK_DATA_MASK;
+        zr5_one(header, hash);
+        header[0] |= hash[0] & POK_DATA_MASK;
+        if (!(hash[0] & POK_DATA_MASK)) {
+            memcpy(output, hash, 32);
+            return;
+        }
+    }
+    zr5_one(header, hash);
+    memcpy(output, hash, 32);
+}
+
+static void zr5_chunk(const uint32_t (*headers)[20], chain_hash* hashes, uint32_t count)
+{
+    uint8_t order[CHAIN_BATCH_MAX], ways[CHAIN_BATCH_MAX];
+    uint32_t i;
+    int step;
+
+    for (i = 0; i < count; i++) {
+        zr5_keccak(headers[i], hashes[i]);
+        order[i] = (uint8_t) (hashes[i][0] % ZR5_ORDERS);
+    }
+    for (step = 0; step < 4; step++) {
+        for (i = 0; i < count; i++)
+            ways[i] = zr5_orders[order[i]][step];
+        chain_switch(zr5_stages, 4, ways, hashes, count);
+    }
+}
+
+void zr5_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs)
+{
+    uint32_t headers[CHAIN_BATCH_MAX][20];
+    chain_hash _ALIGN(64) hashes[CHAIN_BATCH_MAX];
+    uint32_t again[CHAIN_BATCH_MAX];
+    uint32_t i, n, m;
+
+    for (; count; count -= n, inputs += n, outputs += n) {
+        n = count < CHAIN_BATCH_MAX ? count : CHAIN_BATCH_MAX;
+        for (i = 0; i < n; i++) {
+            memcpy(headers[i], inputs[i], ZR5_HEADER_SIZE);
+            if (headers[i][0] & POK_BOOL_MASK)
+                headers[i][0] &= ~POK_DATA_MASK;
+        }
+        zr5_chunk((const uint32_t (*)[20]) headers, hashes, n);
+
+        /* The headers whose PoK data changes go round again, moved to the front */
+        for (i = 0, m = 0; i < n; i++) {
+            memcpy(outputs[i], hashes[i], 32);
+            if ((headers[i][0] & POK_BOOL_MASK) && (hashes[i][0] & POK_DATA_MASK)) {
+                memmove(headers[m], headers[i], ZR5_HEADER_SIZE);
+                headers[m][0] |= hashes[i][0] & POK_DATA_MASK;
+                again[m++] = i;
+            }
+        }
+        zr5_chunk((const uint32_t (*)[20]) headers, hashes, m);
+        for (i = 0; i < m; i++)
+            memcpy(outputs[again[i]], hashes[i], 32);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef ZR5_H
+#define ZR5_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define ZR5_HEADER_SIZE     80
+
+/*
+ * ZR5 (Ziftrcoin) over an 80 byte block header: Keccak-512, then BLAKE,
+ * Groestl, JH and Skein-512 in one of 24 orders picked by the Keccak hash.
+ * A header whose version has the proof-of-knowledge bit set is hashed with
+ * its PoK data, the upper half of the version, taken from a first pass.
+ */
+void zr5_hash(const char* input, char* output);
+
+/* Same as zr5_hash() for count headers, which run step by step, grouped by the algorithm of each step. */
+void zr5_hash_batch(const char* const* inputs, const uint32_t* input_lens, uint32_t count, char* const* outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif